@@ -38,3 +38,8 @@ endif()
 if(NOT ${MCRL2_ENABLE_DEBUG_SOUNDNESS_CHECKS})
   add_definitions(-DMCRL2_NO_SOUNDNESS_CHECKS)
 endif()
+
+# Add the definition to make the term library thread safe.
+if(MCRL2_ENABLE_MULTITHREADING)
+  add_definitions(-DMCRL2_ENABLE_MULTITHREADING)
+endif()
@@ -22,6 +22,17 @@ typedef void(*term_callback)(const aterm&);
 extern void add_creation_hook(const function_symbol&, term_callback);
 extern void add_deletion_hook(const function_symbol&, term_callback);
 
+namespace detail
+{
+
+/// \brief Calls lock_shared() of the global term pool, see aterm_pool::lock_shared().
+extern void lock_shared_term_pool();
+
+/// \brief Calls unlock_shared() of the global term pool, see aterm_pool::unlock_shared().
+extern void unlock_shared_term_pool();
+
+} // namespace detail
+
 /// \brief An unprotected term does not change the reference count of the
 ///        shared term when it is copied or moved.
 class unprotected_aterm
@@ -59,8 +70,7 @@ public:
   /// \details This function has constant complexity.
   bool type_is_int() const noexcept
   {
-    const function_symbol& f=m_term->function();
-    return f == detail::g_as_int;
+    return detail::is_small_integer(m_term) || m_term->function() == detail::g_as_int;
   }
 
   /// \brief Dynamic check whether the term is an aterm_list.
@@ -68,6 +78,10 @@ public:
   /// \details This function has constant complexity.
   bool type_is_list() const noexcept
   {
+    if (detail::is_small_integer(m_term))
+    {
+      return false;
+    }
     const function_symbol& f=m_term->function();
     return f == detail::g_as_list || f == detail::g_as_empty_list;
   }
@@ -157,6 +171,10 @@ public:
   /// \details This is for internal use only.
   const function_symbol& function() const
   {
+    if (detail::is_small_integer(m_term))
+    {
+      return detail::g_as_int;
+    }
     return m_term->function();
   }
 };
@@ -181,9 +199,9 @@ public:
   /// \todo Should be protected, but this cannot yet be done due to a problem
   ///       in the compiling rewriter.
   explicit aterm(detail::_aterm *t) noexcept
+   : unprotected_aterm(t)
   {
-    t->increment_reference_count();
-    m_term = t;
+    increment_reference_count();
   }
 
   /// \brief Copy constructor.
@@ -232,24 +250,35 @@ public:
 
 protected:
   /// \brief Increment the reference count.
-  /// \details This increments the reference count unless the term contains null.
-  ///          Use with care as this destroys the reference count mechanism.
+  /// \details This increments the reference count unless the term contains null or
+  ///          a small integer, which is not shared. Use with care as this destroys the
+  ///          reference count mechanism.
   void increment_reference_count() const
   {
-    if (defined())
+    if (defined() && !detail::is_small_integer(m_term))
     {
       m_term->increment_reference_count();
     }
   }
 
   /// \brief Decrement the reference count.
-  /// \details This decrements the reference count unless the term contains null.
-  ///          Use with care as this destroys the reference count mechanism.
+  /// \details This decrements the reference count unless the term contains null or
+  ///          a small integer. Use with care as this destroys the reference count mechanism.
   void decrement_reference_count() const
   {
-    if (defined())
+    if (defined() && !detail::is_small_integer(m_term))
     {
-      m_term->decrement_reference_count();
+      if (detail::GlobalThreadSafe)
+      {
+        // A term that becomes unprotected during garbage collection might not be marked.
+        detail::lock_shared_term_pool();
+        m_term->decrement_reference_count();
+        detail::unlock_shared_term_pool();
+      }
+      else
+      {
+        m_term->decrement_reference_count();
+      }
     }
   }
 };
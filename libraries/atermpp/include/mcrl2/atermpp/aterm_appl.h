@@ -178,14 +178,14 @@ public:
   /// \return The function symbol of this term.
   const function_symbol& function() const
   {
-    return m_term->function();
+    return aterm::function();
   }
 
   /// \brief Returns the number of arguments of this term.
   /// \return The number of arguments of this term.
   size_type size() const
   {
-    return m_term->function().arity();
+    return function().arity();
   }
 
   /// \brief Returns true if the term has no arguments.
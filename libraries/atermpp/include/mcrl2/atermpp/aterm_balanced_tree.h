@@ -198,7 +198,7 @@ class term_balanced_tree : public aterm_appl
     /// \return True iff the tree is empty.
     bool empty() const
     {
-      return m_term->function() == tree_empty_function();
+      return function() == tree_empty_function();
     }
 
     /// \brief Returns true iff the tree is a node with a left and right subtree.
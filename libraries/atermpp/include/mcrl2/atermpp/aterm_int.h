@@ -22,7 +22,8 @@ namespace atermpp
 /// \brief An integer term stores a single std::size_t value. It carries
 /// 	       no arguments.
 /// \details A special function symbol is used to identify integer terms
-/// 			 internally.
+/// 			 internally. Values up to detail::max_small_integer are encoded
+/// 			 in the term address itself and are not stored in the term pool.
 class aterm_int : public aterm
 {
 public:
@@ -32,7 +33,9 @@ public:
 
   /// \brief Constructs an integer term from a value.
   explicit aterm_int(std::size_t value)
-   : aterm(detail::g_term_pool().create_int(value))
+   : aterm(value <= detail::max_small_integer
+           ? aterm(detail::make_small_integer(value))
+           : detail::g_term_pool().create_int(value))
   {}
 
   /// This class has user-declared copy constructor so declare default copy and move operators.
@@ -45,6 +48,10 @@ public:
   /// \returns The value of the integer term.
   std::size_t value() const noexcept
   {
+    if (detail::is_small_integer(m_term))
+    {
+      return detail::small_integer_value(m_term);
+    }
     return reinterpret_cast<detail::_aterm_int*>(m_term)->value();
   }
 
@@ -42,6 +42,15 @@ public:
   ///        written itself is not shared whenever it occurs as the argument of another term.
   const aterm_output& operator<<(const aterm& term) override;
 
+  /// \brief Writes a natural number directly to the stream, without constructing a term.
+  /// \details This can be used to efficiently write a large amount of data in between terms. The
+  ///          reader is responsible for reading exactly these numbers with binary_aterm_input::read_integer
+  ///          after reading the preceding term.
+  void write_integer(std::size_t value)
+  {
+    m_stream.write_integer(value);
+  }
+
 private:
   /// \brief Write a function symbol to the output stream.
   std::size_t write_function_symbol(const function_symbol& symbol);
@@ -71,6 +80,13 @@ public:
   binary_aterm_input(std::istream& is, std::function<aterm_transformer> transformer = identity);
 
   aterm get() override;
+
+  /// \brief Reads a natural number that was written with binary_aterm_output::write_integer.
+  std::size_t read_integer()
+  {
+    return m_stream.read_integer();
+  }
+
 private:
   /// \returns The number of bits needed to index terms.
   unsigned int term_index_width();
@@ -17,6 +17,7 @@
 #include "mcrl2/utilities/shared_reference.h"
 #include "mcrl2/atermpp/type_traits.h"
 
+#include <cstdint>
 #include <limits>
 
 namespace atermpp
@@ -26,6 +27,7 @@ namespace atermpp
 class unprotected_aterm;
 
 constexpr static std::size_t MarkedReferenceCount = std::numeric_limits<std::size_t>::max();
+constexpr static std::size_t GarbageReferenceCount = MarkedReferenceCount - 1;
 
 namespace detail
 {
@@ -83,8 +85,33 @@ public:
     return m_reference_count == MarkedReferenceCount;
   }
 
+  /// \brief Indicate that this term was found to be garbage, but that it is destroyed later on.
+  /// \details Changes the reference count, so only apply whenever !is_reachable().
+  void mark_garbage()
+  {
+    assert(!is_reachable());
+    m_reference_count = GarbageReferenceCount;
+    increment_reference_count_changes();
+  }
+
+  /// \brief Make a term that was marked as garbage an ordinary unprotected term again.
+  /// \details Applied when the term is created again before it was destroyed.
+  void revive()
+  {
+    assert(is_garbage());
+    m_reference_count = 0;
+    increment_reference_count_changes();
+  }
+
+  /// \returns True whenever this term is garbage that has not been destroyed yet.
+  bool is_garbage() const noexcept
+  {
+    return m_reference_count == GarbageReferenceCount;
+  }
+
   /// \brief A term is reachable in the garbage collection graph if it is protected or whenever it occurs
   ///        as an argument of a reachable term. The latter will be ensured in the marking phase of garbage collection.
+  ///        Garbage terms that are not yet destroyed also count as reachable, but these do not exist while marking.
   /// \returns True whenever the term is reachable ie either marked or protected.
   bool is_reachable() const noexcept
   {
@@ -97,6 +124,35 @@ private:
 
 inline _aterm* address(const unprotected_aterm& t);
 
+static_assert(alignof(_aterm) > 1, "The least significant bit of a term address must be available to tag small integers.");
+
+/// \brief The least significant bit of a term address is set iff the address does not refer to
+///        an _aterm, but encodes a small integer in its remaining bits.
+constexpr std::uintptr_t small_integer_tag = 1;
+
+/// \brief The largest integer that can be encoded in a term address.
+constexpr std::size_t max_small_integer = std::numeric_limits<std::uintptr_t>::max() >> 1;
+
+/// \returns True iff the given address encodes a small integer instead of pointing to a shared term.
+inline bool is_small_integer(const _aterm* term) noexcept
+{
+  return (reinterpret_cast<std::uintptr_t>(term) & small_integer_tag) != 0;
+}
+
+/// \returns An address that encodes the given value, which should be at most max_small_integer.
+inline _aterm* make_small_integer(std::size_t value) noexcept
+{
+  assert(value <= max_small_integer);
+  return reinterpret_cast<_aterm*>((static_cast<std::uintptr_t>(value) << 1) | small_integer_tag);
+}
+
+/// \returns The value encoded in an address for which is_small_integer holds.
+inline std::size_t small_integer_value(const _aterm* term) noexcept
+{
+  assert(is_small_integer(term));
+  return static_cast<std::size_t>(reinterpret_cast<std::uintptr_t>(term) >> 1);
+}
+
 } // namespace detail
 } // namespace atermpp
 
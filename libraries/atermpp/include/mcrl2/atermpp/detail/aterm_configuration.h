@@ -10,13 +10,20 @@
 #ifndef MCRL2_ATERMPP_ATERM_CONFIGURATION_H
 #define MCRL2_ATERMPP_ATERM_CONFIGURATION_H
 
+#include <cstddef>
+
 namespace atermpp
 {
 namespace detail
 {
 
 /// \brief Enables thread safety for the global term and function symbol pools.
+/// \details Can be enabled by configuring with MCRL2_ENABLE_MULTITHREADING.
+#ifdef MCRL2_ENABLE_MULTITHREADING
+constexpr static bool GlobalThreadSafe = true;
+#else
 constexpr static bool GlobalThreadSafe = false;
+#endif
 
 /// \brief Enable to print garbage collection statistics.
 constexpr static bool EnableGarbageCollectionMetrics = false;
@@ -27,8 +34,18 @@ constexpr static bool EnableTermHashtableMetrics = false;
 /// \brief Enable to obtain the percentage of terms found compared to allocated.
 constexpr static bool EnableTermCreationMetrics = false;
 
+/// \brief Enable to destroy the garbage found by a garbage collection incrementally while new terms
+///        are created, instead of during the garbage collection itself.
+/// \details Is not used when GlobalThreadSafe is true.
+constexpr static bool EnableIncrementalSweep = true;
+
+/// \brief The maximum number of garbage terms that are destroyed each time a term is created.
+constexpr static std::size_t IncrementalSweepSize = 8;
+
 /// \brief Enable garbage collection.
-constexpr static bool EnableGarbageCollection = true && !GlobalThreadSafe;
+/// \details When GlobalThreadSafe is true the garbage collection stops the world, i.e.,
+///          it waits until no other thread is busy creating terms.
+constexpr static bool EnableGarbageCollection = true;
 
 } // namespace detail
 } // namespace atermpp
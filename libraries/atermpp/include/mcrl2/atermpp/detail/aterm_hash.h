@@ -35,6 +35,12 @@ struct hash<atermpp::detail::_aterm*>
 
   std::size_t operator()(const atermpp::detail::_aterm* term) const
   {
+    // Small integers are encoded in the address itself, so their lowest bits do carry information.
+    if (atermpp::detail::is_small_integer(term))
+    {
+      return atermpp::detail::small_integer_value(term);
+    }
+
     // All terms are 8 bytes aligned which means that the three lowest significant
     // bits of their pointers are always 0. However, their smallest size is 16 bytes so
     // the lowest 4 bits do not carry much information.
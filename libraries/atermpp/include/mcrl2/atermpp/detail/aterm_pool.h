@@ -15,7 +15,11 @@
 #include "mcrl2/atermpp/detail/aterm_pool_storage.h"
 #include "mcrl2/atermpp/detail/function_symbol_pool.h"
 
+#include <atomic>
+#include <mutex>
 #include <tuple>
+#include <type_traits>
+#include <vector>
 
 namespace atermpp
 {
@@ -39,6 +43,12 @@ using function_application_storage = aterm_pool_storage<_aterm_appl<N>, aterm_ha
 /// \details Internally uses different storage objects to store specific
 ///          classes of terms. For a given term creation it can decide what
 ///          storage to use at run-time using its function symbol.
+///
+///          When GlobalThreadSafe is true multiple threads can create terms concurrently.
+///          Every thread that creates terms, uses terms that are not protected or removes
+///          a protection holds the pool in shared mode (see lock_shared). Garbage collection
+///          stops the world, i.e., it waits until no thread holds the pool in shared mode.
+///          Holding the pool in shared mode only writes a flag that is local to the thread.
 class aterm_pool : public mcrl2::utilities::noncopyable
 {
 public:
@@ -63,12 +73,35 @@ public:
   /// \brief Triggers garbage collection when certain conditions are met.
   inline void trigger_collection();
 
+  /// \brief Performs a garbage collection that was deferred by lock_shared(), if the current
+  ///        thread does not hold the pool in shared mode.
+  /// \details Only called where terms are created, such that a collection never takes place
+  ///          when a term is merely released, e.g. in the destructor of an arbitrary object.
+  inline void collect_deferred_garbage();
+
   /// \brief Triggers garbage collection on all storages.
   inline void collect();
 
+  /// \brief Destroys the garbage that remains from the last garbage collection, see EnableIncrementalSweep.
+  inline void sweep();
+
   /// \brief Enable garbage collection when passing true and disable otherwise.
   inline void enable_garbage_collection(bool enable);
 
+  /// \brief Prevents garbage collection until the matching unlock_shared() has been called.
+  /// \details Can be called recursively by the same thread. Garbage collections that are
+  ///          triggered in the meantime are deferred until the next term is created after
+  ///          the outermost unlock_shared(), see collect_deferred_garbage().
+  inline void lock_shared();
+
+  /// \brief Releases the pool acquired by lock_shared(). This never performs garbage collection.
+  inline void unlock_shared();
+
+  /// \brief Creates a function symbol with the given name and arity.
+  /// \details See function_symbol_pool::create, which should not be used directly when
+  ///          GlobalThreadSafe is true.
+  inline function_symbol create_function_symbol(const std::string& name, const std::size_t arity, const bool check_for_registered_functions = false);
+
   /// \brief Creates a integral term with the given value.
   inline aterm create_int(std::size_t val);
 
@@ -117,6 +150,42 @@ public:
   /// \returns The pool of function symbols.
   function_symbol_pool& get_symbol_pool() { return m_function_symbol_pool; }
 private:
+  template<typename T>
+  using thread_safe_type = typename std::conditional<GlobalThreadSafe, std::atomic<T>, T>::type;
+
+  /// \brief The state of a thread that uses this pool.
+  struct thread_state
+  {
+    /// True iff this thread holds the pool in shared mode.
+    std::atomic<bool> busy{false};
+
+    /// The number of nested lock_shared() calls of this thread.
+    std::size_t depth = 0;
+  };
+
+  /// \brief A thread state that is registered to the pool for its lifetime.
+  class registered_thread_state;
+
+  /// \returns The state of the current thread.
+  inline thread_state& local_state() noexcept;
+
+  /// \brief Waits until no thread holds the pool in shared mode and prevents that any thread
+  ///        acquires it in shared mode until unlock_exclusive() is called.
+  inline void lock_exclusive();
+
+  /// \brief Allows threads to hold the pool in shared mode again.
+  inline void unlock_exclusive();
+
+  /// \brief Performs a garbage collection. When incremental is true the unreachable terms are destroyed
+  ///        by sweep_incrementally() afterwards, instead of during the garbage collection itself.
+  inline void collect_impl(bool incremental);
+
+  /// \brief Destroys at most IncrementalSweepSize garbage terms of the last garbage collection.
+  inline void sweep_incrementally();
+
+  /// \brief Destroys at most limit garbage terms, in the same order as a complete sweep would.
+  /// \returns The number of terms that have been destroyed.
+  inline std::size_t sweep_garbage(std::size_t limit);
 
   /// Storage for the function symbols.
   function_symbol_pool m_function_symbol_pool;
@@ -139,23 +208,66 @@ private:
   /// Storage for term_appl with a dynamic number of arguments larger than 7.
   arbitrary_function_application_storage m_appl_dynamic_storage;
 
-  /// Track the number of  terms destroyed and reduce the freelist.
-  std::size_t m_countUntilCollection;
+  /// The number of garbage terms of the last garbage collection that have not been destroyed yet.
+  std::size_t m_garbage_size = 0;
+
+  /// Statistics of the garbage collections, which are printed after each collection when
+  /// EnableGarbageCollectionMetrics holds or the "gc" log hint is enabled at the debug level.
+  bool m_print_statistics = false;
+  std::size_t m_number_of_collections = 0;
+  std::size_t m_number_of_destroyed_terms = 0;
+  double m_total_pause_time = 0.0;
+  double m_maximum_pause_time = 0.0;
+  double m_sweep_time = 0.0;
+
+  /// Track the number of terms created until the next garbage collection is triggered.
+  /// Becomes negative once a collection has been requested, but not yet performed.
+  thread_safe_type<std::ptrdiff_t> m_countUntilCollection;
 
   /// It can happen that during create_appl with converter the converter generates new terms.
   /// As such these terms might only be protected after the term_appl was actually created.
-  std::size_t m_creation_depth = 0;
+  /// Only used when GlobalThreadSafe is false, otherwise the state is thread local.
+  thread_state m_local_state;
 
-  /// Defer garbage collection until the creation depth is equal to zero again.
-  bool m_deferred_garbage_collection = false;
+  /// Defer garbage collection until a term is created outside of lock_shared().
+  thread_safe_type<bool> m_deferred_garbage_collection;
 
   /// Enable automatically triggered garbage collection.
-  bool m_enable_garbage_collection = true;
+  thread_safe_type<bool> m_enable_garbage_collection;
+
+  /// Indicates that garbage collection takes place, threads cannot acquire the pool in shared mode.
+  std::atomic<bool> m_forbidden{false};
+
+  /// Held during garbage collection, threads wait for it when m_forbidden is true.
+  std::mutex m_exclusive_mutex;
+
+  /// The states of all threads that have used this pool.
+  std::vector<thread_state*> m_thread_states;
+  std::mutex m_thread_states_mutex;
 
   /// Represents an empty list.
   aterm m_empty_list;
 };
 
+/// \brief Calls lock_shared() of the given pool on construction and unlock_shared() on destruction.
+class aterm_pool_shared_guard : private mcrl2::utilities::noncopyable
+{
+public:
+  explicit aterm_pool_shared_guard(aterm_pool& pool)
+    : m_pool(pool)
+  {
+    m_pool.lock_shared();
+  }
+
+  ~aterm_pool_shared_guard()
+  {
+    m_pool.unlock_shared();
+  }
+
+private:
+  aterm_pool& m_pool;
+};
+
 } // namespace detail
 } // namespace atermpp
 
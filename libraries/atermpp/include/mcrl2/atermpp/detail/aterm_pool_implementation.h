@@ -14,13 +14,37 @@
 #include "aterm_pool.h"
 #include "mcrl2/utilities/logger.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
+#include <thread>
 
 namespace atermpp
 {
 namespace detail
 {
 
+class aterm_pool::registered_thread_state : public aterm_pool::thread_state
+{
+public:
+  explicit registered_thread_state(aterm_pool& pool)
+    : m_pool(pool)
+  {
+    std::lock_guard<std::mutex> guard(m_pool.m_thread_states_mutex);
+    m_pool.m_thread_states.push_back(this);
+  }
+
+  ~registered_thread_state()
+  {
+    std::lock_guard<std::mutex> guard(m_pool.m_thread_states_mutex);
+    auto& states = m_pool.m_thread_states;
+    states.erase(std::find(states.begin(), states.end(), this));
+  }
+
+private:
+  aterm_pool& m_pool;
+};
+
 aterm_pool::aterm_pool() :
   m_int_storage(*this),
   m_appl_storage(
@@ -33,9 +57,11 @@ aterm_pool::aterm_pool() :
     *this,
     *this
   ),
-  m_appl_dynamic_storage(*this)
+  m_appl_dynamic_storage(*this),
+  m_deferred_garbage_collection(false),
+  m_enable_garbage_collection(true)
 {
-  m_countUntilCollection = capacity();
+  m_countUntilCollection = static_cast<std::ptrdiff_t>(capacity());
   
   // Initialize the empty list.
   m_empty_list = create_appl(m_function_symbol_pool.as_empty_list());
@@ -157,33 +183,66 @@ void aterm_pool::trigger_collection()
     return;
   }
 
-  if (m_countUntilCollection > 0)
+  // Destroy some of the garbage of the last collection, for every term that is created.
+  if (!GlobalThreadSafe && m_garbage_size > 0)
   {
-    --m_countUntilCollection;
+    sweep_incrementally();
   }
-  else
+
+  // Only the thread that observes the count dropping below zero requests the collection, the
+  // count is reset by collect() itself.
+  if (--m_countUntilCollection == -1)
   {
     if (m_enable_garbage_collection)
     {
-      collect();
+      collect_impl(EnableIncrementalSweep && !GlobalThreadSafe);
+    }
+    else
+    {
+      // Use some heuristics to determine when the next collection is called.
+      m_countUntilCollection = static_cast<std::ptrdiff_t>(size());
     }
-
-    // Use some heuristics to determine when the next collection is called.
-    m_countUntilCollection = size();
   }
 }
 
 void aterm_pool::collect()
 {
-  if (m_creation_depth > 0)
+  collect_impl(false);
+}
+
+void aterm_pool::collect_impl(bool incremental)
+{
+  if (local_state().depth > 0)
   {
     m_deferred_garbage_collection = true;
     return;
   }
 
+  if (GlobalThreadSafe)
+  {
+    // Wait until all other threads have released the pool.
+    bool deferred = m_deferred_garbage_collection;
+    lock_exclusive();
+
+    // Another thread might have performed the deferred garbage collection in the meantime.
+    if (deferred && !m_deferred_garbage_collection)
+    {
+      unlock_exclusive();
+      return;
+    }
+
+    // Terms that are removed by this thread, e.g. in deletion hooks, should not wait for the collection itself.
+    ++local_state().depth;
+  }
+
   auto timestamp = std::chrono::system_clock::now();
+  const auto start = timestamp;
+  m_print_statistics = EnableGarbageCollectionMetrics || mCRL2logEnabled(mcrl2::log::debug, "gc");
 
   m_deferred_garbage_collection = false;
+
+  // The garbage of the previous collection that has not been destroyed yet must be destroyed before marking.
+  sweep();
   std::size_t old_size = size();
 
   // Marks all terms that are reachable via any reachable term to
@@ -212,43 +271,157 @@ void aterm_pool::collect()
   // Keep track of the duration for marking and reset for sweep.
   auto mark_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
   timestamp = std::chrono::system_clock::now();
-  // Collect all terms that are not reachable or marked.
-  m_int_storage.sweep();
-  std::get<0>(m_appl_storage).sweep();
-  std::get<1>(m_appl_storage).sweep();
-  std::get<2>(m_appl_storage).sweep();
-  std::get<3>(m_appl_storage).sweep();
-  std::get<4>(m_appl_storage).sweep();
-  std::get<5>(m_appl_storage).sweep();
-  std::get<6>(m_appl_storage).sweep();
-  std::get<7>(m_appl_storage).sweep();
-  m_appl_dynamic_storage.sweep();
-
-  // Check that after sweeping the terms are consistent.
-  assert(m_int_storage.verify_sweep());
-  assert(std::get<0>(m_appl_storage).verify_sweep());
-  assert(std::get<1>(m_appl_storage).verify_sweep());
-  assert(std::get<2>(m_appl_storage).verify_sweep());
-  assert(std::get<3>(m_appl_storage).verify_sweep());
-  assert(std::get<4>(m_appl_storage).verify_sweep());
-  assert(std::get<5>(m_appl_storage).verify_sweep());
-  assert(std::get<6>(m_appl_storage).verify_sweep());
-  assert(std::get<7>(m_appl_storage).verify_sweep());
-  assert(m_appl_dynamic_storage.verify_sweep());
 
-  // Print some statistics.
-  if (EnableGarbageCollectionMetrics)
+  if (incremental)
   {
-    // Update the times
-    auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - timestamp).count();
+    // Only determine the terms that are not reachable, these are destroyed by sweep_incrementally().
+    m_garbage_size = m_int_storage.prepare_sweep()
+      + std::get<0>(m_appl_storage).prepare_sweep()
+      + std::get<1>(m_appl_storage).prepare_sweep()
+      + std::get<2>(m_appl_storage).prepare_sweep()
+      + std::get<3>(m_appl_storage).prepare_sweep()
+      + std::get<4>(m_appl_storage).prepare_sweep()
+      + std::get<5>(m_appl_storage).prepare_sweep()
+      + std::get<6>(m_appl_storage).prepare_sweep()
+      + std::get<7>(m_appl_storage).prepare_sweep()
+      + m_appl_dynamic_storage.prepare_sweep();
+    m_number_of_destroyed_terms = 0;
+    m_sweep_time = 0.0;
+  }
+  else
+  {
+    // Collect all terms that are not reachable or marked.
+    m_int_storage.sweep();
+    std::get<0>(m_appl_storage).sweep();
+    std::get<1>(m_appl_storage).sweep();
+    std::get<2>(m_appl_storage).sweep();
+    std::get<3>(m_appl_storage).sweep();
+    std::get<4>(m_appl_storage).sweep();
+    std::get<5>(m_appl_storage).sweep();
+    std::get<6>(m_appl_storage).sweep();
+    std::get<7>(m_appl_storage).sweep();
+    m_appl_dynamic_storage.sweep();
+
+    // Check that after sweeping the terms are consistent.
+    assert(m_int_storage.verify_sweep());
+    assert(std::get<0>(m_appl_storage).verify_sweep());
+    assert(std::get<1>(m_appl_storage).verify_sweep());
+    assert(std::get<2>(m_appl_storage).verify_sweep());
+    assert(std::get<3>(m_appl_storage).verify_sweep());
+    assert(std::get<4>(m_appl_storage).verify_sweep());
+    assert(std::get<5>(m_appl_storage).verify_sweep());
+    assert(std::get<6>(m_appl_storage).verify_sweep());
+    assert(std::get<7>(m_appl_storage).verify_sweep());
+    assert(m_appl_dynamic_storage.verify_sweep());
+  }
+
+  if (GlobalThreadSafe)
+  {
+    // Function symbols are only removed when no thread can create them, see function_symbol_pool::destroy.
+    m_function_symbol_pool.sweep();
+  }
 
-    // Print the relevant information.
-    mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Garbage collected " << old_size - size() << " terms, " << size() << " terms remaining in "
-      << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+  // Use some heuristics to determine when the next collection is called, garbage that has
+  // not been destroyed yet does not count.
+  m_countUntilCollection = static_cast<std::ptrdiff_t>(size() - m_garbage_size);
+
+  // Print some statistics.
+  auto now = std::chrono::system_clock::now();
+  auto sweep_duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - timestamp).count();
+  const double pause_time = std::chrono::duration<double, std::milli>(now - start).count();
+  ++m_number_of_collections;
+  m_total_pause_time += pause_time;
+  m_maximum_pause_time = std::max(m_maximum_pause_time, pause_time);
+
+  if (m_print_statistics)
+  {
+    if (m_garbage_size > 0)
+    {
+      mCRL2log(mcrl2::log::info, "gc") << "g_term_pool(): Garbage collection " << m_number_of_collections << " found " << m_garbage_size
+        << " unreachable terms, " << size() - m_garbage_size << " terms remaining (capacity " << capacity() << ") in "
+        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms), the unreachable terms are destroyed incrementally.\n";
+    }
+    else
+    {
+      mCRL2log(mcrl2::log::info, "gc") << "g_term_pool(): Garbage collection " << m_number_of_collections << " destroyed " << old_size - size()
+        << " terms, " << size() << " terms remaining (capacity " << capacity() << ") in "
+        << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
+    }
+    mCRL2log(mcrl2::log::info, "gc") << "g_term_pool(): Garbage collections paused for " << m_total_pause_time
+      << " ms in total and at most " << m_maximum_pause_time << " ms.\n";
   }
 
   get_symbol_pool().print_performance_stats();
   print_performance_statistics();
+
+  if (GlobalThreadSafe)
+  {
+    --local_state().depth;
+    unlock_exclusive();
+  }
+}
+
+void aterm_pool::sweep()
+{
+  if (m_garbage_size > 0)
+  {
+    sweep_garbage(std::numeric_limits<std::size_t>::max());
+  }
+}
+
+void aterm_pool::sweep_incrementally()
+{
+  // Unprotected terms might be in use and deletion hooks can create terms. The shared guard defers
+  // garbage collections that are triggered in the meantime.
+  if (local_state().depth > 0)
+  {
+    return;
+  }
+  aterm_pool_shared_guard guard(*this);
+
+  if (m_print_statistics)
+  {
+    const auto timestamp = std::chrono::system_clock::now();
+    sweep_garbage(IncrementalSweepSize);
+    m_sweep_time += std::chrono::duration<double, std::milli>(std::chrono::system_clock::now() - timestamp).count();
+  }
+  else
+  {
+    sweep_garbage(IncrementalSweepSize);
+  }
+}
+
+std::size_t aterm_pool::sweep_garbage(std::size_t limit)
+{
+  // The arguments of terms are destroyed first, as in a complete sweep.
+  std::size_t destroyed = m_int_storage.sweep_incrementally(limit);
+  destroyed += std::get<0>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<1>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<2>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<3>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<4>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<5>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<6>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += std::get<7>(m_appl_storage).sweep_incrementally(limit - destroyed);
+  destroyed += m_appl_dynamic_storage.sweep_incrementally(limit - destroyed);
+  m_number_of_destroyed_terms += destroyed;
+
+  if (destroyed < limit)
+  {
+    // All garbage has been considered, note that terms that have been created again are not destroyed.
+    m_garbage_size = 0;
+    if (m_print_statistics)
+    {
+      mCRL2log(mcrl2::log::info, "gc") << "g_term_pool(): Destroyed " << m_number_of_destroyed_terms
+        << " unreachable terms incrementally in " << m_sweep_time << " ms.\n";
+    }
+  }
+  else
+  {
+    m_garbage_size -= std::min(m_garbage_size, destroyed);
+  }
+
+  return destroyed;
 }
 
 void aterm_pool::enable_garbage_collection(bool enable)
@@ -256,6 +429,89 @@ void aterm_pool::enable_garbage_collection(bool enable)
   m_enable_garbage_collection = enable;
 }
 
+void aterm_pool::lock_shared()
+{
+  thread_state& state = local_state();
+  if (state.depth++ == 0 && GlobalThreadSafe)
+  {
+    // Announce that this thread is busy and back off when garbage collection is taking place.
+    state.busy = true;
+    while (m_forbidden)
+    {
+      state.busy = false;
+      {
+        // Wait until the garbage collection has finished.
+        std::lock_guard<std::mutex> guard(m_exclusive_mutex);
+      }
+      state.busy = true;
+    }
+  }
+}
+
+void aterm_pool::unlock_shared()
+{
+  thread_state& state = local_state();
+  assert(state.depth > 0);
+  if (--state.depth == 0)
+  {
+    if (GlobalThreadSafe)
+    {
+      state.busy = false;
+    }
+  }
+}
+
+void aterm_pool::collect_deferred_garbage()
+{
+  // Trigger a deferred garbage collection when it was requested and the created term has been protected.
+  if (m_deferred_garbage_collection && local_state().depth == 0)
+  {
+    if (EnableGarbageCollectionMetrics)
+    {
+      mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Deferred garbage collection.\n";
+    }
+    collect_impl(EnableIncrementalSweep && !GlobalThreadSafe);
+  }
+}
+
+function_symbol aterm_pool::create_function_symbol(const std::string& name, const std::size_t arity, const bool check_for_registered_functions)
+{
+  aterm_pool_shared_guard guard(*this);
+  return m_function_symbol_pool.create(name, arity, check_for_registered_functions);
+}
+
+aterm_pool::thread_state& aterm_pool::local_state() noexcept
+{
+  if (GlobalThreadSafe)
+  {
+    static thread_local registered_thread_state state(*this);
+    return state;
+  }
+
+  return m_local_state;
+}
+
+void aterm_pool::lock_exclusive()
+{
+  m_exclusive_mutex.lock();
+  m_forbidden = true;
+
+  std::lock_guard<std::mutex> guard(m_thread_states_mutex);
+  for (const thread_state* state : m_thread_states)
+  {
+    while (state->busy)
+    {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void aterm_pool::unlock_exclusive()
+{
+  m_forbidden = false;
+  m_exclusive_mutex.unlock();
+}
+
 aterm aterm_pool::create_int(size_t val)
 {
   return m_int_storage.create_int(val);
@@ -316,53 +572,45 @@ aterm aterm_pool::create_appl_dynamic(const function_symbol& sym,
                             InputIterator begin,
                             InputIterator end)
 {
-  ++m_creation_depth;
-
-  const std::size_t arity = sym.arity();
   aterm result;
-
-  switch(arity)
   {
-  case 0:
-    result = std::get<0>(m_appl_storage).create_term(sym);
-    break;
-  case 1:
-    result = std::get<1>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 2:
-    result = std::get<2>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 3:
-    result = std::get<3>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 4:
-    result = std::get<4>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 5:
-    result = std::get<5>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 6:
-    result = std::get<6>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  case 7:
-    result = std::get<7>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
-    break;
-  default:
-    result = m_appl_dynamic_storage.create_appl_dynamic(sym, converter, begin, end);
-  }
+    // The terms created by the converter are only protected once the result has been created.
+    aterm_pool_shared_guard guard(*this);
 
-  --m_creation_depth;
+    const std::size_t arity = sym.arity();
 
-  // Trigger a deferred garbage collection when it was requested and the term has been protected.
-  if (m_creation_depth == 0 && m_deferred_garbage_collection)
-  {
-    if (EnableGarbageCollectionMetrics)
+    switch(arity)
     {
-      mCRL2log(mcrl2::log::info, "Performance") << "g_term_pool(): Deferred garbage collection.\n";
+    case 0:
+      result = std::get<0>(m_appl_storage).create_term(sym);
+      break;
+    case 1:
+      result = std::get<1>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 2:
+      result = std::get<2>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 3:
+      result = std::get<3>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 4:
+      result = std::get<4>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 5:
+      result = std::get<5>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 6:
+      result = std::get<6>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    case 7:
+      result = std::get<7>(m_appl_storage).template create_appl_iterator<InputIterator, ATermConverter>(sym, converter, begin, end);
+      break;
+    default:
+      result = m_appl_dynamic_storage.create_appl_dynamic(sym, converter, begin, end);
     }
-    collect();
   }
 
+  collect_deferred_garbage();
   return result;
 }
 
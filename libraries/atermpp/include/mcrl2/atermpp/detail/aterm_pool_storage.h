@@ -19,6 +19,7 @@
 #include "mcrl2/utilities/unordered_set.h"
 
 #include <limits>
+#include <mutex>
 #include <stack>
 #include <utility>
 #include <vector>
@@ -33,7 +34,9 @@ class aterm_pool;
 
 /// \brief This class provides for all types of term storage. It also
 ///       provides garbage collection via its mark and sweep functions.
-/// \details Internally a hash set is used to ensure that the created terms are unique.
+/// \details Internally a hash set is used to ensure that the created terms are unique. When
+///          ThreadSafe is true insertions into this set are guarded by a mutex, marking and
+///          sweeping is only performed while the aterm_pool is held exclusively.
 template<typename Element,
          typename Hash = aterm_hasher<>,
          typename Equals = aterm_equals<>,
@@ -48,8 +51,8 @@ public:
     Equals,
     typename std::conditional<N == DynamicNumberOfArguments,
       atermpp::detail::_aterm_appl_allocator<>,
-      mcrl2::utilities::block_allocator<Element, 1024, ThreadSafe>>::type,
-    ThreadSafe>;
+      mcrl2::utilities::block_allocator<Element, 1024, false>>::type,
+    false>;
   using iterator = typename unordered_set::iterator;
   using const_iterator = typename unordered_set::const_iterator;
 
@@ -122,6 +125,19 @@ public:
   ///        mark() was called first.
   void sweep();
 
+  /// \brief Marks all terms that are not reachable as garbage, which is destroyed by sweep_incrementally()
+  ///        afterwards. Requires that mark() was called first and that no garbage remains.
+  /// \returns The number of garbage terms.
+  std::size_t prepare_sweep();
+
+  /// \brief Destroys at most limit of the garbage terms found by prepare_sweep(). Garbage terms
+  ///        that have been created again in the meantime are not destroyed.
+  /// \returns The number of terms that have been destroyed.
+  std::size_t sweep_incrementally(std::size_t limit);
+
+  /// \returns The number of terms found by prepare_sweep() that have not been considered by sweep_incrementally().
+  std::size_t garbage_size() const { return m_garbage.size(); }
+
   /// \returns The number of terms stored in this storage.
   std::size_t size() const { return m_term_set.size(); }
 
@@ -170,6 +186,9 @@ private:
   /// This is the set of term pointers to keep the terms unique.
   unordered_set m_term_set;
 
+  /// Ensures that only one thread at a time modifies the term set.
+  std::mutex m_mutex;
+
   /// This array stores creation, resp deletion, hooks for function symbols.
   std::vector<callback_pair> m_creation_hooks;
   std::vector<callback_pair> m_deletion_hooks;
@@ -177,6 +196,9 @@ private:
   /// A reusable todo stack.
   std::stack<std::reference_wrapper<_aterm>> todo;
 
+  /// The garbage terms that still have to be destroyed by sweep_incrementally().
+  std::vector<Element*> m_garbage;
+
   // Various performance statistics.
 
   mcrl2::utilities::cache_metric m_term_metric; ///< Count the number of times a term has been found in or is added to the set.
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <cstring>
+#include <optional>
 
 namespace atermpp
 {
@@ -211,6 +212,62 @@ void ATERM_POOL_STORAGE::sweep()
   m_erasedBlocks = m_term_set.get_allocator().consolidate();
 }
 
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::prepare_sweep()
+{
+  assert(m_garbage.empty());
+
+  // Iterate over all terms, remember the ones that are not reachable and reset the marked ones.
+  for (Element& term : m_term_set)
+  {
+    if (!term.is_reachable())
+    {
+      term.mark_garbage();
+      m_garbage.push_back(&term);
+    }
+    else if (term.is_marked())
+    {
+      term.reset();
+    }
+  }
+
+  return m_garbage.size();
+}
+
+ATERM_POOL_STORAGE_TEMPLATES
+std::size_t ATERM_POOL_STORAGE::sweep_incrementally(std::size_t limit)
+{
+  if (m_garbage.empty())
+  {
+    return 0;
+  }
+
+  std::size_t destroyed = 0;
+  while (!m_garbage.empty() && destroyed < limit)
+  {
+    Element& term = *m_garbage.back();
+    m_garbage.pop_back();
+
+    // Terms that have been created again since the garbage collection are not garbage anymore.
+    if (term.is_garbage())
+    {
+      term.revive();
+      call_deletion_hook(&term);
+      m_term_set.erase(term);
+      ++destroyed;
+    }
+  }
+
+  if (m_garbage.empty())
+  {
+    // Clean up unnecessary blocks once all garbage has been destroyed.
+    m_garbage.shrink_to_fit();
+    m_erasedBlocks = m_term_set.get_allocator().consolidate();
+  }
+
+  return destroyed;
+}
+
 /// PRIVATE FUNCTIONS
 
 ATERM_POOL_STORAGE_TEMPLATES
@@ -249,7 +306,7 @@ bool ATERM_POOL_STORAGE::verify_mark()
        const _term_appl& ta = static_cast<const _term_appl&>(term);
        for (std::size_t i = 0; i < ta.function().arity(); ++i)
        {
-         assert(detail::address(ta.arg(i))->is_reachable());
+         assert(is_small_integer(detail::address(ta.arg(i))) || detail::address(ta.arg(i))->is_reachable());
        }
     }
   }
@@ -288,9 +345,32 @@ ATERM_POOL_STORAGE_TEMPLATES
 template<typename ...Args>
 aterm ATERM_POOL_STORAGE::emplace(Args&&... args)
 {
+  // Garbage collection is deferred while the new term is not yet protected.
+  std::optional<aterm_pool_shared_guard> guard;
+  if (ThreadSafe)
+  {
+    guard.emplace(m_pool);
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+  if (ThreadSafe)
+  {
+    lock.lock();
+  }
 
   auto result = m_term_set.emplace(std::forward<Args>(args)...);
+  if (!result.second && (*result.first).is_garbage())
+  {
+    // The term was found to be garbage, but it has not been destroyed yet.
+    (*result.first).revive();
+  }
   aterm term(&(*result.first));
+
+  if (ThreadSafe)
+  {
+    lock.unlock();
+  }
+
   if (result.second)
   {
     // A new term was created
@@ -304,6 +384,10 @@ aterm ATERM_POOL_STORAGE::emplace(Args&&... args)
     m_term_metric.hit();
   }
 
+  // The new term is protected, so a collection that was deferred by this or another thread can take place.
+  guard.reset();
+  m_pool.collect_deferred_garbage();
+
   return term;
 }
 
@@ -333,6 +417,12 @@ void ATERM_POOL_STORAGE::mark_term(_aterm& root)
     {
       // Marks all arguments that are not already (marked as) reachable, because the current
       // term is reachable and as such its arguments are reachable as well.
+      // Small integers are stored in the argument itself and need not be marked.
+      if (is_small_integer(detail::address(term_appl.arg(i))))
+      {
+        continue;
+      }
+
       _aterm& argument = *detail::address(term_appl.arg(i));
       if (!argument.is_reachable())
       {
@@ -365,7 +455,10 @@ bool ATERM_POOL_STORAGE::verify_term(_aterm& term)
     for (std::size_t i = 0; i < ta.function().arity(); ++i)
     {
       assert(ta.arg(i).defined());
-      verify_term<DynamicNumberOfArguments>(*detail::address(ta.arg(0)));
+      if (!is_small_integer(detail::address(ta.arg(0))))
+      {
+        verify_term<DynamicNumberOfArguments>(*detail::address(ta.arg(0)));
+      }
     }
   }
   return true;
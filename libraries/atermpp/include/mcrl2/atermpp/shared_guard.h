@@ -0,0 +1,41 @@
+// Author(s): Maurice Laveaux.
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef MCRL2_ATERMPP_SHARED_GUARD_H
+#define MCRL2_ATERMPP_SHARED_GUARD_H
+
+#include "mcrl2/atermpp/detail/global_aterm_pool.h"
+
+namespace atermpp
+{
+
+/// \brief Prevents garbage collection of the global term pool while it is in scope.
+/// \details When the term library is thread safe (GlobalThreadSafe) a thread must hold a
+///          shared_guard whenever it uses terms that are not protected, for example the
+///          arguments of a term or an unprotected_aterm. Garbage collection only takes
+///          place when no thread holds a shared_guard, so long running threads should
+///          regularly release it. Without thread safety this guard only defers garbage
+///          collection until it goes out of scope.
+class shared_guard : private mcrl2::utilities::noncopyable
+{
+public:
+  shared_guard()
+  {
+    detail::g_term_pool().lock_shared();
+  }
+
+  ~shared_guard()
+  {
+    detail::g_term_pool().unlock_shared();
+  }
+};
+
+} // namespace atermpp
+
+#endif // MCRL2_ATERMPP_SHARED_GUARD_H
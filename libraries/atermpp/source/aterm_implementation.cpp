@@ -32,6 +32,16 @@ void atermpp::add_deletion_hook(const function_symbol& function, term_callback c
   g_term_pool().add_deletion_hook(function, callback);
 }
 
+void atermpp::detail::lock_shared_term_pool()
+{
+  g_term_pool().lock_shared();
+}
+
+void atermpp::detail::unlock_shared_term_pool()
+{
+  g_term_pool().unlock_shared();
+}
+
 aterm_input::~aterm_input() {}
 
 aterm_output::~aterm_output() {}
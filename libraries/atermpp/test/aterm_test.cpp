@@ -13,12 +13,15 @@
 #include <iostream>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <boost/test/included/unit_test_framework.hpp>
 
 #include "mcrl2/atermpp/aterm_io.h"
 #include "mcrl2/atermpp/aterm_int.h"
 #include "mcrl2/atermpp/aterm_list.h"
 #include "mcrl2/atermpp/aterm_string.h"
+#include "mcrl2/atermpp/shared_guard.h"
 
 using namespace std;
 using namespace atermpp;
@@ -82,3 +85,206 @@ BOOST_AUTO_TEST_CASE(test_several_aterm_io)
   test_aterm_io("[a,b,[]]");
   test_aterm_io("f([a,f(x),[]],2,[g,g(34566)])"); 
 }
+
+BOOST_AUTO_TEST_CASE(test_concurrent_term_creation)
+{
+  // Without thread safety only a single thread is allowed to create terms.
+  const std::size_t number_of_threads = atermpp::detail::GlobalThreadSafe ? 4 : 1;
+
+  std::vector<aterm> results(number_of_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t id = 0; id < number_of_threads; ++id)
+  {
+    threads.emplace_back([&results, id]()
+      {
+        function_symbol f("f", 2);
+        for (std::size_t round = 0; round < 10; ++round)
+        {
+          aterm_list list;
+          for (std::size_t i = 0; i < 1000; ++i)
+          {
+            list.push_front(aterm_appl(f, aterm_int(i), aterm_int(round)));
+          }
+
+          // Obtain the arguments of the list, which are not protected themselves.
+          shared_guard guard;
+          results[id] = list.front();
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  detail::g_term_pool().collect();
+  for (const aterm& result : results)
+  {
+    BOOST_CHECK(result == aterm_appl(function_symbol("f", 2), aterm_int(999), aterm_int(9)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_aterm_int)
+{
+  // Small integers are not stored in the term pool, large ones are.
+  const std::size_t large = detail::max_small_integer + 1;
+  for (std::size_t value : { std::size_t(0), std::size_t(1), detail::max_small_integer, large })
+  {
+    aterm_int i(value);
+    BOOST_CHECK(i.value() == value);
+    BOOST_CHECK(i.type_is_int());
+    BOOST_CHECK(!i.type_is_list());
+    BOOST_CHECK(!i.type_is_appl());
+    BOOST_CHECK(i.function() == detail::g_as_int);
+    BOOST_CHECK(i == aterm_int(value));
+    BOOST_CHECK(aterm(i) == aterm_int(value));
+  }
+  BOOST_CHECK(aterm_int(0) != aterm_int(1));
+
+  // Integers as arguments survive garbage collection.
+  const aterm_appl t(function_symbol("f", 2), aterm_int(42), aterm_int(large));
+  detail::g_term_pool().collect();
+  BOOST_CHECK(down_cast<aterm_int>(t[0]).value() == 42);
+  BOOST_CHECK(down_cast<aterm_int>(t[1]).value() == large);
+  BOOST_CHECK(t[0].type_is_int() && t[1].type_is_int());
+  BOOST_CHECK(t == aterm_appl(function_symbol("f", 2), aterm_int(42), aterm_int(large)));
+
+  test_aterm_io("f(42,g([0,1]))");
+}
+
+static std::size_t number_of_h_terms = 0;
+
+BOOST_AUTO_TEST_CASE(test_incremental_sweep)
+{
+  const function_symbol g("g", 1);
+  const function_symbol h("h", 1);
+  add_creation_hook(h, [](const aterm&) { ++number_of_h_terms; });
+  add_deletion_hook(h, [](const aterm&) { --number_of_h_terms; });
+
+  const std::size_t n = 1000;
+  std::vector<aterm_appl> terms;
+  for (std::size_t round = 0; round < 5; ++round)
+  {
+    // Keep only half of the terms, the other half becomes garbage.
+    terms.clear();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      aterm_appl t(h, aterm_int(i));
+      if (i % 2 == 0)
+      {
+        terms.push_back(t);
+      }
+    }
+
+    // Create enough terms to trigger garbage collections, whose garbage is destroyed incrementally.
+    for (std::size_t i = 0; i < 100 * n; ++i)
+    {
+      aterm_appl(g, aterm_int(round * 100 * n + i));
+    }
+
+    // Garbage that has not been destroyed yet can be created again.
+    for (std::size_t i = 1; i < n; i += 2)
+    {
+      terms.emplace_back(h, aterm_int(i));
+    }
+  }
+
+  detail::g_term_pool().collect();
+  BOOST_CHECK_EQUAL(number_of_h_terms, n);
+  for (const aterm_appl& t : terms)
+  {
+    BOOST_CHECK(t == aterm_appl(h, t[0]));
+    BOOST_CHECK(down_cast<aterm_int>(t[0]).value() < n);
+  }
+}
+
+static std::size_t number_of_k_terms = 0;
+
+BOOST_AUTO_TEST_CASE(test_deferred_garbage_collection)
+{
+  const function_symbol k("k", 1);
+  add_creation_hook(k, [](const aterm&) { ++number_of_k_terms; });
+  add_deletion_hook(k, [](const aterm&) { --number_of_k_terms; });
+
+  detail::g_term_pool().collect();
+  {
+    aterm_appl t(k, aterm_int(1));
+    BOOST_CHECK_EQUAL(number_of_k_terms, 1u);
+
+    // A collection that is requested while the pool is held in shared mode is deferred.
+    shared_guard guard;
+    t = aterm_appl();
+    detail::g_term_pool().collect();
+  }
+
+  // Releasing the pool does not perform the deferred collection, only creating a term does.
+  BOOST_CHECK_EQUAL(number_of_k_terms, 1u);
+  aterm_appl u(k, aterm_int(2));
+  detail::g_term_pool().sweep();
+  BOOST_CHECK_EQUAL(number_of_k_terms, 1u);
+}
+
+#ifdef MCRL2_ENABLE_MULTITHREADING
+// Several threads create and release terms, such that garbage collections take place while other threads
+// are creating terms. One of the threads also requests collections explicitly.
+BOOST_AUTO_TEST_CASE(test_concurrent_garbage_collection)
+{
+  const std::size_t number_of_threads = 4;
+  const std::size_t n = 10000;
+
+  std::vector<std::vector<aterm_appl>> results(number_of_threads);
+  std::vector<std::thread> threads;
+  for (std::size_t id = 0; id < number_of_threads; ++id)
+  {
+    threads.emplace_back([&results, id]()
+      {
+        function_symbol f("f", 2);
+        std::vector<aterm_appl>& terms = results[id];
+        for (std::size_t round = 0; round < 20; ++round)
+        {
+          // The terms of the previous round become garbage.
+          terms.clear();
+          aterm_list list;
+          for (std::size_t i = 0; i < n; ++i)
+          {
+            aterm_appl t(f, aterm_int(i), aterm_int(id));
+            terms.push_back(t);
+            list.push_front(aterm_appl(f, t, aterm_int(round)));
+          }
+
+          std::size_t i = n;
+          for (const aterm& t : list)
+          {
+            --i;
+            if (t != aterm_appl(f, terms[i], aterm_int(round)))
+            {
+              BOOST_ERROR("term " << t << " was modified");
+              return;
+            }
+          }
+
+          if (id == 0)
+          {
+            detail::g_term_pool().collect();
+          }
+        }
+      });
+  }
+
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+
+  detail::g_term_pool().collect();
+  for (std::size_t id = 0; id < number_of_threads; ++id)
+  {
+    BOOST_CHECK_EQUAL(results[id].size(), n);
+    for (std::size_t i = 0; i < results[id].size(); ++i)
+    {
+      BOOST_CHECK(results[id][i] == aterm_appl(function_symbol("f", 2), aterm_int(i), aterm_int(id)));
+    }
+  }
+}
+#endif // MCRL2_ENABLE_MULTITHREADING
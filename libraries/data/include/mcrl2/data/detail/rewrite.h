@@ -11,8 +11,10 @@
 #ifndef MCRL2_DATA_DETAIL_REWRITE_H
 #define MCRL2_DATA_DETAIL_REWRITE_H
 
+#include <memory>
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/enumerator_identifier_generator.h"
+#include "mcrl2/data/detail/rewrite_profile.h"
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/data/selection.h"
 #include "mcrl2/data/substitutions/mutable_indexed_substitution.h"
@@ -43,6 +45,23 @@ class Rewriter
 {
   protected:
     enumerator_identifier_generator m_generator;  //name for variables.
+    std::unique_ptr<rewrite_profile> m_profile;   // Only defined if the rewriter is profiled.
+
+    /// \brief Prints the profile of this rewriter, if it is profiled.
+    void print_profile(rewrite_strategy strategy, bool equations_are_profiled) const;
+
+    /// \brief Copy constructor, used by clone(). The copy has its own name generator, and its own profile
+    ///        in which nothing has been recorded yet.
+    Rewriter(const Rewriter& other):
+          m_profile(other.m_profile ? new rewrite_profile(*other.m_profile) : nullptr),
+          data_equation_selector(other.data_equation_selector),
+          m_data_specification_for_enumeration(other.m_data_specification_for_enumeration)
+    {
+      if (m_profile)
+      {
+        m_profile->reset_statistics();
+      }
+    }
 
   public:
     typedef mutable_indexed_substitution<> substitution_type;
@@ -54,6 +73,7 @@ class Rewriter
      * \sa createRewriter()
      **/
     Rewriter(const data_specification& data_spec, const used_data_equation_selector& eq_selector):
+          m_profile(rewrite_profiling_enabled() ? new rewrite_profile() : nullptr),
           data_equation_selector(eq_selector),
           m_data_specification_for_enumeration(data_spec)
     {
@@ -63,11 +83,29 @@ class Rewriter
     **/
     Rewriter& operator=(const Rewriter& other)=delete;
 
+    /** \brief Returns a rewriter with the same rewrite rules, that can be used independently of this
+     *         rewriter, for instance in another thread. By default a new rewriter is created; rewriters
+     *         that can share their rewrite rules and compiled code override this function.
+     **/
+    virtual std::shared_ptr<Rewriter> clone();
+
     /** \brief Destructor. */
     virtual ~Rewriter()
     {
     }
 
+    /** \brief The profile of this rewriter, or nullptr if it is not profiled. */
+    rewrite_profile* profile()
+    {
+      return m_profile.get();
+    }
+
+    /** \brief Stops profiling this rewriter, e.g. because it is only used internally by another rewriter. */
+    void disable_profile()
+    {
+      m_profile.reset();
+    }
+
     /** \brief The fresh name generator of the rewriter */
     data::enumerator_identifier_generator& identifier_generator()
     {
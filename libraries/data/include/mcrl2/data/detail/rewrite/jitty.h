@@ -13,6 +13,8 @@
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/rewrite/strategy_rule.h"
+#include "mcrl2/data/detail/rewrite/native_numbers.h"
+#include "mcrl2/data/detail/rewrite/rewrite_cache.h"
 
 namespace mcrl2
 {
@@ -27,17 +29,33 @@ class RewriterJitty: public Rewriter
     typedef Rewriter::substitution_type substitution_type;
 
     RewriterJitty(const data_specification& data_spec, const used_data_equation_selector &);
+
+    /// \brief Copies the rewrite strategies of other. The copy remembers its own normal forms.
+    RewriterJitty(const RewriterJitty& other);
+
     virtual ~RewriterJitty();
 
+    std::shared_ptr<Rewriter> clone();
+
     rewrite_strategy getStrategy();
 
     data_expression rewrite(const data_expression &term, substitution_type &sigma);
 
     RewriterJitty& operator=(const RewriterJitty& other)=delete;
 
+    /// \brief Stops remembering the normal forms of ground terms.
+    void disable_rewrite_cache()
+    {
+      m_rewrite_cache.reset();
+    }
+
   private:
     std::map< function_symbol, data_equation_list > jitty_eqns;
     std::vector<strategy> jitty_strat;
+    std::vector<native_operation_spec> m_native_operations; // Indexed in the same way as jitty_strat.
+    std::vector<std::vector<std::size_t> > m_profiled_equations; // If profiled, the indices in the profile of the equations
+                                                                 // in each strategy, indexed in the same way as jitty_strat.
+    std::unique_ptr<rewrite_cache> m_rewrite_cache; // The normal forms of ground terms, if they are remembered.
 
     data_expression rewrite_aux(const data_expression& term, substitution_type& sigma);
 
@@ -46,6 +64,12 @@ class RewriterJitty: public Rewriter
                       const data_expression& term,
                       substitution_type& sigma);
 
+    /// \brief Rewrites the ground term with head symbol op, using the normal form in m_rewrite_cache if it is known.
+    data_expression rewrite_aux_cached_function_symbol(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma);
+
     data_expression rewrite_aux_const_function_symbol(
                       const function_symbol& op,
                       substitution_type& sigma);
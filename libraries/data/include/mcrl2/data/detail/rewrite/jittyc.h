@@ -23,6 +23,7 @@
 
 #include <utility>
 #include <string>
+#include <unordered_map>
 
 namespace mcrl2
 {
@@ -38,17 +39,34 @@ typedef std::vector < sort_expression_list> sort_list_vector;
 ///        are inserted in it. By keeping the cache on the stack, the normal forms
 ///        in it will not be freed by the ATerm library, and can therefore be used
 ///        in the generated jittyc code.
+/// \details The generated code refers to the stored terms by their position in the
+///          cache instead of by their address. Therefore the generated code does not
+///          depend on where terms happen to be allocated, and the compiled rewriter can
+///          be reused by a later run on the same specification.
 ///
 class normal_form_cache
 {
   private:
     RewriterJitty& m_rewriter;
-    std::set<data_expression> m_lookup;
+    std::shared_ptr<std::vector<data_expression> > m_terms;
+    std::unordered_map<data_expression, std::size_t> m_lookup;
   public:
     normal_form_cache(RewriterJitty& rewriter)
-      : m_rewriter(rewriter)
+      : m_rewriter(rewriter),
+        m_terms(std::make_shared<std::vector<data_expression> >())
     { 
     }
+
+  ///
+  /// \brief Creates a cache that shares the stored terms of other, such that a copy of
+  ///        the compiled rewriter can keep using them when other is destroyed.
+  ///
+  normal_form_cache(RewriterJitty& rewriter, const normal_form_cache& other)
+    : m_rewriter(rewriter),
+      m_terms(other.m_terms),
+      m_lookup(other.m_lookup)
+  {
+  }
   
   ///
   /// \brief insert stores the normal form of t in the cache, and returns a string
@@ -60,19 +78,41 @@ class normal_form_cache
   ///
   std::string insert(const data_expression& t)
   {
-    std::stringstream ss;
     RewriterJitty::substitution_type sigma;
-    auto pair = m_lookup.insert(m_rewriter(t, sigma));
-    ss << "*reinterpret_cast<const data_expression*>(" << (void*)&(*pair.first) << ")";
-    return ss.str();
+    return reference(m_rewriter(t, sigma));
+  }
+
+  ///
+  /// \brief reference stores t in the cache, and returns a string that is a C++
+  ///        representation of t, under the same conditions as insert.
+  ///
+  std::string reference(const data_expression& t)
+  {
+    auto pair = m_lookup.insert(std::make_pair(t, m_terms->size()));
+    if (pair.second)
+    {
+      m_terms->push_back(t);
+    }
+    return "jittyc_terms[" + std::to_string(pair.first->second) + "]";
+  }
+
+  ///
+  /// \brief terms returns the stored terms, which are referred to as jittyc_terms
+  ///        by the generated code.
+  ///
+  const data_expression* terms() const
+  {
+    return m_terms->data();
   }
 
   ///
   /// \brief clear clears the cache. This operation invalidates all the C++ strings
-  ///        obtained via the insert() method.
+  ///        obtained via the insert() method. Copies of the rewriter that share the
+  ///        stored terms keep them.
   ///
   void clear()
   {
+    m_terms = std::make_shared<std::vector<data_expression> >();
     m_lookup.clear();
   }
 };
@@ -84,8 +124,14 @@ class RewriterCompilingJitty: public Rewriter
     typedef data_expression (*rewriter_function)(const application&, RewriterCompilingJitty*);
 
     RewriterCompilingJitty(const data_specification& DataSpec, const used_data_equation_selector &);
+
+    /// \brief Creates a rewriter that uses the compiled code of other, without compiling it again.
+    RewriterCompilingJitty(const RewriterCompilingJitty& other);
+
     virtual ~RewriterCompilingJitty();
 
+    std::shared_ptr<Rewriter> clone();
+
     rewrite_strategy getStrategy();
 
     data_expression rewrite(const data_expression& term, substitution_type& sigma);
@@ -129,6 +175,18 @@ class RewriterCompilingJitty: public Rewriter
     std::vector<rewriter_function> functions_when_arguments_are_not_in_normal_form;
     std::vector<rewriter_function> functions_when_arguments_are_in_normal_form;
 
+    // The terms that the generated code refers to by their position in this array.
+    const data_expression* precompiled_terms() const
+    {
+      return m_nf_cache.terms();
+    }
+
+    // Returns true if the compiled rewriter was taken from the cache in MCRL2_JITTYC_CACHE_DIR.
+    bool loaded_from_cache() const
+    {
+      return m_loaded_from_cache;
+    }
+
     // Standard assignment operator.
     RewriterCompilingJitty& operator=(const RewriterCompilingJitty& other)=delete;
 
@@ -139,11 +197,14 @@ class RewriterCompilingJitty: public Rewriter
     RewriterJitty jitty_rewriter;
     std::set < data_equation > rewrite_rules;
     bool made_files;
+    bool m_loaded_from_cache = false;
     std::map<function_symbol, data_equation_list> jittyc_eqns;
     std::set<function_symbol> m_extra_symbols;
 
     std::shared_ptr<uncompiled_library> rewriter_so;
     normal_form_cache m_nf_cache;
+    std::unique_ptr<rewrite_cache> m_rewrite_cache; // The normal forms of terms that are ground under the substitution,
+                                                    // if they are remembered.
 
     void (*so_rewr_cleanup)();
     data_expression(*so_rewr)(const data_expression&, RewriterCompilingJitty*);
@@ -155,7 +216,11 @@ class RewriterCompilingJitty: public Rewriter
     bool calc_nfs(const data_expression& t, variable_or_number_list nnfvars);
     void CleanupRewriteSystem();
     void BuildRewriteSystem();
-    void generate_code(const std::string& filename);
+    /// \brief Rewrites term under sigma using m_rewrite_cache, which must be enabled.
+    data_expression rewrite_cached(const data_expression& term, substitution_type& sigma);
+    /// \brief Generates the rewriter in the file filename, and possibly in more translation units.
+    /// \returns The names of all generated files, starting with filename.
+    std::vector<std::string> generate_code(const std::string& filename);
     void generate_rewr_functions(std::ostream& s, const data::function_symbol& func, const data_equation_list& eqs);
     bool lift_rewrite_rule_to_right_arity(data_equation& e, const std::size_t requested_arity);
     sort_list_vector get_residual_sorts(const sort_expression& s, const std::size_t actual_arity, const std::size_t requested_arity);
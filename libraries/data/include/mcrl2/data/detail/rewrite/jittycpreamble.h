@@ -15,6 +15,7 @@
 #include "mcrl2/utilities/toolset_version_const.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
+#include "mcrl2/data/detail/rewrite/native_numbers.h"
 
 using namespace mcrl2::data::detail;
 using namespace mcrl2::data;
@@ -29,9 +30,13 @@ using atermpp::down_cast;
 #define DLLEXPORT
 #endif // _MSC_VER
 
+// The rewriter may be divided over several translation units, in which case all but
+// the first one define MCRL2_JITTYC_SHARD. Only the first one defines the interface.
+#ifndef MCRL2_JITTYC_SHARD
 extern "C" {
   DLLEXPORT bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter);
 }
+#endif
 
 // A rewrite_term is a term that may or may not be in normal form. If the method"
 // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible."
@@ -49,7 +54,9 @@ static const data_expression& local_rewrite(const data_expression& t)
 //
 // Forward declarations
 //
+#ifndef MCRL2_JITTYC_SHARD
 static void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter);
+#endif
 static data_expression rewrite_aux(const data_expression& t, const bool arguments_in_normal_form, RewriterCompilingJitty* this_rewriter);
 static inline data_expression rewrite_abstraction_aux(const abstraction& a, const data_expression& t, RewriterCompilingJitty* this_rewriter);
 static data_expression rewrite_with_arguments_in_normal_form(const data_expression& t, RewriterCompilingJitty* this_rewriter)
@@ -333,6 +340,7 @@ data_expression rewrite_aux(const data_expression& t, const bool arguments_in_no
   }
 }
 
+#ifndef MCRL2_JITTYC_SHARD
 static
 void rewrite_cleanup()
 {
@@ -354,5 +362,6 @@ bool init(rewriter_interface* i, RewriterCompilingJitty* this_rewriter)
   i->status = "rewriter loaded successfully.";
   return true;
 }
+#endif // MCRL2_JITTYC_SHARD
 
 #endif // __REWR_JITTYC_PREAMBLE_H
@@ -0,0 +1,550 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/native_numbers.h
+/// \brief Evaluation of the standard operations on Pos, Nat and Int on machine words.
+/// \details Numbers are represented by the binary constructors \@c1, \@cDub, \@c0, \@cNat, \@cInt and \@cNeg,
+///          and arithmetic is normally carried out by rewriting with the equations of these sorts. This takes
+///          many rewrite steps, even for an increment. The rewriters use the functions below to compute the
+///          result of an operation applied to numbers directly, when the arguments and the result fit in a
+///          signed 64 bit word. In all other cases, e.g. on overflow or when an argument is not a number,
+///          the evaluation fails and the equations are used as before.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_NATIVE_NUMBERS_H
+#define MCRL2_DATA_DETAIL_REWRITE_NATIVE_NUMBERS_H
+
+#include <cstdint>
+#include <limits>
+#include "mcrl2/data/int.h"
+#include "mcrl2/data/standard.h"
+
+namespace mcrl2
+{
+namespace data
+{
+namespace detail
+{
+
+/// \brief The operations on numbers that can be evaluated on machine words.
+enum class native_operation
+{
+  none, plus, minus, times, div, mod, exp, maximum, minimum, negate, abs, succ, pred, convert,
+  equal_to, not_equal_to, less, less_equal, greater, greater_equal
+};
+
+/// \brief The sort of the result of a native operation.
+enum class native_sort
+{
+  pos, nat, int_, bool_
+};
+
+inline const char* native_operation_name(native_operation op)
+{
+  static const char* names[] = { "none", "plus", "minus", "times", "div", "mod", "exp", "maximum", "minimum",
+                                 "negate", "abs", "succ", "pred", "convert", "equal_to", "not_equal_to", "less",
+                                 "less_equal", "greater", "greater_equal" };
+  return names[static_cast<std::size_t>(op)];
+}
+
+inline const char* native_sort_name(native_sort s)
+{
+  static const char* names[] = { "pos", "nat", "int_", "bool_" };
+  return names[static_cast<std::size_t>(s)];
+}
+
+/// \brief Describes how a function symbol is evaluated on machine words.
+struct native_operation_spec
+{
+  native_operation operation = native_operation::none;
+  native_sort result = native_sort::bool_;
+  std::size_t arity = 0;
+};
+
+/// \brief Determines whether s is one of the sorts Pos, Nat or Int.
+inline bool is_native_number_sort(const sort_expression& s)
+{
+  return s == sort_pos::pos() || s == sort_nat::nat() || s == sort_int::int_();
+}
+
+/// \brief Returns the native operation of the standard function symbol f on Pos, Nat and Int, or an
+///        operation none if f cannot be evaluated on machine words.
+inline native_operation_spec native_operation_of(const function_symbol& f)
+{
+  native_operation_spec result;
+  if (!is_function_sort(f.sort()))
+  {
+    return result;
+  }
+
+  const function_sort& s = atermpp::down_cast<function_sort>(f.sort());
+  const std::size_t arity = s.domain().size();
+  if (arity < 1 || arity > 2)
+  {
+    return result;
+  }
+  for (const sort_expression& d: s.domain())
+  {
+    if (!is_native_number_sort(d))
+    {
+      return result;
+    }
+  }
+
+  const core::identifier_string& name = f.name();
+  native_operation op = native_operation::none;
+  if (s.codomain() == sort_bool::bool_())
+  {
+    if (arity == 2)
+    {
+      if (detail::equal_symbol::is_function_symbol(f))
+      {
+        op = native_operation::equal_to;
+      }
+      else if (detail::not_equal_symbol::is_function_symbol(f))
+      {
+        op = native_operation::not_equal_to;
+      }
+      else if (detail::less_symbol::is_function_symbol(f))
+      {
+        op = native_operation::less;
+      }
+      else if (detail::less_equal_symbol::is_function_symbol(f))
+      {
+        op = native_operation::less_equal;
+      }
+      else if (detail::greater_symbol::is_function_symbol(f))
+      {
+        op = native_operation::greater;
+      }
+      else if (detail::greater_equal_symbol::is_function_symbol(f))
+      {
+        op = native_operation::greater_equal;
+      }
+    }
+    result.result = native_sort::bool_;
+  }
+  else if (is_native_number_sort(s.codomain()))
+  {
+    if (arity == 2)
+    {
+      if (name == sort_nat::plus_name())
+      {
+        op = native_operation::plus;
+      }
+      else if (name == sort_int::minus_name())
+      {
+        op = native_operation::minus;
+      }
+      else if (name == sort_nat::times_name())
+      {
+        op = native_operation::times;
+      }
+      else if (name == sort_nat::div_name())
+      {
+        op = native_operation::div;
+      }
+      else if (name == sort_nat::mod_name())
+      {
+        op = native_operation::mod;
+      }
+      else if (name == sort_nat::exp_name())
+      {
+        op = native_operation::exp;
+      }
+      else if (name == sort_nat::maximum_name())
+      {
+        op = native_operation::maximum;
+      }
+      else if (name == sort_nat::minimum_name())
+      {
+        op = native_operation::minimum;
+      }
+    }
+    else
+    {
+      if (name == sort_int::negate_name())
+      {
+        op = native_operation::negate;
+      }
+      else if (name == sort_int::abs_name())
+      {
+        op = native_operation::abs;
+      }
+      else if (name == sort_nat::succ_name())
+      {
+        op = native_operation::succ;
+      }
+      else if (name == sort_nat::pred_name())
+      {
+        op = native_operation::pred;
+      }
+      else if (name == sort_nat::pos2nat_name() || name == sort_nat::nat2pos_name() ||
+               name == sort_int::pos2int_name() || name == sort_int::int2pos_name() ||
+               name == sort_int::nat2int_name() || name == sort_int::int2nat_name())
+      {
+        op = native_operation::convert;
+      }
+    }
+
+    if (s.codomain() == sort_pos::pos())
+    {
+      result.result = native_sort::pos;
+    }
+    else if (s.codomain() == sort_nat::nat())
+    {
+      result.result = native_sort::nat;
+    }
+    else
+    {
+      result.result = native_sort::int_;
+    }
+  }
+
+  if (op != native_operation::none)
+  {
+    result.operation = op;
+    result.arity = arity;
+  }
+  return result;
+}
+
+/// \brief Computes the value of a positive number of at most 63 bits.
+/// \returns False if t is not a positive number in normal form, or if it does not fit.
+inline bool native_positive_value(const data_expression& t, std::int64_t& value)
+{
+  std::int64_t result = 0;
+  std::size_t bit = 0;
+  const data_expression* p = &t;
+  while (sort_pos::is_cdub_application(*p))
+  {
+    if (bit == 62)
+    {
+      return false;
+    }
+    const application& a = atermpp::down_cast<application>(*p);
+    if (sort_bool::is_true_function_symbol(a[0]))
+    {
+      result |= std::int64_t(1) << bit;
+    }
+    else if (!sort_bool::is_false_function_symbol(a[0]))
+    {
+      return false;
+    }
+    p = &a[1];
+    ++bit;
+  }
+
+  if (!sort_pos::is_c1_function_symbol(*p))
+  {
+    return false;
+  }
+  value = result | (std::int64_t(1) << bit);
+  return true;
+}
+
+/// \brief Computes the value of a number of sort Pos, Nat or Int.
+/// \returns False if t is not a number in normal form, or if it does not fit in a signed 64 bit word.
+inline bool native_value(const data_expression& t, std::int64_t& value)
+{
+  if (sort_nat::is_c0_function_symbol(t))
+  {
+    value = 0;
+    return true;
+  }
+  if (sort_nat::is_cnat_application(t))
+  {
+    return native_positive_value(atermpp::down_cast<application>(t)[0], value);
+  }
+  if (sort_int::is_cint_application(t))
+  {
+    return native_value(atermpp::down_cast<application>(t)[0], value);
+  }
+  if (sort_int::is_cneg_application(t))
+  {
+    if (native_positive_value(atermpp::down_cast<application>(t)[0], value))
+    {
+      value = -value;
+      return true;
+    }
+    return false;
+  }
+  return native_positive_value(t, value);
+}
+
+/// \brief Constructs the positive number with value n, where n > 0.
+inline data_expression native_positive(std::uint64_t n)
+{
+  assert(n > 0);
+  std::size_t bit = 63;
+  while ((n >> bit) == 0)
+  {
+    --bit;
+  }
+
+  data_expression result = sort_pos::c1();
+  while (bit > 0)
+  {
+    --bit;
+    result = sort_pos::cdub(((n >> bit) & 1) != 0 ? sort_bool::true_() : sort_bool::false_(), result);
+  }
+  return result;
+}
+
+/// \brief Constructs the number with value n of sort s.
+/// \returns False if n is not an element of s.
+inline bool native_number(std::int64_t n, native_sort s, data_expression& result)
+{
+  switch (s)
+  {
+    case native_sort::pos:
+      if (n <= 0)
+      {
+        return false;
+      }
+      result = native_positive(n);
+      return true;
+    case native_sort::nat:
+      if (n < 0)
+      {
+        return false;
+      }
+      result = (n == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(native_positive(n))));
+      return true;
+    case native_sort::int_:
+      if (n == std::numeric_limits<std::int64_t>::min())
+      {
+        return false;
+      }
+      if (n < 0)
+      {
+        result = sort_int::cneg(native_positive(-n));
+      }
+      else
+      {
+        result = sort_int::cint(n == 0 ? data_expression(sort_nat::c0()) : data_expression(sort_nat::cnat(native_positive(n))));
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+/// \brief Computes x + y, or returns false on overflow.
+inline bool native_add(std::int64_t x, std::int64_t y, std::int64_t& result)
+{
+  if ((y > 0 && x > std::numeric_limits<std::int64_t>::max() - y) ||
+      (y < 0 && x < std::numeric_limits<std::int64_t>::min() - y))
+  {
+    return false;
+  }
+  result = x + y;
+  return true;
+}
+
+/// \brief Computes x - y, or returns false on overflow.
+inline bool native_subtract(std::int64_t x, std::int64_t y, std::int64_t& result)
+{
+  if ((y < 0 && x > std::numeric_limits<std::int64_t>::max() + y) ||
+      (y > 0 && x < std::numeric_limits<std::int64_t>::min() + y))
+  {
+    return false;
+  }
+  result = x - y;
+  return true;
+}
+
+/// \brief Computes x * y, or returns false on overflow.
+inline bool native_multiply(std::int64_t x, std::int64_t y, std::int64_t& result)
+{
+  const std::int64_t max = std::numeric_limits<std::int64_t>::max();
+  const std::int64_t min = std::numeric_limits<std::int64_t>::min();
+  if (x > 0)
+  {
+    if ((y > 0 && x > max / y) || (y < 0 && y < min / x))
+    {
+      return false;
+    }
+  }
+  else if (x < 0)
+  {
+    if ((y > 0 && x < min / y) || (y < 0 && y < max / x))
+    {
+      return false;
+    }
+  }
+  result = x * y;
+  return true;
+}
+
+/// \brief Evaluates a unary native operation on the number x.
+/// \returns False if x is not a number or the result cannot be computed on machine words.
+inline bool evaluate_native_operation(native_operation op,
+                                      native_sort s,
+                                      const data_expression& x,
+                                      data_expression& result)
+{
+  std::int64_t n;
+  if (!native_value(x, n))
+  {
+    return false;
+  }
+
+  switch (op)
+  {
+    case native_operation::negate:
+      n = -n; // Cannot overflow, as n is larger than the minimal value.
+      break;
+    case native_operation::abs:
+      n = (n < 0 ? -n : n);
+      break;
+    case native_operation::succ:
+      if (!native_add(n, 1, n))
+      {
+        return false;
+      }
+      break;
+    case native_operation::pred:
+      if (!native_subtract(n, 1, n))
+      {
+        return false;
+      }
+      break;
+    case native_operation::convert:
+      break;
+    default:
+      return false;
+  }
+  return native_number(n, s, result);
+}
+
+/// \brief Evaluates a binary native operation on the numbers x and y.
+/// \details The division and modulo are rounded towards minus infinity, such that the remainder is never
+///          negative, as defined by the equations of Int.
+/// \returns False if x or y is not a number or the result cannot be computed on machine words.
+inline bool evaluate_native_operation(native_operation op,
+                                      native_sort s,
+                                      const data_expression& x,
+                                      const data_expression& y,
+                                      data_expression& result)
+{
+  std::int64_t m;
+  std::int64_t n;
+  if (!native_value(x, m) || !native_value(y, n))
+  {
+    return false;
+  }
+
+  std::int64_t r;
+  switch (op)
+  {
+    case native_operation::equal_to:
+      result = (m == n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::not_equal_to:
+      result = (m != n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::less:
+      result = (m < n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::less_equal:
+      result = (m <= n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::greater:
+      result = (m > n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::greater_equal:
+      result = (m >= n ? sort_bool::true_() : sort_bool::false_());
+      return true;
+    case native_operation::plus:
+      if (!native_add(m, n, r))
+      {
+        return false;
+      }
+      break;
+    case native_operation::minus:
+      if (!native_subtract(m, n, r))
+      {
+        return false;
+      }
+      break;
+    case native_operation::times:
+      if (!native_multiply(m, n, r))
+      {
+        return false;
+      }
+      break;
+    case native_operation::div:
+    case native_operation::mod:
+    {
+      if (n <= 0)
+      {
+        return false;
+      }
+      std::int64_t q = m / n;
+      r = m % n;
+      if (r < 0)
+      {
+        r += n;
+        --q;
+      }
+      if (op == native_operation::div)
+      {
+        r = q;
+      }
+      break;
+    }
+    case native_operation::exp:
+    {
+      if (n < 0)
+      {
+        return false;
+      }
+      r = 1;
+      std::int64_t base = m;
+      while (n > 0)
+      {
+        if ((n & 1) != 0 && !native_multiply(r, base, r))
+        {
+          return false;
+        }
+        n >>= 1;
+        if (n > 0 && !native_multiply(base, base, base))
+        {
+          return false;
+        }
+      }
+      break;
+    }
+    case native_operation::maximum:
+      r = (m < n ? n : m);
+      break;
+    case native_operation::minimum:
+      r = (m < n ? m : n);
+      break;
+    default:
+      return false;
+  }
+  return native_number(r, s, result);
+}
+
+/// \brief Evaluates the native operation described by spec on the given arguments.
+inline bool evaluate_native_operation(const native_operation_spec& spec, const data_expression* arguments, data_expression& result)
+{
+  assert(spec.operation != native_operation::none);
+  if (spec.arity == 1)
+  {
+    return evaluate_native_operation(spec.operation, spec.result, arguments[0], result);
+  }
+  return evaluate_native_operation(spec.operation, spec.result, arguments[0], arguments[1], result);
+}
+
+} // namespace detail
+} // namespace data
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_NATIVE_NUMBERS_H
@@ -0,0 +1,224 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite/rewrite_cache.h
+/// \brief A bounded cache that maps ground terms to their normal forms.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_REWRITE_CACHE_H
+#define MCRL2_DATA_DETAIL_REWRITE_REWRITE_CACHE_H
+
+#include <memory>
+#include <vector>
+#include "mcrl2/data/application.h"
+#include "mcrl2/data/function_symbol.h"
+#include "mcrl2/data/variable.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+
+namespace mcrl2
+{
+
+namespace data
+{
+
+namespace detail
+{
+
+// Stores the number of normal forms that rewriters that are created remember, and how they are replaced.
+template <class T> // note, T is only a dummy
+struct rewrite_cache_settings
+{
+  static std::size_t size;
+  static utilities::cache_replacement policy;
+};
+
+template <class T>
+std::size_t rewrite_cache_settings<T>::size = 0;
+
+template <class T>
+utilities::cache_replacement rewrite_cache_settings<T>::policy = utilities::cache_replacement::lru;
+
+/// \brief Sets the number of normal forms that rewriters remember, where zero disables remembering normal forms.
+inline
+void set_rewrite_cache(std::size_t size, utilities::cache_replacement policy)
+{
+  rewrite_cache_settings<bool>::size = size;
+  rewrite_cache_settings<bool>::policy = policy;
+}
+
+inline
+std::size_t get_rewrite_cache_size()
+{
+  return rewrite_cache_settings<bool>::size;
+}
+
+inline
+utilities::cache_replacement get_rewrite_cache_policy()
+{
+  return rewrite_cache_settings<bool>::policy;
+}
+
+/// \brief Remembers the normal forms of a bounded number of ground terms. As terms are maximally shared,
+///        looking up a term only compares addresses.
+/// \details The replacement policy is chosen when the cache is constructed.
+class rewrite_cache
+{
+  protected:
+    struct cache_interface
+    {
+      virtual ~cache_interface() = default;
+      virtual const data_expression* find(const data_expression& t) = 0;
+      virtual void insert(const data_expression& t, const data_expression& normal_form) = 0;
+    };
+
+    template <typename Cache>
+    struct cache_implementation: public cache_interface
+    {
+      Cache m_cache;
+
+      explicit cache_implementation(std::size_t size)
+        : m_cache(size)
+      {}
+
+      const data_expression* find(const data_expression& t) override
+      {
+        auto i = m_cache.find(t);
+        return i == m_cache.end() ? nullptr : &i->second;
+      }
+
+      void insert(const data_expression& t, const data_expression& normal_form) override
+      {
+        m_cache.emplace(t, normal_form);
+      }
+    };
+
+    std::unique_ptr<cache_interface> m_cache;
+
+    // Remembers for applications whether they are ground, such that checking the subterms of a term
+    // whose groundness has been determined takes constant time.
+    utilities::fifo_cache<data_expression, bool> m_ground_terms;
+
+  public:
+    /// \brief Constructs a cache that stores at least size normal forms.
+    rewrite_cache(std::size_t size, utilities::cache_replacement policy)
+      : m_ground_terms(size)
+    {
+      switch (policy)
+      {
+        case utilities::cache_replacement::fifo:
+          m_cache.reset(new cache_implementation<utilities::fifo_cache<data_expression, data_expression> >(size));
+          break;
+        case utilities::cache_replacement::lru:
+          m_cache.reset(new cache_implementation<utilities::lru_cache<data_expression, data_expression> >(size));
+          break;
+        case utilities::cache_replacement::clock:
+          m_cache.reset(new cache_implementation<utilities::clock_cache<data_expression, data_expression> >(size));
+          break;
+        case utilities::cache_replacement::lfu:
+          m_cache.reset(new cache_implementation<utilities::lfu_cache<data_expression, data_expression> >(size));
+          break;
+      }
+    }
+
+    /// \returns A pointer to the normal form of t, or a null pointer if it is not known. The pointer is
+    ///          invalidated by the next insertion.
+    const data_expression* find(const data_expression& t)
+    {
+      return m_cache->find(t);
+    }
+
+    void insert(const data_expression& t, const data_expression& normal_form)
+    {
+      m_cache->insert(t, normal_form);
+    }
+
+    /// \returns True if t contains neither variables nor binders, such that its normal form does not depend
+    ///          on a substitution. The results for the subterms of t are remembered.
+    bool is_ground(const data_expression& t)
+    {
+      if (is_function_symbol(t))
+      {
+        return true;
+      }
+      if (!is_application(t))
+      {
+        return false;
+      }
+
+      auto i = m_ground_terms.find(t);
+      if (i != m_ground_terms.end())
+      {
+        return i->second;
+      }
+
+      const application& ta = atermpp::down_cast<application>(t);
+      bool result = is_ground(ta.head());
+      for (auto j = ta.begin(); result && j != ta.end(); ++j)
+      {
+        result = is_ground(*j);
+      }
+      m_ground_terms.emplace(t, result);
+      return result;
+    }
+
+    /// \brief Applies sigma to t, provided that t contains no binders and sigma maps the variables in t to
+    ///        ground terms.
+    /// \returns False if t cannot be instantiated to a ground term in this way.
+    template <class Substitution>
+    bool instantiate_ground_term(const data_expression& t, Substitution& sigma, data_expression& result)
+    {
+      if (is_function_symbol(t))
+      {
+        result = t;
+        return true;
+      }
+      if (is_variable(t))
+      {
+        result = sigma(atermpp::down_cast<variable>(t));
+        return is_ground(result);
+      }
+      if (is_application(t))
+      {
+        const application& ta = atermpp::down_cast<application>(t);
+        data_expression head;
+        if (!instantiate_ground_term(ta.head(), sigma, head))
+        {
+          return false;
+        }
+        std::vector<data_expression> arguments(ta.size());
+        for (std::size_t i = 0; i < ta.size(); ++i)
+        {
+          if (!instantiate_ground_term(ta[i], sigma, arguments[i]))
+          {
+            return false;
+          }
+        }
+        result = application(head, arguments.begin(), arguments.end());
+        return true;
+      }
+      return false;
+    }
+};
+
+/// \returns A cache with the globally configured size and policy, or a null pointer if caching is disabled.
+inline
+std::unique_ptr<rewrite_cache> make_rewrite_cache()
+{
+  if (get_rewrite_cache_size() == 0)
+  {
+    return std::unique_ptr<rewrite_cache>();
+  }
+  return std::unique_ptr<rewrite_cache>(new rewrite_cache(get_rewrite_cache_size(), get_rewrite_cache_policy()));
+}
+
+} // namespace detail
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_REWRITE_CACHE_H
@@ -0,0 +1,208 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/data/detail/rewrite_profile.h
+/// \brief Counters and timers that record per function symbol and per equation how the rewriter spends its time.
+
+#ifndef MCRL2_DATA_DETAIL_REWRITE_PROFILE_H
+#define MCRL2_DATA_DETAIL_REWRITE_PROFILE_H
+
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <vector>
+#include "mcrl2/data/data_equation.h"
+
+namespace mcrl2
+{
+
+namespace data
+{
+
+namespace detail
+{
+
+// Stores whether rewriters that are created keep a profile.
+template <class T> // note, T is only a dummy
+struct rewrite_profiling
+{
+  static bool enabled;
+};
+
+template <class T>
+bool rewrite_profiling<T>::enabled = false;
+
+inline
+void set_rewrite_profiling(bool enabled)
+{
+  rewrite_profiling<bool>::enabled = enabled;
+}
+
+inline
+bool rewrite_profiling_enabled()
+{
+  return rewrite_profiling<bool>::enabled;
+}
+
+/// \brief The profile of a single rewriter. For every function symbol it counts how often a term with that
+///        head symbol is rewritten, and the time spent doing so, excluding the time spent in rewriting terms
+///        with other head symbols. For every equation it counts how often it is tried, how often its left
+///        hand side matches and how often it is applied, i.e., its condition holds as well.
+/// \details A profile is not thread safe; every rewriter has its own profile.
+class rewrite_profile
+{
+  public:
+    typedef std::chrono::steady_clock clock;
+
+    struct function_symbol_statistics
+    {
+      function_symbol symbol;
+      std::size_t calls = 0;
+      clock::duration time = clock::duration::zero();
+    };
+
+    struct equation_statistics
+    {
+      data_equation equation;
+      std::size_t tried = 0;
+      std::size_t matched = 0;
+      std::size_t applied = 0;
+    };
+
+    /// \brief Measures the time of rewriting a term with the given head symbol, from its construction until
+    ///        its destruction. Does nothing if the profile is a null pointer.
+    class timer
+    {
+      protected:
+        rewrite_profile* m_profile;
+        std::size_t m_index;
+        clock::time_point m_start;
+        clock::duration m_enclosing_children_time;
+
+      public:
+        timer(rewrite_profile* profile, std::size_t function_symbol_index)
+          : m_profile(profile),
+            m_index(function_symbol_index)
+        {
+          if (m_profile != nullptr)
+          {
+            m_enclosing_children_time = m_profile->m_children_time;
+            m_profile->m_children_time = clock::duration::zero();
+            m_start = clock::now();
+          }
+        }
+
+        timer(rewrite_profile* profile, std::size_t function_symbol_index, const function_symbol& f)
+          : timer(profile, function_symbol_index)
+        {
+          if (m_profile != nullptr)
+          {
+            m_profile->register_function_symbol(function_symbol_index, f);
+          }
+        }
+
+        timer(const timer&) = delete;
+        timer& operator=(const timer&) = delete;
+
+        ~timer()
+        {
+          if (m_profile != nullptr)
+          {
+            const clock::duration elapsed = clock::now() - m_start;
+            function_symbol_statistics& statistics = m_profile->m_function_symbols[m_index];
+            statistics.calls++;
+            statistics.time += elapsed - m_profile->m_children_time;
+            m_profile->m_children_time = m_enclosing_children_time + elapsed;
+          }
+        }
+    };
+
+  protected:
+    std::vector<function_symbol_statistics> m_function_symbols; // Indexed by the index of the function symbol.
+    std::vector<equation_statistics> m_equations;
+    std::map<data_equation, std::size_t> m_equation_indices;
+
+    // The time spent in rewriting subterms with another head symbol, for the innermost running timer.
+    clock::duration m_children_time = clock::duration::zero();
+
+  public:
+    /// \brief Makes sure that statistics are kept for the function symbol f with the given index.
+    void register_function_symbol(std::size_t index, const function_symbol& f)
+    {
+      if (index >= m_function_symbols.size())
+      {
+        m_function_symbols.resize(index + 1);
+      }
+      if (m_function_symbols[index].symbol != f)
+      {
+        m_function_symbols[index].symbol = f;
+      }
+    }
+
+    /// \returns The index under which the statistics of the equation are kept.
+    std::size_t equation_index(const data_equation& equation)
+    {
+      auto i = m_equation_indices.find(equation);
+      if (i != m_equation_indices.end())
+      {
+        return i->second;
+      }
+      m_equations.emplace_back();
+      m_equations.back().equation = equation;
+      m_equation_indices[equation] = m_equations.size() - 1;
+      return m_equations.size() - 1;
+    }
+
+    equation_statistics& equation(std::size_t index)
+    {
+      return m_equations[index];
+    }
+
+    /// \brief Sets all statistics to zero, but keeps the indices of the function symbols and equations.
+    void reset_statistics()
+    {
+      for (function_symbol_statistics& f: m_function_symbols)
+      {
+        f.calls = 0;
+        f.time = clock::duration::zero();
+      }
+      for (equation_statistics& e: m_equations)
+      {
+        e.tried = 0;
+        e.matched = 0;
+        e.applied = 0;
+      }
+      m_children_time = clock::duration::zero();
+    }
+
+    /// \returns True if nothing has been recorded.
+    bool empty() const
+    {
+      for (const function_symbol_statistics& f: m_function_symbols)
+      {
+        if (f.calls > 0)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    /// \brief Prints the statistics of all function symbols and equations that have been used, in order of
+    ///        decreasing time and decreasing number of tries.
+    /// \param equations_are_profiled Indicates whether the rewriter keeps statistics of the equations.
+    void report(std::ostream& out, bool equations_are_profiled) const;
+};
+
+} // namespace detail
+
+} // namespace data
+
+} // namespace mcrl2
+
+#endif // MCRL2_DATA_DETAIL_REWRITE_PROFILE_H
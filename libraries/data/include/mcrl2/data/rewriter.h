@@ -106,6 +106,12 @@ class rewriter: public basic_rewriter<data_expression>
     mutable std::size_t rewrite_calls = 0;
 #endif
 
+    /// \brief Constructor.
+    /// \param[in] r A rewriter
+    explicit rewriter(const std::shared_ptr<detail::Rewriter>& r) :
+      basic_rewriter<data_expression>(r)
+    {}
+
   public:
     typedef basic_rewriter<data_expression>::substitution_type substitution_type;
 
@@ -130,6 +136,14 @@ class rewriter: public basic_rewriter<data_expression>
     {
     }
 
+    /// \brief Returns a rewriter with the same rewrite rules that can be used independently of this one,
+    /// for instance in another thread. A copy of a rewriter shares its internal state, such as the
+    /// compiled rewrite rules and the remembered normal forms, with the original.
+    rewriter clone() const
+    {
+      return rewriter(m_rewriter->clone());
+    }
+
     /// \brief Rewrites a data expression.
     /// \param[in] d A data expression
     /// \return The normal form of d.
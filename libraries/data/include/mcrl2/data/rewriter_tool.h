@@ -13,6 +13,8 @@
 #define MCRL2_DATA_REWRITER_TOOL_H
 
 #include "mcrl2/data/detail/enumerator_iteration_limit.h"
+#include "mcrl2/data/detail/rewrite_profile.h"
+#include "mcrl2/data/detail/rewrite/rewrite_cache.h"
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/utilities/command_line_interface.h"
@@ -59,6 +61,33 @@ class rewriter_tool: public Tool
         ,'r'
       );
 
+      desc.add_option(
+        "rewriter-profile",
+        "print for every function symbol how often terms with this head symbol are rewritten and how much time "
+        "this takes, and for every equation how often it is tried, matches and is applied. The profile is printed "
+        "when the rewriter is destroyed. The compiling rewriter does not profile equations."
+      );
+
+      desc.add_option(
+        "rewriter-cache",
+        utilities::make_mandatory_argument("NUM"),
+        "remember the normal forms of at least NUM ground terms, such that they are not rewritten again. "
+        "The compiling rewriter only remembers the normal forms of the terms it is asked to rewrite. "
+        "(Default NUM=0, which does not remember normal forms)."
+      );
+
+      utilities::interface_description::enum_argument<utilities::cache_replacement> policy_option("NAME");
+      policy_option.add_value(utilities::cache_replacement::fifo);
+      policy_option.add_value(utilities::cache_replacement::lru, true);
+      policy_option.add_value(utilities::cache_replacement::clock);
+      policy_option.add_value(utilities::cache_replacement::lfu);
+
+      desc.add_option(
+        "rewriter-cache-policy",
+        policy_option,
+        "when the normal forms of NUM terms are remembered, use policy NAME to decide which one is forgotten:"
+      );
+
       desc.add_option(
         "qlimit", 
         utilities::make_mandatory_argument("NUM"),
@@ -83,6 +112,10 @@ class rewriter_tool: public Tool
     {
       Tool::parse_options(parser);
       m_rewrite_strategy = parser.option_argument_as< data::rewrite_strategy >("rewriter");
+      data::detail::set_rewrite_profiling(parser.options.count("rewriter-profile") > 0);
+      data::detail::set_rewrite_cache(
+        parser.options.count("rewriter-cache") ? parser.option_argument_as< std::size_t >("rewriter-cache") : 0,
+        parser.option_argument_as< utilities::cache_replacement >("rewriter-cache-policy"));
 
       if(parser.options.count("qlimit"))
       {
@@ -153,24 +153,42 @@ void RewriterJitty::make_jitty_strat_sufficiently_larger(const std::size_t i)
   if (i>=jitty_strat.size())
   {
     jitty_strat.resize(i+1);
+    m_native_operations.resize(i+1);
+    m_profiled_equations.resize(i+1);
   }
 }
 
 void RewriterJitty::rebuild_strategy()
 {
   jitty_strat.clear();
+  m_native_operations.clear();
+  m_profiled_equations.clear();
   for(std::map< function_symbol, data_equation_list >::const_iterator l=jitty_eqns.begin(); l!=jitty_eqns.end(); ++l)
   {
     const std::size_t i=core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(l->first);
     make_jitty_strat_sufficiently_larger(i);
     jitty_strat[i] = create_strategy(reverse(l->second));
+    // Only operations of which the equations are present are evaluated on machine words.
+    m_native_operations[i] = native_operation_of(l->first);
+
+    if (m_profile)
+    {
+      for (const strategy_rule& rule: jitty_strat[i].rules())
+      {
+        if (!rule.is_rewrite_index())
+        {
+          m_profiled_equations[i].push_back(m_profile->equation_index(rule.equation()));
+        }
+      }
+    }
   }
 }
 
 RewriterJitty::RewriterJitty(
            const data_specification& data_spec,
            const mcrl2::data::used_data_equation_selector& equation_selector):
-        Rewriter(data_spec,equation_selector)
+        Rewriter(data_spec,equation_selector),
+        m_rewrite_cache(make_rewrite_cache())
 {
   for (const data_equation& eq: data_spec.equations())
   {
@@ -202,8 +220,24 @@ RewriterJitty::RewriterJitty(
   rebuild_strategy();
 }
 
+RewriterJitty::RewriterJitty(const RewriterJitty& other):
+        Rewriter(other),
+        jitty_eqns(other.jitty_eqns),
+        jitty_strat(other.jitty_strat),
+        m_native_operations(other.m_native_operations),
+        m_profiled_equations(other.m_profiled_equations),
+        m_rewrite_cache(other.m_rewrite_cache ? make_rewrite_cache() : nullptr)
+{
+}
+
+std::shared_ptr<Rewriter> RewriterJitty::clone()
+{
+  return std::shared_ptr<Rewriter>(new RewriterJitty(*this));
+}
+
 RewriterJitty::~RewriterJitty()
 {
+  print_profile(jitty, true);
 }
 
 static data_expression subst_values(
@@ -395,6 +429,10 @@ data_expression RewriterJitty::rewrite_aux(
   
     if (is_function_symbol(head) && head!=this_term_is_in_normal_form())
     {
+      if (m_rewrite_cache)
+      {
+        return rewrite_aux_cached_function_symbol(atermpp::down_cast<function_symbol>(head),term,sigma);
+      }
       return rewrite_aux_function_symbol(atermpp::down_cast<function_symbol>(head),term,sigma);
     }
   
@@ -486,11 +524,35 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
 
   const std::size_t op_value=core::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(op);
   make_jitty_strat_sufficiently_larger(op_value);
-  const strategy& strat=jitty_strat[op_value];
+  rewrite_profile::timer profile_timer(m_profile.get(), op_value, op);
+  const native_operation_spec native=m_native_operations[op_value];
+
+  if (native.operation!=native_operation::none && native.arity==arity)
+  {
+    // The arguments of operations on numbers are rewritten first, such that the operation can
+    // be applied directly if they are numbers that fit in a machine word.
+    for (std::size_t i=0; i<arity; ++i)
+    {
+      new (&rewritten[i]) data_expression(rewrite_aux(detail::get_argument_of_higher_order_term(atermpp::down_cast<application>(term),i),sigma));
+      rewritten_defined[i]=true;
+    }
+
+    data_expression result;
+    if (evaluate_native_operation(native,rewritten,result))
+    {
+      for (std::size_t i=0; i<arity; i++)
+      {
+        rewritten[i].~data_expression();
+      }
+      return result;
+    }
+  }
 
+  const strategy& strat=jitty_strat[op_value];
   if (!strat.rules().empty())
   {
     jitty_assignments_for_a_rewrite_rule assignments(MCRL2_SPECIFIC_STACK_ALLOCATOR(jitty_variable_assignment_for_a_rewrite_rule, strat.number_of_variables()));
+    std::size_t equation_position=0;
 
     for (const strategy_rule& rule : strat.rules())
     {
@@ -499,7 +561,7 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
         const std::size_t i = rule.rewrite_index();
         if (i < arity)
         {
-          assert(!rewritten_defined[i]||i==0);
+          assert(!rewritten_defined[i]||i==0||native.operation!=native_operation::none);
           if (!rewritten_defined[i])
           {
             new (&rewritten[i]) data_expression(rewrite_aux(detail::get_argument_of_higher_order_term(atermpp::down_cast<application>(term),i),sigma));
@@ -524,6 +586,12 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
         }
 
         assert(assignments.size==0);
+        rewrite_profile::equation_statistics* statistics=nullptr;
+        if (m_profile)
+        {
+          statistics=&m_profile->equation(m_profiled_equations[op_value][equation_position++]);
+          statistics->tried++;
+        }
 
         bool matches = true;
         for (std::size_t i=0; i<rule_arity; i++)
@@ -539,9 +607,17 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
         }
         if (matches)
         {
+          if (statistics!=nullptr)
+          {
+            statistics->matched++;
+          }
           if (rule1.condition()==sort_bool::true_() || rewrite_aux(
                    subst_values(assignments,rule1.condition(),m_generator),sigma)==sort_bool::true_())
           {
+            if (statistics!=nullptr)
+            {
+              statistics->applied++;
+            }
             const data_expression& rhs=rule1.rhs();
 
             if (arity == rule_arity)
@@ -637,6 +713,36 @@ data_expression RewriterJitty::rewrite_aux_function_symbol(
   return result; 
 }
 
+data_expression RewriterJitty::rewrite_aux_cached_function_symbol(
+                      const function_symbol& op,
+                      const data_expression& term,
+                      substitution_type& sigma)
+{
+  // Terms with a head symbol without equations, such as constructors, are not remembered, as their
+  // normal forms are obtained by rewriting their arguments, which are remembered themselves.
+  const std::size_t op_value=core::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(op);
+  make_jitty_strat_sufficiently_larger(op_value);
+  if (jitty_strat[op_value].rules().empty() && m_native_operations[op_value].operation==native_operation::none)
+  {
+    return rewrite_aux_function_symbol(op,term,sigma);
+  }
+
+  // Only ground terms are stored, so the term is only checked for being ground if it is not found. This
+  // check is done for every subterm on the way down, hence the cache remembers which subterms are ground.
+  const data_expression* normal_form=m_rewrite_cache->find(term);
+  if (normal_form!=nullptr)
+  {
+    return *normal_form;
+  }
+  if (!m_rewrite_cache->is_ground(term))
+  {
+    return rewrite_aux_function_symbol(op,term,sigma);
+  }
+  const data_expression result=rewrite_aux_function_symbol(op,term,sigma);
+  m_rewrite_cache->insert(term,result);
+  return result;
+}
+
 data_expression RewriterJitty::rewrite_aux_const_function_symbol(
                       const function_symbol& op,
                       substitution_type& sigma)
@@ -646,7 +752,9 @@ data_expression RewriterJitty::rewrite_aux_const_function_symbol(
 
   const std::size_t op_value=core::index_traits<data::function_symbol,function_symbol_key_type, 2>::index(op);
   make_jitty_strat_sufficiently_larger(op_value);
+  rewrite_profile::timer profile_timer(m_profile.get(), op_value, op);
   const strategy& strat=jitty_strat[op_value];
+  std::size_t equation_position=0;
 
   for (const strategy_rule& rule : strat.rules())
   {
@@ -665,8 +773,20 @@ data_expression RewriterJitty::rewrite_aux_const_function_symbol(
         break;
       }
 
+      rewrite_profile::equation_statistics* statistics=nullptr;
+      if (m_profile)
+      {
+        statistics=&m_profile->equation(m_profiled_equations[op_value][equation_position++]);
+        statistics->tried++;
+        statistics->matched++;
+      }
+
       if (rule1.condition()==sort_bool::true_() || rewrite_aux(rule1.condition(),sigma)==sort_bool::true_())
       {
+        if (statistics!=nullptr)
+        {
+          statistics->applied++;
+        }
         return rewrite_aux(rule1.rhs(),sigma);
       }
     }
@@ -14,6 +14,8 @@
 
 #define NAME "rewr_jittyc"
 
+#include <algorithm>
+#include <cctype>
 #include <utility>
 #include <string>
 #include <sstream>
@@ -26,6 +28,9 @@
 #include <cassert>
 #include <sstream>
 #include <fstream>
+#include <filesystem>
+#include <iomanip>
+#include <thread>
 #include <sys/stat.h>
 #include "mcrl2/utilities/detail/memory_utility.h"
 #include "mcrl2/utilities/basename.h"
@@ -36,6 +41,7 @@
 #include "mcrl2/core/detail/function_symbols.h"
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/detail/rewrite/jitty_jittyc.h"
+#include "mcrl2/data/detail/rewrite/native_numbers.h"
 #include "mcrl2/data/replace.h"
 #include "mcrl2/data/traverser.h"
 #include "mcrl2/data/substitutions/mutable_map_substitution.h"
@@ -968,6 +974,17 @@ class rewr_function_spec
     }
 };
 
+///
+/// \brief The entry points of a rewrite function are the non template functions through which
+///        it is called from the lookup tables.
+///
+struct entry_point
+{
+  rewr_function_spec spec;
+  std::string code;
+  std::size_t size; // The size of the code of the rewrite function, as an estimate of its compile time.
+};
+
 class RewriterCompilingJitty::ImplementTree
 {
   private:
@@ -996,6 +1013,7 @@ class RewriterCompilingJitty::ImplementTree
   RewriterCompilingJitty& m_rewriter;
   std::stack<rewr_function_spec> m_rewr_functions;
   std::set<rewr_function_spec> m_rewr_functions_implemented;
+  std::vector<entry_point> m_entry_points;
   std::set<std::size_t>m_delayed_application_functions; // Recalls the arities of the required functions 'delayed_application';
   std::vector<bool> m_used;
   std::vector<int> m_stack;
@@ -1779,7 +1797,7 @@ class RewriterCompilingJitty::ImplementTree
              std::stack<std::string>& auxiliary_code_fragments)
   {
     bool reset_current_data_parameters=false;
-    const void* func = (void*)(atermpp::detail::address(tree.function()));
+    const std::string func = "uint_address(" + m_rewriter.m_nf_cache.reference(tree.function()) + ")";
     m_stream << m_padding;
     brackets.bracket_nesting_level++;
     if (level == 0)
@@ -2005,6 +2023,11 @@ public:
     return m_rewr_functions_implemented;
   }
 
+  const std::vector<entry_point>& entry_points()
+  {
+    return m_entry_points;
+  }
+
   ///
   /// \brief implement_tree
   /// \param tree
@@ -2050,6 +2073,23 @@ public:
     }
   }
 
+  /// \brief Generates code that rewrites argument arg to normal form, and administrates that it is.
+  void rewrite_argument(std::ostream& m_stream, std::size_t arg, bracket_level_data& brackets, bool& added_new_parameters_in_brackets)
+  {
+    m_stream << m_padding << "const data_expression& arg" << arg << " = local_rewrite(arg_not_nf" << arg << ",this_rewriter);\n";
+    m_used[arg] = true;
+    if (!added_new_parameters_in_brackets)
+    {
+      added_new_parameters_in_brackets=true;
+      brackets.current_data_parameters.push(brackets.current_data_parameters.top()); 
+      brackets.current_data_arguments.push(brackets.current_data_arguments.top()); 
+    }
+    const std::string& parameters=brackets.current_data_parameters.top();
+    brackets.current_data_parameters.top()=parameters + (parameters.empty()?"":", ") + "const data_expression& arg" + to_string(arg);
+    const std::string arguments = brackets.current_data_arguments.top();
+    brackets.current_data_arguments.top()=arguments + (arguments.empty()?"":", ") + "arg" + to_string(arg);
+  }
+
   void implement_strategy(
              std::ostream& m_stream, 
              match_tree_list strat, 
@@ -2060,6 +2100,32 @@ public:
   {
     bool added_new_parameters_in_brackets=false;
     m_used=nfs_array(arity); // This vector maintains which arguments are in normal form.
+
+    // Operations on numbers are applied directly to their arguments if these are numbers that fit in
+    // a machine word. Otherwise the arguments are already in normal form when the strategy is applied.
+    const native_operation_spec native = native_operation_of(opid);
+    if (native.operation != native_operation::none && native.arity == arity && m_rewriter.jittyc_eqns.count(opid) > 0)
+    {
+      m_stream << m_padding << "// Evaluate " << native_operation_name(native.operation) << " on machine words.\n";
+      for (std::size_t arg = 0; arg < arity; ++arg)
+      {
+        rewrite_argument(m_stream, arg, brackets, added_new_parameters_in_brackets);
+      }
+      m_stream << m_padding << "{\n"
+               << m_padding << "  data_expression result;\n"
+               << m_padding << "  if (evaluate_native_operation(native_operation::" << native_operation_name(native.operation)
+                            << ", native_sort::" << native_sort_name(native.result);
+      for (std::size_t arg = 0; arg < arity; ++arg)
+      {
+        m_stream << ", arg" << arg;
+      }
+      m_stream << ", result))\n"
+               << m_padding << "  {\n"
+               << m_padding << "    return result;\n"
+               << m_padding << "  }\n"
+               << m_padding << "}\n";
+    }
+
     while (!strat.empty())
     {
       m_stream << m_padding << "// " << strat.front() <<  "\n";
@@ -2068,18 +2134,7 @@ public:
         std::size_t arg = match_tree_A(strat.front()).variable_index();
         if (!m_used[arg])
         {
-          m_stream << m_padding << "const data_expression& arg" << arg << " = local_rewrite(arg_not_nf" << arg << ",this_rewriter);\n";
-          m_used[arg] = true;
-          if (!added_new_parameters_in_brackets)
-          {
-            added_new_parameters_in_brackets=true;
-            brackets.current_data_parameters.push(brackets.current_data_parameters.top()); 
-            brackets.current_data_arguments.push(brackets.current_data_arguments.top()); 
-          }
-          const std::string& parameters=brackets.current_data_parameters.top();
-          brackets.current_data_parameters.top()=parameters + (parameters.empty()?"":", ") + "const data_expression& arg" + to_string(arg);
-          const std::string arguments = brackets.current_data_arguments.top();
-          brackets.current_data_arguments.top()=arguments + (arguments.empty()?"":", ") + "arg" + to_string(arg);
+          rewrite_argument(m_stream, arg, brackets, added_new_parameters_in_brackets);
         }
         m_stream << m_padding << "// Considering argument " << arg << "\n";
       }
@@ -2245,10 +2300,8 @@ public:
     }
     else
     {
-      stringstream ss;
-      ss << "atermpp::down_cast<data_expression>(atermpp::aterm(reinterpret_cast<atermpp::detail::_aterm*>(" << (void*)atermpp::detail::address(opid) << ")))";
       std::size_t used_arguments = 0;
-      m_stream << rewr_function_finish_term(arity, ss.str(), down_cast<function_sort>(opid.sort()), used_arguments) << ";\n";
+      m_stream << rewr_function_finish_term(arity, m_rewriter.m_nf_cache.reference(opid), down_cast<function_sort>(opid.sort()), used_arguments) << ";\n";
       assert(used_arguments == arity);
     } 
   }
@@ -2298,46 +2351,60 @@ public:
     std::stack<std::string> auxiliary_code_fragments;
 
     std::size_t index = core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(func);
+    const std::streampos start = m_stream.tellp();
     m_stream << m_padding << "// [" << index << "] " << func << ": " << func.sort() << "\n";
     rewr_function_signature(m_stream, index, arity, brackets);
     m_stream << "\n" << m_padding << "{\n";
     m_padding.indent();
+    if (m_rewriter.profile() != nullptr)
+    {
+      m_rewriter.profile()->register_function_symbol(index, func);
+      m_stream << m_padding << "rewrite_profile::timer profile_timer(this_rewriter->profile(), " << index << ");\n";
+    }
     implement_strategy(m_stream, strategy, arity, func, brackets, auxiliary_code_fragments);
     m_padding.unindent();
     m_stream << m_padding << "}\n\n";
 
-    m_stream << m_padding <<
+    while (!auxiliary_code_fragments.empty())
+    {
+      m_stream << auxiliary_code_fragments.top();
+      auxiliary_code_fragments.pop();
+    }
+    m_stream << "\n";
+
+    // The non template functions through which the rewrite function is called from the lookup
+    // tables are kept apart, as they determine in which translation unit the rewrite function
+    // is instantiated.
+    std::ostringstream entry_points;
+    entry_points << m_padding <<
                   "static inline data_expression rewr_" << index << "_" << arity << "_term"
                   "(const application&" << (arity == 0 ? "" : " t") << ", RewriterCompilingJitty* this_rewriter) "
                   "{ return rewr_" << index << "_" << arity << "(";
     for(std::size_t i = 0; i < arity; ++i)
     {
       assert(is_function_sort(func.sort()));
-      m_stream << (i == 0 ? "" : ", ");
-      m_stream << "term_not_in_normal_form(";
-      get_recursive_argument(m_stream, down_cast<function_sort>(func.sort()), i, "t", arity);
-      m_stream << ", this_rewriter)";
+      entry_points << (i == 0 ? "" : ", ");
+      entry_points << "term_not_in_normal_form(";
+      get_recursive_argument(entry_points, down_cast<function_sort>(func.sort()), i, "t", arity);
+      entry_points << ", this_rewriter)";
     }
-    m_stream << (arity==0?"":", ") << "this_rewriter); }\n\n";
+    entry_points << (arity==0?"":", ") << "this_rewriter); }\n\n";
 
-    m_stream << m_padding <<
+    entry_points << m_padding <<
                   "static inline data_expression rewr_" << index << "_" << arity << "_term_arg_in_normal_form"
                   "(const application&" << (arity == 0 ? "" : " t") << ", RewriterCompilingJitty* this_rewriter) "
                   "{ return rewr_" << index << "_" << arity << "(";
     for(std::size_t i = 0; i < arity; ++i)
     {
       assert(is_function_sort(func.sort()));
-      m_stream << (i == 0 ? "" : ", ");
-      get_recursive_argument(m_stream, down_cast<function_sort>(func.sort()), i, "t", arity);
+      entry_points << (i == 0 ? "" : ", ");
+      get_recursive_argument(entry_points, down_cast<function_sort>(func.sort()), i, "t", arity);
     }
-    m_stream << (arity==0?"":", ") << "this_rewriter); }\n\n";
+    entry_points << (arity==0?"":", ") << "this_rewriter); }\n\n";
 
-    while (!auxiliary_code_fragments.empty())
-    {
-      m_stream << auxiliary_code_fragments.top();
-      auxiliary_code_fragments.pop();
-    }
-    m_stream << "\n";
+    m_entry_points.push_back(entry_point{ rewr_function_spec(func, arity, false),
+                                          entry_points.str(),
+                                          static_cast<std::size_t>(m_stream.tellp() - start) });
   }
 
   void generate_delayed_normal_form_generating_function(std::ostream& m_stream, const data::function_symbol& func, std::size_t arity)
@@ -2453,6 +2520,157 @@ static std::string generate_cpp_filename(std::size_t unique)
   return filename.str();
 }
 
+///
+/// \brief number_of_translation_units determines over how many translation units the generated
+///        rewriter is divided, such that these can be compiled concurrently.
+/// \details The number can be set using the environment variable MCRL2_JITTYC_SHARDS. By default
+///          one translation unit per hardware thread is used, but only when there is enough code
+///          to compensate for compiling the preamble in every translation unit.
+/// \param code_size The size of the code of all rewrite functions.
+/// \param number_of_entry_points The number of rewrite functions that can be distributed.
+///
+static std::size_t number_of_translation_units(std::size_t code_size, std::size_t number_of_entry_points)
+{
+  // The amount of rewrite code that takes roughly as long to compile as the preamble.
+  const std::size_t minimal_code_size = 512 * 1024;
+
+  std::size_t result;
+  const char* env_shards = std::getenv("MCRL2_JITTYC_SHARDS");
+  if (env_shards != nullptr)
+  {
+    char* end;
+    result = std::strtoul(env_shards, &end, 10);
+    if (*env_shards == '\0' || *end != '\0' || result == 0)
+    {
+      throw mcrl2::runtime_error("MCRL2_JITTYC_SHARDS should be a positive number, but it is " + std::string(env_shards) + ".");
+    }
+  }
+  else
+  {
+    result = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), 1 + code_size / minimal_code_size);
+  }
+  return std::max<std::size_t>(1, std::min(result, number_of_entry_points));
+}
+
+///
+/// \brief translation_unit_optimisation_levels returns the optimisation levels with which the
+///        translation units are compiled, as given by the environment variable
+///        MCRL2_JITTYC_OPTIMISATION as a comma separated list, e.g. 3,3,1. The last level is used
+///        for all remaining translation units.
+/// \return The optimisation levels, or an empty vector if the compile script decides.
+///
+static std::vector<std::string> translation_unit_optimisation_levels()
+{
+  std::vector<std::string> result;
+  const char* env_levels = std::getenv("MCRL2_JITTYC_OPTIMISATION");
+  if (env_levels == nullptr || *env_levels == '\0')
+  {
+    return result;
+  }
+
+  std::istringstream levels(env_levels);
+  std::string level;
+  while (std::getline(levels, level, ','))
+  {
+    if (level.empty() || !std::all_of(level.begin(), level.end(), [](char c) { return std::isalnum(static_cast<unsigned char>(c)); }))
+    {
+      throw mcrl2::runtime_error("MCRL2_JITTYC_OPTIMISATION should be a comma separated list of optimisation levels, but it is " + std::string(env_levels) + ".");
+    }
+    result.push_back(level);
+  }
+  return result;
+}
+
+///
+/// \brief jittyc_cache_directory returns the directory in which compiled rewriters are
+///        stored, such that later runs on the same specification do not have to compile
+///        them again.
+/// \details Caching is disabled by default, because the cache is never cleaned up. It is
+///          enabled by setting the environment variable MCRL2_JITTYC_CACHE_DIR to the directory
+///          that must be used.
+/// \return The cache directory, or the empty string if compiled rewriters are not cached.
+///
+static std::string jittyc_cache_directory()
+{
+  const char* env_dir = std::getenv("MCRL2_JITTYC_CACHE_DIR");
+  if (env_dir != nullptr)
+  {
+    return env_dir;
+  }
+  return "";
+}
+
+static std::string read_file(const std::string& filename)
+{
+  std::ifstream file(filename, std::ios::in | std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+///
+/// \brief jittyc_cache_key computes the name under which a compiled rewriter is cached.
+/// \details The name is a hash of the generated code, the toolset version, and the compile
+///          script, which determines the compiler and its flags.
+///
+static std::string jittyc_cache_key(const std::string& code, const std::string& compile_script)
+{
+  // The 64 bit FNV-1a hash, where every part is terminated by a byte that does not occur in text.
+  std::uint64_t hash = 14695981039346656037ULL;
+  auto add = [&hash](const std::string& part)
+  {
+    for (unsigned char c: part)
+    {
+      hash = (hash ^ c) * 1099511628211ULL;
+    }
+    hash = (hash ^ 0xff) * 1099511628211ULL;
+  };
+
+  const char* cxx = std::getenv("CXX");
+  add(code);
+  add(mcrl2::utilities::get_toolset_version());
+  add(compile_script);
+  add(read_file(compile_script));
+  add(cxx == nullptr ? "" : cxx);
+
+  std::ostringstream key;
+  key << "jittyc_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return key.str();
+}
+
+///
+/// \brief store_in_jittyc_cache copies the compiled rewriter and the code it was compiled
+///        from to the cache. Files are renamed into place, so that concurrent runs never
+///        observe partially written files. Failures only result in a warning.
+/// \param library The compiled rewriter.
+/// \param code The generated code.
+/// \param cache_file The name of the cached files without extension.
+///
+static void store_in_jittyc_cache(const std::string& library, const std::string& code, const std::string& cache_file)
+{
+  const std::string suffix = "." + std::to_string(getpid()) + ".tmp";
+  try
+  {
+    std::filesystem::create_directories(std::filesystem::path(cache_file).parent_path());
+    std::filesystem::copy_file(library, cache_file + ".bin" + suffix, std::filesystem::copy_options::overwrite_existing);
+    std::filesystem::rename(cache_file + ".bin" + suffix, cache_file + ".bin");
+
+    std::ofstream code_file(cache_file + ".cpp" + suffix, std::ios::out | std::ios::binary);
+    code_file << code;
+    code_file.close();
+    if (!code_file)
+    {
+      throw std::runtime_error("could not write " + cache_file + ".cpp" + suffix);
+    }
+    std::filesystem::rename(cache_file + ".cpp" + suffix, cache_file + ".cpp");
+    mCRL2log(verbose) << "stored the compiled rewriter in " << cache_file << ".bin" << std::endl;
+  }
+  catch (std::exception& e)
+  {
+    mCRL2log(warning) << "Could not store the compiled rewriter in the cache: " << e.what() << std::endl;
+  }
+}
+
 ///
 /// \brief filter_function_symbols selects the function symbols from source for which filter
 ///        returns true, and copies them to dest.
@@ -2504,9 +2722,8 @@ static void generate_make_appl_functions(std::ostream& s, std::size_t max_arity)
   }
 }
 
-void RewriterCompilingJitty::generate_code(const std::string& filename)
+std::vector<std::string> RewriterCompilingJitty::generate_code(const std::string& filename)
 {
-  std::ofstream cpp_file(filename);
   std::stringstream rewr_code;
   // arity_bound is one larger than the maximal arity. 
   arity_bound = 1+std::max(calc_max_arity(m_data_specification_for_enumeration.constructors()),
@@ -2529,66 +2746,130 @@ void RewriterCompilingJitty::generate_code(const std::string& filename)
   functions_when_arguments_are_not_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
   functions_when_arguments_are_in_normal_form = std::vector<rewriter_function>(arity_bound * index_bound);
 
-  cpp_file << "#define INDEX_BOUND__ " << index_bound << "// These values are not used anymore.\n"
-              "#define ARITY_BOUND__ " << arity_bound << "// These values are not used anymore.\n";
-  cpp_file << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
-
-  cpp_file << "namespace {\n"
-               "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
-               "// rewrite code.\n"
-               "\n"
-               "struct rewr_functions\n"
-               "{\n"
-
-               "  // A rewrite_term is a term that may or may not be in normal form. If the method\n"
-               "  // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible.\n"
-               "  template <class REWRITE_TERM>\n"
-               "  static data_expression local_rewrite(const REWRITE_TERM& t, RewriterCompilingJitty* this_rewriter)\n"
-               "  {\n"
-               "    return t.normal_form();\n"
-               "  }\n"
-               "\n"
-               "  static const data_expression& local_rewrite(const data_expression& t, RewriterCompilingJitty* )\n"
-               "  {\n"
-               "    return t;\n"
-               "  }\n"
-               "\n";
+  // The code below is shared by all translation units. The rewrite functions are templates,
+  // so every translation unit only instantiates the functions reachable from its entry points.
+  std::stringstream common_code;
+  common_code << "#include \"mcrl2/data/detail/rewrite/jittycpreamble.h\"\n";
+  common_code << "// The terms used by the rewrite functions, see normal_form_cache.\n"
+                 "static const data_expression* jittyc_terms;\n";
+
+  common_code << "namespace {\n"
+                 "// Anonymous namespace so the compiler uses internal linkage for the generated\n"
+                 "// rewrite code.\n"
+                 "\n"
+                 "struct rewr_functions\n"
+                 "{\n"
+
+                 "  // A rewrite_term is a term that may or may not be in normal form. If the method\n"
+                 "  // normal_form is invoked, it will calculate a normal form for itself as efficiently as possible.\n"
+                 "  template <class REWRITE_TERM>\n"
+                 "  static data_expression local_rewrite(const REWRITE_TERM& t, RewriterCompilingJitty* this_rewriter)\n"
+                 "  {\n"
+                 "    return t.normal_form();\n"
+                 "  }\n"
+                 "\n"
+                 "  static const data_expression& local_rewrite(const data_expression& t, RewriterCompilingJitty* )\n"
+                 "  {\n"
+                 "    return t;\n"
+                 "  }\n"
+                 "\n";
 
   rewr_code << "  // We're declaring static members in a struct rather than simple functions in\n"
                "  // the global scope, so that we don't have to worry about forward declarations.\n";
   code_generator.generate_rewr_functions(rewr_code);
-  rewr_code << "};\n"
-               "} // namespace\n";
 
-  generate_make_appl_functions(cpp_file, arity_bound);
-  code_generator.generate_delayed_application_functions(cpp_file);
+  generate_make_appl_functions(common_code, arity_bound);
+  code_generator.generate_delayed_application_functions(common_code);
+
+  common_code << rewr_code.str();
 
-  cpp_file << rewr_code.str();
+  // Distribute the entry points over the translation units, largest rewrite function first,
+  // such that all translation units get a similar amount of code to compile.
+  std::vector<const entry_point*> entry_points;
+  std::size_t code_size = 0;
+  for (const entry_point& e: code_generator.entry_points())
+  {
+    entry_points.push_back(&e);
+    code_size += e.size;
+  }
+  std::stable_sort(entry_points.begin(), entry_points.end(),
+                   [](const entry_point* e1, const entry_point* e2) { return e1->size > e2->size; });
 
-  cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n"
-              "{\n";
+  const std::size_t number_of_units = number_of_translation_units(code_size, entry_points.size());
+  std::vector<std::vector<const entry_point*> > units(number_of_units);
+  std::vector<std::size_t> unit_size(number_of_units, 0);
+  for (const entry_point* e: entry_points)
+  {
+    const std::size_t i = std::min_element(unit_size.begin(), unit_size.end()) - unit_size.begin();
+    units[i].push_back(e);
+    unit_size[i] += e->size;
+  }
 
-  // Fill tables with the rewrite functions
-  for (std::set<rewr_function_spec>::const_iterator
-            it = code_generator.implemented_rewrs().begin();
-            it != code_generator.implemented_rewrs().end(); ++it)
+  const std::vector<std::string> optimisation_levels = translation_unit_optimisation_levels();
+  const std::string stem = filename.substr(0, filename.rfind(".cpp"));
+  std::vector<std::string> filenames;
+  for (std::size_t i = 0; i < number_of_units; ++i)
   {
-    if (!it->delayed())
+    filenames.push_back(i == 0 ? filename : stem + "_" + std::to_string(i) + ".cpp");
+    std::ofstream cpp_file(filenames.back());
+
+    // The compile script passes the flags on the first line to the compiler.
+    if (!optimisation_levels.empty())
+    {
+      cpp_file << "// mcrl2compilerewriter-flags: -O" << optimisation_levels[std::min(i, optimisation_levels.size() - 1)] << "\n";
+    }
+    if (i > 0)
+    {
+      cpp_file << "#define MCRL2_JITTYC_SHARD\n";
+    }
+    cpp_file << common_code.str();
+    for (const entry_point* e: units[i])
+    {
+      cpp_file << e->code;
+    }
+    cpp_file << "};\n"
+                "} // namespace\n";
+
+    // Every translation unit fills the tables with its own entry points, and the
+    // first one also calls the functions that do so for the other ones.
+    if (i == 0)
+    {
+      for (std::size_t j = 1; j < number_of_units; ++j)
+      {
+        cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table_" << j << "(RewriterCompilingJitty* this_rewriter);\n";
+      }
+      cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table(RewriterCompilingJitty* this_rewriter)\n";
+    }
+    else
+    {
+      cpp_file << "void set_the_precompiled_rewrite_functions_in_a_lookup_table_" << i << "(RewriterCompilingJitty* this_rewriter)\n";
+    }
+    cpp_file << "{\n"
+                "  jittyc_terms = this_rewriter->precompiled_terms();\n";
+
+    // Fill tables with the rewrite functions
+    for (const entry_point* e: units[i])
     {
       cpp_file << "  this_rewriter->functions_when_arguments_are_not_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
-               << it->name() << "_term;\n";
+               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(e->spec.fs())
+               << " + " << e->spec.arity() << "] = rewr_functions::"
+               << e->spec.name() << "_term;\n";
       cpp_file << "  this_rewriter->functions_when_arguments_are_in_normal_form[this_rewriter->arity_bound * "
-               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(it->fs())
-               << " + " << it->arity() << "] = rewr_functions::"
-               << it->name() << "_term_arg_in_normal_form;\n";
+               << core::index_traits<data::function_symbol, function_symbol_key_type, 2>::index(e->spec.fs())
+               << " + " << e->spec.arity() << "] = rewr_functions::"
+               << e->spec.name() << "_term_arg_in_normal_form;\n";
     }
-  }
 
-
-  cpp_file << "}\n";
-  cpp_file.close();
+    if (i == 0)
+    {
+      for (std::size_t j = 1; j < number_of_units; ++j)
+      {
+        cpp_file << "  set_the_precompiled_rewrite_functions_in_a_lookup_table_" << j << "(this_rewriter);\n";
+      }
+    }
+    cpp_file << "}\n";
+  }
+  return filenames;
 }
 
 void RewriterCompilingJitty::BuildRewriteSystem()
@@ -2631,22 +2912,60 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   }
 
   std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
-
-  mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
-  time.reset();
+  const std::vector<std::string> cpp_files = generate_code(cpp_file);
 
-  try
+  // A rewriter that has been compiled from exactly the same code before can be reused.
+  // The code is compared as a whole, so that a collision of the hashes does no harm.
+  const std::string cache_directory = jittyc_cache_directory();
+  std::string code;
+  std::string cache_file;
+  bool cached = false;
+  m_loaded_from_cache = false;
+  if (!cache_directory.empty())
   {
-    rewriter_so->compile(cpp_file);
+    for (const std::string& file: cpp_files)
+    {
+      code += read_file(file);
+      code += '\0';
+    }
+    cache_file = cache_directory + "/" + jittyc_cache_key(code, compile_script);
+    cached = mcrl2::utilities::file_exists(cache_file + ".bin") && read_file(cache_file + ".cpp") == code;
   }
-  catch(std::runtime_error& e)
+
+  if (cached)
   {
-    rewriter_so->leave_files();
-    throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, using the compiled rewriter "
+                      << cache_file << ".bin" << std::endl;
+    for (const std::string& file: cpp_files)
+    {
+      std::remove(file.c_str());
+    }
+    rewriter_so->use_compiled_library(cache_file + ".bin");
+    m_loaded_from_cache = true;
   }
+  else
+  {
+    mCRL2log(verbose) << "generated " << cpp_file << (cpp_files.size() > 1 ? " and " + std::to_string(cpp_files.size() - 1) + " other translation units" : "")
+                      << " in " << time.time() << "ms, compiling..." << std::endl;
+    time.reset();
+
+    try
+    {
+      rewriter_so->compile(cpp_files);
+    }
+    catch(std::runtime_error& e)
+    {
+      rewriter_so->leave_files();
+      throw mcrl2::runtime_error(std::string("Could not compile rewriter: ") + e.what());
+    }
+
+    mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
 
-  mCRL2log(verbose) << "compiled in " << time.time() << "ms, loading rewriter..." << std::endl;
+    if (!cache_directory.empty())
+    {
+      store_in_jittyc_cache(rewriter_so->library_filename(), code, cache_file);
+    }
+  }
 
   bool (*init)(rewriter_interface*, RewriterCompilingJitty* this_rewriter);
   rewriter_interface interface = { mcrl2::utilities::get_toolset_version(), "Unknown error when loading rewriter.", this, NULL, NULL };
@@ -2691,8 +3010,12 @@ RewriterCompilingJitty::RewriterCompilingJitty(
                           const used_data_equation_selector& equation_selector)
   : Rewriter(data_spec,equation_selector),
     jitty_rewriter(data_spec,equation_selector),
-    m_nf_cache(jitty_rewriter)
+    m_nf_cache(jitty_rewriter),
+    m_rewrite_cache(make_rewrite_cache())
 {
+  // The jitty rewriter only computes normal forms while generating code; it is not part of the profile.
+  jitty_rewriter.disable_profile();
+  jitty_rewriter.disable_rewrite_cache();
   so_rewr_cleanup = NULL;
 
   made_files = false;
@@ -2722,8 +3045,41 @@ RewriterCompilingJitty::RewriterCompilingJitty(
   BuildRewriteSystem();
 }
 
+RewriterCompilingJitty::RewriterCompilingJitty(const RewriterCompilingJitty& other)
+  : Rewriter(other),
+    global_sigma(nullptr),
+    rewriter_binding_variable_lists(other.rewriter_binding_variable_lists),
+    variable_list_indices1(other.variable_list_indices1),
+    rewriter_bound_variables(other.rewriter_bound_variables),
+    variable_indices0(other.variable_indices0),
+    arity_bound(other.arity_bound),
+    index_bound(other.index_bound),
+    functions_when_arguments_are_not_in_normal_form(other.functions_when_arguments_are_not_in_normal_form),
+    functions_when_arguments_are_in_normal_form(other.functions_when_arguments_are_in_normal_form),
+    jitty_rewriter(other.jitty_rewriter),
+    rewrite_rules(other.rewrite_rules),
+    made_files(other.made_files),
+    m_loaded_from_cache(other.m_loaded_from_cache),
+    jittyc_eqns(other.jittyc_eqns),
+    m_extra_symbols(other.m_extra_symbols),
+    rewriter_so(other.rewriter_so),
+    m_nf_cache(jitty_rewriter, other.m_nf_cache),
+    m_rewrite_cache(other.m_rewrite_cache ? make_rewrite_cache() : nullptr),
+    so_rewr_cleanup(NULL), // The library is cleaned up by the rewriter that loaded it.
+    so_rewr(other.so_rewr)
+{
+  // The tables of rewrite functions are copied from other, and the generated code refers to the
+  // terms in the shared normal form cache, so the library does not have to be initialised again.
+}
+
+std::shared_ptr<Rewriter> RewriterCompilingJitty::clone()
+{
+  return std::shared_ptr<Rewriter>(new RewriterCompilingJitty(*this));
+}
+
 RewriterCompilingJitty::~RewriterCompilingJitty()
 {
+  print_profile(jitty_compiling, false);
   CleanupRewriteSystem();
 }
 
@@ -2738,11 +3094,37 @@ data_expression RewriterCompilingJitty::rewrite(
   // substitutions, due to the enumerator.
   substitution_type *saved_sigma=global_sigma;
   global_sigma=&sigma;
+  if (m_rewrite_cache)
+  {
+    const data_expression result=rewrite_cached(term, sigma);
+    global_sigma=saved_sigma;
+    return result;
+  }
   const data_expression& result=so_rewr(term, this);
   global_sigma=saved_sigma;
   return result;
 }
 
+data_expression RewriterCompilingJitty::rewrite_cached(
+     const data_expression& term,
+     substitution_type& sigma)
+{
+  data_expression ground_term;
+  if (!m_rewrite_cache->instantiate_ground_term(term, sigma, ground_term))
+  {
+    return so_rewr(term, this);
+  }
+
+  const data_expression* normal_form=m_rewrite_cache->find(ground_term);
+  if (normal_form!=nullptr)
+  {
+    return *normal_form;
+  }
+  const data_expression result=so_rewr(ground_term, this);
+  m_rewrite_cache->insert(ground_term, result);
+  return result;
+}
+
 rewrite_strategy RewriterCompilingJitty::getStrategy()
 {
   return jitty_compiling;
@@ -13,6 +13,8 @@
 #include <cstring>
 #include <limits>
 #include <algorithm>
+#include <iomanip>
+#include <sstream>
 #include "mcrl2/utilities/logger.h"
 #include "mcrl2/atermpp/algorithm.h"
 #include "mcrl2/core/detail/function_symbols.h"
@@ -464,6 +466,70 @@ data_expression Rewriter::quantifier_enumeration(
 }
 
 
+void rewrite_profile::report(std::ostream& out, bool equations_are_profiled) const
+{
+  std::vector<const function_symbol_statistics*> function_symbols;
+  for (const function_symbol_statistics& f: m_function_symbols)
+  {
+    if (f.calls > 0)
+    {
+      function_symbols.push_back(&f);
+    }
+  }
+  std::stable_sort(function_symbols.begin(), function_symbols.end(),
+                   [](const function_symbol_statistics* f, const function_symbol_statistics* g) { return f->time > g->time; });
+
+  out << "Rewriting per head symbol:\n"
+      << std::setw(14) << "calls" << std::setw(14) << "time (ms)" << "  function symbol\n";
+  for (const function_symbol_statistics* f: function_symbols)
+  {
+    out << std::setw(14) << f->calls
+        << std::setw(14) << std::fixed << std::setprecision(3)
+        << std::chrono::duration<double, std::milli>(f->time).count()
+        << "  " << data::pp(f->symbol) << ": " << data::pp(f->symbol.sort()) << "\n";
+  }
+
+  if (!equations_are_profiled)
+  {
+    out << "The use of equations is not profiled by this rewriter.\n";
+    return;
+  }
+
+  std::vector<const equation_statistics*> equations;
+  for (const equation_statistics& e: m_equations)
+  {
+    if (e.tried > 0)
+    {
+      equations.push_back(&e);
+    }
+  }
+  std::stable_sort(equations.begin(), equations.end(),
+                   [](const equation_statistics* e, const equation_statistics* f) { return e->tried > f->tried; });
+
+  out << "Use of equations:\n"
+      << std::setw(14) << "tried" << std::setw(14) << "matched" << std::setw(14) << "applied" << "  equation\n";
+  for (const equation_statistics* e: equations)
+  {
+    out << std::setw(14) << e->tried << std::setw(14) << e->matched << std::setw(14) << e->applied
+        << "  " << data::pp(e->equation) << "\n";
+  }
+}
+
+void Rewriter::print_profile(rewrite_strategy strategy, bool equations_are_profiled) const
+{
+  if (m_profile && !m_profile->empty())
+  {
+    std::ostringstream out;
+    m_profile->report(out, equations_are_profiled);
+    mCRL2log(log::info) << "Profile of the " << pp(strategy) << " rewriter\n" << out.str() << std::flush;
+  }
+}
+
+std::shared_ptr<Rewriter> Rewriter::clone()
+{
+  return createRewriter(m_data_specification_for_enumeration, data_equation_selector, getStrategy());
+}
+
 std::shared_ptr<Rewriter> createRewriter(
             const data_specification& data_spec,
             const used_data_equation_selector& equations_selector,
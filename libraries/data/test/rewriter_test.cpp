@@ -13,6 +13,7 @@
 #include "mcrl2/data/detail/data_functional.h"
 #include "mcrl2/data/detail/one_point_rule_preprocessor.h"
 #include "mcrl2/data/detail/parse_substitution.h"
+#include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/detail/test_rewriters.h"
 #include "mcrl2/data/find.h"
 #include "mcrl2/data/function_sort.h"
@@ -24,6 +25,8 @@
 #include "mcrl2/data/substitutions/mutable_indexed_substitution.h"
 #include "mcrl2/utilities/text_utility.h"
 #include <boost/test/included/unit_test_framework.hpp>
+#include <cstdlib>
+#include <filesystem>
 #include <iostream>
 #include <memory>
 #include <set>
@@ -266,3 +269,43 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_equality_on_functions();
   test_enumeration_of_functions();
 }
+
+#ifdef MCRL2_TEST_JITTYC
+#ifdef MCRL2_JITTYC_AVAILABLE
+// Checks that a second compilation of the same specification uses the compiled rewriter in the cache.
+BOOST_AUTO_TEST_CASE(test_jittyc_cache)
+{
+  const std::filesystem::path cache_directory = std::filesystem::temp_directory_path() / "mcrl2_jittyc_cache_test";
+  std::filesystem::remove_all(cache_directory);
+  setenv("MCRL2_JITTYC_CACHE_DIR", cache_directory.c_str(), 1);
+
+  data_specification data_spec = parse_data_specification(
+    "sort D = struct d1 | d2;\n"
+    "map  f: D -> D;\n"
+    "eqn  f(d1) = d2;\n"
+    "     f(d2) = d1;\n"
+  );
+  data_expression t = parse_data_expression("f(f(f(d1)))", data_spec);
+  data_expression expected = parse_data_expression("d2", data_spec);
+  data::detail::RewriterCompilingJitty::substitution_type sigma;
+
+  {
+    data::detail::RewriterCompilingJitty R(data_spec, used_data_equation_selector(data_spec));
+    BOOST_CHECK(!R.loaded_from_cache());
+    BOOST_CHECK_EQUAL(R.rewrite(t, sigma), expected);
+  }
+  {
+    data::detail::RewriterCompilingJitty R(data_spec, used_data_equation_selector(data_spec));
+    BOOST_CHECK(R.loaded_from_cache());
+    BOOST_CHECK_EQUAL(R.rewrite(t, sigma), expected);
+  }
+
+  unsetenv("MCRL2_JITTYC_CACHE_DIR");
+  {
+    data::detail::RewriterCompilingJitty R(data_spec, used_data_equation_selector(data_spec));
+    BOOST_CHECK(!R.loaded_from_cache());
+  }
+  std::filesystem::remove_all(cache_directory);
+}
+#endif // MCRL2_JITTYC_AVAILABLE
+#endif // MCRL2_TEST_JITTYC
@@ -13,6 +13,7 @@
 #include "mcrl2/data/bag.h"
 #include "mcrl2/data/data_specification.h"
 #include "mcrl2/data/detail/data_functional.h"
+#include "mcrl2/data/detail/rewrite/rewrite_cache.h"
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/find.h"
 #include "mcrl2/data/function_sort.h"
@@ -28,6 +29,7 @@
 #include "mcrl2/utilities/text_utility.h"
 #include <boost/test/included/unit_test_framework.hpp>
 #include <iostream>
+#include <memory>
 #include <set>
 #include <string>
 
@@ -1511,3 +1513,110 @@ BOOST_AUTO_TEST_CASE(Check_normal_forms_in_function_update)   // In the jitty re
   }
 }
 
+
+BOOST_AUTO_TEST_CASE(Check_machine_word_arithmetic) // Operations on numbers are evaluated on machine words, except
+                                                    // when the numbers do not fit, in which case the equations are used.
+{
+  data_specification specification;
+  specification.add_context_sort(sort_int::int_());
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy32: " << *strat << std::endl;
+    data::rewriter R(specification, *strat);
+
+    data_rewrite_test(R, parse_data_expression("123456789 * 987654321", specification), sort_pos::pos("121932631112635269"));
+    data_rewrite_test(R, parse_data_expression("exp(3, 20)", specification), sort_pos::pos(3486784401));
+    data_rewrite_test(R, parse_data_expression("pred(1)", specification), sort_nat::nat(0));
+    data_rewrite_test(R, parse_data_expression("2 - 5", specification), sort_int::int_(-3));
+    data_rewrite_test(R, parse_data_expression("abs(-17) + max(3, 4)", specification), sort_pos::pos(21));
+    data_rewrite_test(R, parse_data_expression("Int2Nat(12) < Pos2Nat(13)", specification), sort_bool::true_());
+
+    // Results that do not fit in a machine word.
+    data_rewrite_test(R, parse_data_expression("9223372036854775807 + 1", specification), sort_pos::pos("9223372036854775808"));
+    data_rewrite_test(R, parse_data_expression("4611686018427387904 * 4", specification), sort_pos::pos("18446744073709551616"));
+    data_rewrite_test(R, parse_data_expression("exp(2, 64) div 3", specification), sort_nat::nat("6148914691236517205"));
+    data_rewrite_test(R, parse_data_expression("-9223372036854775807 - 2", specification), sort_int::int_("-9223372036854775809"));
+
+    // Division is rounded towards minus infinity and the remainder is never negative.
+    for (int x = -20; x <= 20; ++x)
+    {
+      for (int y = 1; y <= 7; ++y)
+      {
+        const int q = (x >= 0 ? x / y : -((-x + y - 1) / y));
+        const std::string expression = "(" + std::to_string(x) + ") div " + std::to_string(y);
+        data_rewrite_test(R, parse_data_expression(expression, specification), x < 0 ? sort_int::int_(q) : sort_nat::nat(q));
+        data_rewrite_test(R, parse_data_expression("(" + std::to_string(x) + ") mod " + std::to_string(y), specification),
+                          sort_nat::nat(x - q * y));
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Check_rewrite_cache) // Remembering normal forms of ground terms does not change the results,
+                                          // also not when normal forms are forgotten because the cache is full.
+{
+  data_specification specification = parse_data_specification(
+    "map fib: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn fib(0) = 0;\n"
+    "    fib(1) = 1;\n"
+    "    n > 1 -> fib(n) = fib(Int2Nat(n - 1)) + fib(Int2Nat(n - 2));\n");
+
+  const variable n("n", sort_nat::nat());
+  const variable_list variables({ n });
+  const data_expression fib_n = parse_data_expression("fib(n)", variables, specification);
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (const utilities::cache_replacement policy: { utilities::cache_replacement::fifo, utilities::cache_replacement::lru })
+  {
+    data::detail::set_rewrite_cache(8, policy);
+    for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+    {
+      std::cerr << "  Strategy33: " << *strat << " " << policy << std::endl;
+      data::rewriter R(specification, *strat);
+
+      for (std::size_t i = 0; i < 2; ++i)
+      {
+        data_rewrite_test(R, parse_data_expression("fib(20)", specification), sort_nat::nat(6765));
+        data_rewrite_test(R, parse_data_expression("fib(21) + fib(2)", specification), sort_nat::nat(10947));
+      }
+
+      data::rewriter::substitution_type sigma;
+      for (std::size_t i = 0; i < 15; ++i)
+      {
+        sigma[n] = sort_nat::nat(i % 5 + 10);
+        const data_expression result = R(fib_n, sigma);
+        const std::size_t expected[] = { 55, 89, 144, 233, 377 };
+        BOOST_CHECK(result == sort_nat::nat(expected[i % 5]));
+      }
+    }
+  }
+  data::detail::set_rewrite_cache(0, utilities::cache_replacement::lru);
+}
+
+BOOST_AUTO_TEST_CASE(Check_rewriter_clone) // A clone of a rewriter gives the same results, also after the original
+                                           // rewriter is destroyed.
+{
+  data_specification specification = parse_data_specification(
+    "map fib: Nat -> Nat;\n"
+    "var n: Nat;\n"
+    "eqn fib(0) = 0;\n"
+    "    fib(1) = 1;\n"
+    "    n > 1 -> fib(n) = fib(Int2Nat(n - 1)) + fib(Int2Nat(n - 2));\n");
+
+  rewrite_strategy_vector strategies(data::detail::get_test_rewrite_strategies(false));
+  for (rewrite_strategy_vector::const_iterator strat = strategies.begin(); strat != strategies.end(); ++strat)
+  {
+    std::cerr << "  Strategy34: " << *strat << std::endl;
+    std::unique_ptr<data::rewriter> R(new data::rewriter(specification, *strat));
+    data_rewrite_test(*R, parse_data_expression("fib(15)", specification), sort_nat::nat(610));
+
+    data::rewriter clone = R->clone();
+    R.reset();
+    data_rewrite_test(clone, parse_data_expression("fib(15)", specification), sort_nat::nat(610));
+    data_rewrite_test(clone, parse_data_expression("exists m: Nat. m < 3 && fib(m) == 1", specification), sort_bool::true_());
+    data_rewrite_test(clone, parse_data_expression("(lambda m: Nat. fib(m) + m)(10)", specification), sort_nat::nat(65));
+  }
+}
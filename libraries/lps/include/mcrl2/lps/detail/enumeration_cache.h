@@ -0,0 +1,211 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/enumeration_cache.h
+/// \brief A cache for the solutions of summand conditions, used for state space exploration.
+
+#ifndef MCRL2_LPS_DETAIL_ENUMERATION_CACHE_H
+#define MCRL2_LPS_DETAIL_ENUMERATION_CACHE_H
+
+#include <list>
+#include <memory>
+#include <ostream>
+#include "mcrl2/data/data_expression.h"
+#include "mcrl2/utilities/fixed_size_cache.h"
+
+namespace mcrl2
+{
+
+namespace lps
+{
+
+namespace detail
+{
+
+/// \brief Maps the values of the process parameters that occur in a summand condition to the solutions of
+///        the summation variables for which the condition holds.
+/// \details The number of keys that is stored can be bounded, in which case keys are removed according to
+///          a replacement policy. The solutions are shared, such that they remain valid when their key is removed
+///          while they are in use.
+class enumeration_cache
+{
+  public:
+    typedef atermpp::term_appl<data::data_expression> key_type;
+    typedef std::list<data::data_expression_list> solution_list;
+    typedef std::shared_ptr<const solution_list> value_type;
+
+  protected:
+    struct cache_interface
+    {
+      virtual ~cache_interface() = default;
+      virtual value_type find(const key_type& key) = 0;
+      virtual void insert(const key_type& key, const value_type& solutions) = 0;
+      virtual std::size_t size() const = 0;
+      virtual std::size_t evictions() const = 0;
+      virtual cache_interface* clone() const = 0;
+    };
+
+    template <typename Cache>
+    struct cache_implementation: public cache_interface
+    {
+      Cache m_cache;
+
+      explicit cache_implementation(std::size_t size)
+        : m_cache(size)
+      {}
+
+      value_type find(const key_type& key) override
+      {
+        auto i = m_cache.find(key);
+        return i == m_cache.end() ? value_type() : i->second;
+      }
+
+      void insert(const key_type& key, const value_type& solutions) override
+      {
+        m_cache.emplace(key, solutions);
+      }
+
+      std::size_t size() const override
+      {
+        return m_cache.size();
+      }
+
+      std::size_t evictions() const override
+      {
+        return m_cache.evictions();
+      }
+
+      cache_interface* clone() const override
+      {
+        return new cache_implementation<Cache>(*this);
+      }
+    };
+
+    std::unique_ptr<cache_interface> m_cache;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+
+  public:
+    /// \brief Constructs a cache that stores at least size keys, where size zero means that the number of keys
+    ///        is not bounded.
+    explicit enumeration_cache(std::size_t size = 0, utilities::cache_replacement policy = utilities::cache_replacement::lru)
+    {
+      if (size == 0)
+      {
+        m_cache.reset(new cache_implementation<utilities::unbounded_cache<key_type, value_type> >(0));
+        return;
+      }
+      switch (policy)
+      {
+        case utilities::cache_replacement::fifo:
+          m_cache.reset(new cache_implementation<utilities::fifo_cache<key_type, value_type> >(size));
+          break;
+        case utilities::cache_replacement::lru:
+          m_cache.reset(new cache_implementation<utilities::lru_cache<key_type, value_type> >(size));
+          break;
+        case utilities::cache_replacement::clock:
+          m_cache.reset(new cache_implementation<utilities::clock_cache<key_type, value_type> >(size));
+          break;
+        case utilities::cache_replacement::lfu:
+          m_cache.reset(new cache_implementation<utilities::lfu_cache<key_type, value_type> >(size));
+          break;
+      }
+    }
+
+    enumeration_cache(const enumeration_cache& other)
+      : m_cache(other.m_cache->clone()),
+        m_hits(other.m_hits),
+        m_misses(other.m_misses)
+    {}
+
+    enumeration_cache& operator=(const enumeration_cache& other)
+    {
+      m_cache.reset(other.m_cache->clone());
+      m_hits = other.m_hits;
+      m_misses = other.m_misses;
+      return *this;
+    }
+
+    enumeration_cache(enumeration_cache&& other) = default;
+    enumeration_cache& operator=(enumeration_cache&& other) = default;
+
+    /// \returns The solutions that are stored for key, or a null pointer if they are not known.
+    value_type find(const key_type& key)
+    {
+      value_type result = m_cache->find(key);
+      if (result)
+      {
+        ++m_hits;
+      }
+      else
+      {
+        ++m_misses;
+      }
+      return result;
+    }
+
+    /// \brief Stores the solutions for key, which may remove the solutions of another key.
+    value_type insert(const key_type& key, solution_list solutions)
+    {
+      value_type result = std::make_shared<const solution_list>(std::move(solutions));
+      m_cache->insert(key, result);
+      return result;
+    }
+
+    std::size_t size() const
+    {
+      return m_cache->size();
+    }
+
+    std::size_t hits() const
+    {
+      return m_hits;
+    }
+
+    std::size_t misses() const
+    {
+      return m_misses;
+    }
+
+    std::size_t evictions() const
+    {
+      return m_cache->evictions();
+    }
+};
+
+/// \brief Accumulates the statistics of a number of caches, for instance the caches of all summands.
+struct enumeration_cache_statistics
+{
+  std::size_t size = 0;
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t evictions = 0;
+
+  void add(const enumeration_cache& cache)
+  {
+    size += cache.size();
+    hits += cache.hits();
+    misses += cache.misses();
+    evictions += cache.evictions();
+  }
+};
+
+inline
+std::ostream& operator<<(std::ostream& out, const enumeration_cache_statistics& statistics)
+{
+  return out << "enumeration cache: " << statistics.hits << " hits, " << statistics.misses << " misses, "
+             << statistics.evictions << " evictions, " << statistics.size << " entries";
+}
+
+} // namespace detail
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_DETAIL_ENUMERATION_CACHE_H
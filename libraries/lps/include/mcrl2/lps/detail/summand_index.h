@@ -0,0 +1,357 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/summand_index.h
+/// \brief An index that selects the summands whose conditions may hold in a given state.
+
+#ifndef MCRL2_LPS_DETAIL_SUMMAND_INDEX_H
+#define MCRL2_LPS_DETAIL_SUMMAND_INDEX_H
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "mcrl2/data/data_specification.h"
+#include "mcrl2/data/find.h"
+#include "mcrl2/data/list.h"
+#include "mcrl2/data/normalize_sorts.h"
+#include "mcrl2/data/standard.h"
+#include "mcrl2/lps/state.h"
+
+namespace mcrl2
+{
+
+namespace lps
+{
+
+namespace detail
+{
+
+/// \brief A decision tree on the values of process parameters, of which the leaves are the summands whose
+///        conditions may hold for these values.
+/// \details The tree is computed from the conjuncts of the conditions of the form d = e, e = d, d and !d,
+///          where d is a process parameter and e is a closed expression that rewrites to a constructor term.
+///          In a state in which d has a different value than e, the conjunct rewrites to false. This relies on
+///          normal forms of constructor terms being unique, and on the values in states being normal forms.
+///          Therefore only parameters of which the sort is free are indexed, see is_free_sort.
+class summand_index
+{
+  protected:
+    // A conjunct d_i = value of a condition.
+    typedef std::pair<std::size_t, data::data_expression> constraint;
+
+    struct node
+    {
+      // The leaves have no children, and contain the summands.
+      std::size_t parameter = 0;
+      std::unordered_map<data::data_expression, std::size_t> children;
+      std::size_t default_child = 0;
+      std::vector<std::size_t> summands;
+    };
+
+    std::vector<node> m_nodes;
+    std::set<data::function_symbol> m_constructors;
+
+    // The number of summand positions that may still be copied into children, which bounds the size of the tree.
+    std::size_t m_budget = 0;
+
+    // Returns true if different constructor terms of sort s are never equal. This holds for Bool, Pos, Nat and Int,
+    // and for lists and structured sorts of which the elements or arguments have such a sort. It does not hold in
+    // general for sorts with constructors declared with cons, as equations may identify different constructor terms.
+    bool is_free_sort(const data::sort_expression& s,
+                      const data::data_specification& dataspec,
+                      const std::set<data::sort_expression>& user_defined_sorts,
+                      std::set<data::sort_expression>& visited
+                     ) const
+    {
+      if (user_defined_sorts.find(s) != user_defined_sorts.end())
+      {
+        return false;
+      }
+      if (data::sort_bool::is_bool(s) || data::sort_pos::is_pos(s) || data::sort_nat::is_nat(s) || data::sort_int::is_int(s))
+      {
+        return true;
+      }
+      if (data::sort_list::is_list(s))
+      {
+        return is_free_sort(atermpp::down_cast<data::container_sort>(s).element_sort(), dataspec, user_defined_sorts, visited);
+      }
+      if (!data::is_basic_sort(s) && !data::is_structured_sort(s))
+      {
+        return false;
+      }
+      if (!visited.insert(s).second)
+      {
+        return true;
+      }
+      const data::function_symbol_vector& constructors = dataspec.constructors(s);
+      if (constructors.empty())
+      {
+        return false;
+      }
+      for (const data::function_symbol& f: constructors)
+      {
+        if (data::is_function_sort(f.sort()))
+        {
+          for (const data::sort_expression& argument: atermpp::down_cast<data::function_sort>(f.sort()).domain())
+          {
+            if (!is_free_sort(argument, dataspec, user_defined_sorts, visited))
+            {
+              return false;
+            }
+          }
+        }
+      }
+      return true;
+    }
+
+    bool is_constructor_term(const data::data_expression& x) const
+    {
+      if (data::is_function_symbol(x))
+      {
+        return m_constructors.find(atermpp::down_cast<data::function_symbol>(x)) != m_constructors.end();
+      }
+      if (data::is_application(x))
+      {
+        const data::application& xa = atermpp::down_cast<data::application>(x);
+        return is_constructor_term(xa.head()) && std::all_of(xa.begin(), xa.end(), [&](const data::data_expression& y) { return is_constructor_term(y); });
+      }
+      return false;
+    }
+
+    // Adds the constraints in the conjuncts of the condition to result, at most one per process parameter.
+    template <typename Rewriter, typename Substitution>
+    void add_constraints(const data::data_expression& condition,
+                         const std::vector<data::variable>& parameters,
+                         const std::vector<bool>& indexed_parameters,
+                         const std::set<data::variable>& bound_variables,
+                         Rewriter& R,
+                         Substitution& sigma,
+                         std::map<std::size_t, data::data_expression>& result
+                        ) const
+    {
+      if (data::sort_bool::is_and_application(condition))
+      {
+        add_constraints(data::binary_left(atermpp::down_cast<data::application>(condition)), parameters, indexed_parameters, bound_variables, R, sigma, result);
+        add_constraints(data::binary_right(atermpp::down_cast<data::application>(condition)), parameters, indexed_parameters, bound_variables, R, sigma, result);
+        return;
+      }
+
+      auto parameter_index = [&](const data::data_expression& x)
+      {
+        return std::size_t(std::find(parameters.begin(), parameters.end(), x) - parameters.begin());
+      };
+
+      auto add = [&](const data::data_expression& d, const data::data_expression& e)
+      {
+        std::size_t i = parameter_index(d);
+        if (i == parameters.size() || !indexed_parameters[i] || result.find(i) != result.end())
+        {
+          return false;
+        }
+        for (const data::variable& v: data::find_free_variables(e))
+        {
+          if (bound_variables.find(v) != bound_variables.end())
+          {
+            return false;
+          }
+        }
+        data::data_expression value = R(e, sigma);
+        if (!is_constructor_term(value))
+        {
+          return false;
+        }
+        result[i] = value;
+        return true;
+      };
+
+      if (data::is_equal_to_application(condition))
+      {
+        const data::data_expression& left = data::binary_left(atermpp::down_cast<data::application>(condition));
+        const data::data_expression& right = data::binary_right(atermpp::down_cast<data::application>(condition));
+        if (!add(left, right))
+        {
+          add(right, left);
+        }
+      }
+      else if (data::sort_bool::is_not_application(condition))
+      {
+        add(data::sort_bool::arg(condition), data::sort_bool::false_());
+      }
+      else
+      {
+        add(condition, data::sort_bool::true_());
+      }
+    }
+
+    // Builds the subtree for the given summands, where the parameters in used are already decided.
+    std::size_t build(const std::vector<std::size_t>& summands, const std::vector<std::map<std::size_t, data::data_expression>>& constraints, std::set<std::size_t>& used)
+    {
+      std::size_t result = m_nodes.size();
+      m_nodes.emplace_back();
+
+      // For each parameter, count the summands that constrain it, and the number of different values.
+      std::map<std::size_t, std::set<data::data_expression>> values;
+      std::map<std::size_t, std::size_t> count;
+      for (std::size_t k: summands)
+      {
+        for (const auto& [i, value]: constraints[k])
+        {
+          if (used.find(i) == used.end())
+          {
+            values[i].insert(value);
+            count[i]++;
+          }
+        }
+      }
+
+      // Choose the parameter for which the expected number of summands in a child is minimal, and at least one
+      // less than in this node. Every child also contains the summands that do not constrain the parameter, so
+      // the copies must fit in the budget.
+      std::size_t parameter = 0;
+      double best = static_cast<double>(summands.size()) - 1.0;
+      std::size_t best_copies = 0;
+      for (const auto& [i, n]: count)
+      {
+        const std::size_t unconstrained = summands.size() - n;
+        const std::size_t copies = n + (values[i].size() + 1) * unconstrained;
+        const double expected = static_cast<double>(unconstrained) + static_cast<double>(n) / static_cast<double>(values[i].size() + 1);
+        if (expected < best && copies <= m_budget)
+        {
+          parameter = i;
+          best = expected;
+          best_copies = copies;
+        }
+      }
+      if (summands.size() <= 1 || best_copies == 0)
+      {
+        m_nodes[result].summands = summands;
+        return result;
+      }
+      m_budget -= best_copies;
+
+      std::map<data::data_expression, std::vector<std::size_t>> children;
+      std::vector<std::size_t> unconstrained;
+      for (const data::data_expression& value: values[parameter])
+      {
+        children[value];
+      }
+      for (std::size_t k: summands)
+      {
+        auto i = constraints[k].find(parameter);
+        if (i == constraints[k].end())
+        {
+          unconstrained.push_back(k);
+          for (auto& [value, child]: children)
+          {
+            child.push_back(k);
+          }
+        }
+        else
+        {
+          children[i->second].push_back(k);
+        }
+      }
+
+      used.insert(parameter);
+      m_nodes[result].parameter = parameter;
+      for (const auto& [value, child]: children)
+      {
+        std::size_t child_node = build(child, constraints, used);
+        m_nodes[result].children[value] = child_node;
+      }
+      m_nodes[result].default_child = build(unconstrained, constraints, used);
+      used.erase(parameter);
+      return result;
+    }
+
+  public:
+    /// \brief Default constructor. The index must be assigned before it can be used.
+    summand_index() = default;
+
+    /// \brief Constructs an index that selects all of the n summands.
+    explicit summand_index(std::size_t n)
+    {
+      m_nodes.emplace_back();
+      m_nodes.front().summands.resize(n);
+      std::iota(m_nodes.front().summands.begin(), m_nodes.front().summands.end(), 0);
+    }
+
+    /// \brief Constructs an index for summands with the given conditions and summation variables.
+    /// \param R A rewriter, used to compute the values that the process parameters are compared with.
+    /// \param sigma A substitution that is applied to these values, for instance to instantiate constants.
+    template <typename SummandSequence, typename Rewriter, typename Substitution>
+    summand_index(const SummandSequence& summands,
+                  const std::vector<data::variable>& parameters,
+                  const data::data_specification& dataspec,
+                  Rewriter& R,
+                  Substitution& sigma
+                 )
+    {
+      const data::function_symbol_vector& constructors = dataspec.constructors();
+      m_constructors.insert(constructors.begin(), constructors.end());
+
+      std::set<data::sort_expression> user_defined_sorts;
+      for (const data::function_symbol& f: dataspec.user_defined_constructors())
+      {
+        const data::sort_expression s = data::normalize_sorts(f.sort(), dataspec);
+        user_defined_sorts.insert(data::is_function_sort(s) ? atermpp::down_cast<data::function_sort>(s).codomain() : s);
+      }
+      std::vector<bool> indexed_parameters;
+      for (const data::variable& d: parameters)
+      {
+        std::set<data::sort_expression> visited;
+        indexed_parameters.push_back(is_free_sort(d.sort(), dataspec, user_defined_sorts, visited));
+      }
+
+      std::vector<std::map<std::size_t, data::data_expression>> constraints;
+      std::vector<std::size_t> all_summands;
+      for (const auto& summand: summands)
+      {
+        std::set<data::variable> bound_variables(parameters.begin(), parameters.end());
+        bound_variables.insert(summand.variables.begin(), summand.variables.end());
+        constraints.emplace_back();
+        add_constraints(summand.condition, parameters, indexed_parameters, bound_variables, R, sigma, constraints.back());
+        all_summands.push_back(all_summands.size());
+      }
+      std::set<std::size_t> used;
+      m_budget = 8 * all_summands.size();
+      build(all_summands, constraints, used);
+    }
+
+    /// \brief Returns the number of nodes of the decision tree.
+    std::size_t size() const
+    {
+      return m_nodes.size();
+    }
+
+    /// \brief Returns the indices of the summands whose conditions may hold in the state s, in increasing order.
+    /// \param n The number of elements of s.
+    const std::vector<std::size_t>& candidates(const state& s, std::size_t n) const
+    {
+      assert(!m_nodes.empty());
+      const node* current = &m_nodes.front();
+      while (current->summands.empty() && !current->children.empty())
+      {
+        auto i = current->children.find(s.element_at(current->parameter, n));
+        current = &m_nodes[i == current->children.end() ? current->default_child : i->second];
+      }
+      return current->summands;
+    }
+};
+
+} // namespace detail
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_DETAIL_SUMMAND_INDEX_H
@@ -12,19 +12,27 @@
 #ifndef MCRL2_LPS_EXPLORER_H
 #define MCRL2_LPS_EXPLORER_H
 
+#include <condition_variable>
 #include <deque>
+#include <exception>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <thread>
 #include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
+#include "mcrl2/atermpp/shared_guard.h"
 #include "mcrl2/data/consistency.h"
 #include "mcrl2/data/enumerator.h"
 #include "mcrl2/data/substitution_utility.h"
+#include "mcrl2/lps/detail/enumeration_cache.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
+#include "mcrl2/lps/detail/summand_index.h"
 #include "mcrl2/lps/explorer_options.h"
 #include "mcrl2/lps/find_representative.h"
 #include "mcrl2/lps/one_point_rule_rewrite.h"
@@ -254,17 +262,24 @@ struct explorer_summand
   caching cache_strategy;
   std::vector<data::variable> gamma;
   atermpp::function_symbol f_gamma;
-  mutable std::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> local_cache;
+  mutable detail::enumeration_cache local_cache;
 
   template <typename ActionSummand>
-  explorer_summand(const ActionSummand& summand, std::size_t summand_index, const data::variable_list& process_parameters, caching cache_strategy_)
+  explorer_summand(const ActionSummand& summand,
+                   std::size_t summand_index,
+                   const data::variable_list& process_parameters,
+                   caching cache_strategy_,
+                   std::size_t cache_size = 0,
+                   utilities::cache_replacement cache_policy = utilities::cache_replacement::lru
+                  )
     : variables(summand.summation_variables()),
       condition(summand.condition()),
       multi_action(summand.multi_action().actions(), summand.multi_action().time()),
       distribution(summand_distribution(summand)),
       next_state(make_data_expression_vector(summand.next_state(process_parameters))),
       index(summand_index),
-      cache_strategy(cache_strategy_)
+      cache_strategy(cache_strategy_),
+      local_cache(cache_strategy_ == caching::local ? cache_size : 0, cache_policy)
   {
     gamma = free_variables(summand.condition(), process_parameters);
     if (cache_strategy_ == caching::global)
@@ -359,6 +374,7 @@ class explorer: public abortable
     };
 
     const explorer_options& m_options;
+    const data::data_specification& m_data_specification; // the data specification used by the enumerator
     data::rewriter m_rewr;
     mutable data::mutable_indexed_substitution<> m_sigma;
     data::enumerator_identifier_generator m_id_generator;
@@ -371,10 +387,18 @@ class explorer: public abortable
     std::vector<explorer_summand> m_regular_summands;
     std::vector<explorer_summand> m_confluent_summands;
 
+    // Select the summands of m_regular_summands and m_confluent_summands that may be enabled in a state.
+    detail::summand_index m_regular_summand_index;
+    detail::summand_index m_confluent_summand_index;
+
+    // The positions 0, ..., n-1 of summand sequences that are not indexed, for instance those of a divergence detector.
+    std::unordered_map<const void*, std::vector<std::size_t>> m_all_summands;
+
     volatile bool m_must_abort = false;
 
     // N.B. The keys are stored in term_appl instead of data_expression_list for performance reasons.
-    std::unordered_map<atermpp::term_appl<data::data_expression>, std::list<data::data_expression_list>> global_cache;
+    detail::enumeration_cache global_cache;
+    detail::enumeration_cache_statistics m_worker_cache_statistics; // the statistics of the caches of the workers of a parallel exploration
     std::unordered_map<state, std::size_t> m_discovered;
 
     // used by make_timed_state, to avoid needless creation of vectors
@@ -400,6 +424,32 @@ class explorer: public abortable
       return result;
     }
 
+    // Returns the positions of the summands in summands of which the conditions are not falsified by the values of
+    // the process parameters in the state s. Only the summand sequences of the explorer itself are indexed.
+    template <typename SummandSequence>
+    const std::vector<std::size_t>& candidate_summands(const state& s, const SummandSequence& summands)
+    {
+      if constexpr (std::is_same<SummandSequence, std::vector<explorer_summand>>::value)
+      {
+        // N.B. Timed states have an additional element.
+        if (&summands == &m_regular_summands)
+        {
+          return m_regular_summand_index.candidates(s, Timed ? s.size() : m_n);
+        }
+        if (&summands == &m_confluent_summands)
+        {
+          return m_confluent_summand_index.candidates(s, Timed ? s.size() : m_n);
+        }
+      }
+      std::vector<std::size_t>& result = m_all_summands[&summands];
+      if (result.size() != summands.size())
+      {
+        result.resize(summands.size());
+        std::iota(result.begin(), result.end(), 0);
+      }
+      return result;
+    }
+
     // Evaluates whether t0 <= t1
     bool less_equal(const data::data_expression& t0, const data::data_expression& t1) const
     {
@@ -539,26 +589,29 @@ class explorer: public abortable
       {
         auto key = summand.compute_key(m_sigma);
         auto& cache = summand.cache_strategy == caching::global ? global_cache : summand.local_cache;
-        auto q = cache.find(key);
-        if (q == cache.end())
+
+        // The solutions are shared with the cache, such that they remain valid when they are removed
+        // from the cache during the recursive calls below.
+        detail::enumeration_cache::value_type solutions = cache.find(key);
+        if (!solutions)
         {
           data::data_expression condition = m_rewr(summand.condition, m_sigma);
-          std::list<data::data_expression_list> solutions;
+          detail::enumeration_cache::solution_list enumerated_solutions;
           if (!data::is_false(condition))
           {
             m_enumerator.enumerate(enumerator_element(summand.variables, condition),
                         m_sigma,
                         [&](const enumerator_element& p) {
                           check_enumerator_solution(p, summand);
-                          solutions.push_back(p.assign_expressions(summand.variables, m_rewr));
+                          enumerated_solutions.push_back(p.assign_expressions(summand.variables, m_rewr));
                           return false;
                         },
                         data::is_false
             );
           }
-          q = cache.insert({key, solutions}).first;
+          solutions = cache.insert(key, std::move(enumerated_solutions));
         }
-        for (const data::data_expression_list& e: q->second)
+        for (const data::data_expression_list& e: *solutions)
         {
           data::add_assignments(m_sigma, summand.variables, e);
           process::timed_multi_action a = rewrite_action(summand.multi_action);
@@ -593,8 +646,9 @@ class explorer: public abortable
     {
       std::list<transition> transitions;
       data::add_assignments(m_sigma, m_process_parameters, s);
-      for (const explorer_summand& summand: regular_summands)
+      for (std::size_t i: candidate_summands(s, regular_summands))
       {
+        const explorer_summand& summand = regular_summands[i];
         generate_transitions(
           summand,
           confluent_summands,
@@ -631,8 +685,9 @@ class explorer: public abortable
     {
       std::vector<state> result;
       data::add_assignments(m_sigma, m_process_parameters, s0);
-      for (const explorer_summand& summand: summands)
+      for (std::size_t i: candidate_summands(s0, summands))
       {
+        const explorer_summand& summand = summands[i];
         generate_transitions(
           summand,
           confluent_summands,
@@ -655,6 +710,230 @@ class explorer: public abortable
       return result;
     }
 
+    // Returns the index of the target s1 of a transition from s with action a. If s1 was not discovered
+    // before, it is added to discovered and todo.
+    template <typename DiscoverState>
+    std::size_t discover_target_state(
+      const state& s,
+      const process::timed_multi_action& a,
+      const state& s1,
+      std::unordered_map<state, std::size_t>& discovered,
+      todo_set& todo,
+      DiscoverState& discover_state
+    )
+    {
+      utilities::mcrl2_unused(s, a); // silence unused parameter warnings
+      auto j = discovered.find(s1);
+      if (j == discovered.end())
+      {
+        std::size_t k = discovered.size();
+        if constexpr (Timed)
+        {
+          const data::data_expression& t = s[m_n];
+          data::data_expression t1 = a.has_time() ? a.time() : t;
+          state s1_at_t1 = make_timed_state(s1, t1);
+          j = discovered.insert(std::make_pair(s1_at_t1, k)).first;
+          discover_state(s1_at_t1, k);
+          todo.insert(s1_at_t1);
+        }
+        else
+        {
+          j = discovered.insert(std::make_pair(s1, k)).first;
+          discover_state(s1, k);
+          todo.insert(s1);
+        }
+      }
+      return j->second;
+    }
+
+    // Computes the outgoing transitions of s, together with the index of the summand that generated them.
+    // N.B. Does not support stochastic specifications!
+    void compute_transitions(const state& s, std::vector<std::tuple<process::timed_multi_action, state, std::size_t>>& transitions)
+    {
+      transitions.clear();
+      data::add_assignments(m_sigma, m_process_parameters, s);
+      for (std::size_t i: candidate_summands(s, m_regular_summands))
+      {
+        const explorer_summand& summand = m_regular_summands[i];
+        generate_transitions(
+          summand,
+          m_confluent_summands,
+          [&](const process::timed_multi_action& a, const state& s1)
+          {
+            if constexpr (Timed)
+            {
+              const data::data_expression& t = s[m_n];
+              if (a.has_time() && less_equal(a.time(), t))
+              {
+                return;
+              }
+            }
+            transitions.emplace_back(a, s1, summand.index);
+          }
+        );
+      }
+    }
+
+    // Creates a worker of a parallel exploration, that uses the rewriter rewr, which must be a clone of the rewriter
+    // of parent. The preprocessed summands and the summand indices are copied from parent instead of being computed
+    // again, but the worker has its own enumerator and empty caches.
+    explorer(const explorer& parent, const data::rewriter& rewr)
+      : m_options(parent.m_options),
+        m_data_specification(parent.m_data_specification),
+        m_rewr(rewr),
+        m_sigma(parent.m_sigma),
+        m_enumerator(m_rewr, m_data_specification, m_rewr, m_id_generator, false),
+        m_process_parameters(parent.m_process_parameters),
+        m_n(parent.m_n),
+        m_initial_state(parent.m_initial_state),
+        m_initial_distribution(parent.m_initial_distribution),
+        m_regular_summands(parent.m_regular_summands),
+        m_confluent_summands(parent.m_confluent_summands),
+        m_regular_summand_index(parent.m_regular_summand_index),
+        m_confluent_summand_index(parent.m_confluent_summand_index),
+        global_cache(m_options.cached && m_options.global_cache ? m_options.cache_size : 0, m_options.cache_policy)
+    {
+      timed_state.resize(m_n + 1);
+      for (std::vector<explorer_summand>* summands: { &m_regular_summands, &m_confluent_summands })
+      {
+        for (explorer_summand& summand: *summands)
+        {
+          summand.local_cache = detail::enumeration_cache(summand.cache_strategy == caching::local ? m_options.cache_size : 0, m_options.cache_policy);
+        }
+      }
+    }
+
+    // Generates the state space using m_options.number_of_threads workers, each of which has its own rewriter,
+    // enumerator and caches. The workers share the rewrite rules, and in case of the compiling rewriter the compiled
+    // code, of m_rewr. The outgoing transitions of states are computed in parallel. The discovered states
+    // and the todo set are shared by the workers, and the callback functions are invoked while holding a lock.
+    // The callbacks are invoked in the same order for each state as in generate_state_space, but the order in
+    // which the states are explored, and therefore their indices, is not deterministic.
+    // N.B. Does not support stochastic specifications!
+    template <
+      typename DiscoverState,
+      typename ExamineTransition,
+      typename StartState,
+      typename FinishState
+    >
+    void generate_state_space_parallel(
+      const state& s0,
+      std::unordered_map<state, std::size_t>& discovered,
+      DiscoverState discover_state,
+      ExamineTransition examine_transition,
+      StartState start_state,
+      FinishState finish_state
+    )
+    {
+      if (!atermpp::detail::GlobalThreadSafe)
+      {
+        throw mcrl2::runtime_error("Parallel state space exploration requires a toolset that is built with MCRL2_ENABLE_MULTITHREADING.");
+      }
+
+      std::unique_ptr<todo_set> todo = make_todo_set(s0);
+      discovered.clear();
+      discovered.insert(std::make_pair(s0, std::size_t(0)));
+      discover_state(s0, std::size_t(0));
+
+      std::vector<std::unique_ptr<explorer>> workers;
+      for (std::size_t i = 0; i < m_options.number_of_threads; i++)
+      {
+        workers.push_back(std::unique_ptr<explorer>(new explorer(*this, m_rewr.clone())));
+      }
+
+      std::mutex mutex;
+      std::condition_variable condition;
+      std::size_t busy_workers = 0;
+      std::exception_ptr exception;
+
+      auto work = [&](explorer& worker)
+      {
+        std::vector<std::tuple<process::timed_multi_action, state, std::size_t>> transitions;
+        while (true)
+        {
+          {
+            // Terms are only used while holding the guard. The guard is released after the lock, because releasing
+            // it may start a garbage collection that waits until the other workers release their guard.
+            atermpp::shared_guard guard;
+            std::unique_lock<std::mutex> lock(mutex);
+            if (m_must_abort || (todo->empty() && busy_workers == 0))
+            {
+              condition.notify_all();
+              return;
+            }
+
+            if (!todo->empty())
+            {
+              state s = todo->choose_element();
+              std::size_t s_index = discovered.find(s)->second;
+              busy_workers++;
+              lock.unlock();
+
+              bool computed = false;
+              try
+              {
+                worker.compute_transitions(s, transitions);
+                computed = true;
+
+                lock.lock();
+                start_state(s, s_index);
+                for (const auto& [a, s1, summand_index]: transitions)
+                {
+                  std::size_t s1_index = discover_target_state(s, a, s1, discovered, *todo, discover_state);
+                  examine_transition(s, s_index, a, s1, s1_index, summand_index);
+                }
+                finish_state(s, s_index, todo->size());
+                todo->finish_state();
+              }
+              catch (...)
+              {
+                if (!lock.owns_lock())
+                {
+                  lock.lock();
+                }
+                if (!exception)
+                {
+                  if (!computed)
+                  {
+                    // Report the state that could not be explored.
+                    start_state(s, s_index);
+                  }
+                  exception = std::current_exception();
+                }
+                m_must_abort = true;
+              }
+              busy_workers--;
+              condition.notify_all();
+              continue;
+            }
+          }
+
+          // Wait without holding the guard until there is work, or all work is done.
+          std::unique_lock<std::mutex> lock(mutex);
+          condition.wait(lock, [&]() { return !todo->empty() || busy_workers == 0 || m_must_abort; });
+        }
+      };
+
+      std::vector<std::thread> threads;
+      for (std::unique_ptr<explorer>& worker: workers)
+      {
+        threads.emplace_back(work, std::ref(*worker));
+      }
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+      for (std::unique_ptr<explorer>& worker: workers)
+      {
+        worker->add_cache_statistics(m_worker_cache_statistics);
+      }
+
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+    }
+
     std::unique_ptr<todo_set> make_todo_set(const state& init)
     {
       switch (m_options.search_strategy)
@@ -681,10 +960,12 @@ class explorer: public abortable
   public:
     explorer(const Specification& lpsspec, const explorer_options& options_)
       : m_options(options_),
+        m_data_specification(lpsspec.data()),
         m_rewr(lpsspec.data(),
           data::used_data_equation_selector(lpsspec.data(), add_real_operators(lps::find_function_symbols(lpsspec)), lpsspec.global_variables()),
           m_options.rewrite_strategy),
-        m_enumerator(m_rewr, lpsspec.data(), m_rewr, m_id_generator, false)
+        m_enumerator(m_rewr, m_data_specification, m_rewr, m_id_generator, false),
+        global_cache(m_options.cached && m_options.global_cache ? m_options.cache_size : 0, m_options.cache_policy)
     {
       Specification lpsspec_ = preprocess(lpsspec);
       const auto& params = lpsspec_.process().process_parameters();
@@ -701,13 +982,25 @@ class explorer: public abortable
         auto cache_strategy = m_options.cached ? (m_options.global_cache ? lps::caching::global : lps::caching::local) : lps::caching::none;
         if (summand.multi_action().actions().size() == 1 && summand.multi_action().actions().front().label().name() == ctau)
         {
-          m_confluent_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy);
+          m_confluent_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy, m_options.cache_size, m_options.cache_policy);
         }
         else
         {
-          m_regular_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy);
+          m_regular_summands.emplace_back(summand, i, lpsspec_.process().process_parameters(), cache_strategy, m_options.cache_size, m_options.cache_policy);
         }
       }
+
+      if (m_options.no_summand_index)
+      {
+        m_regular_summand_index = detail::summand_index(m_regular_summands.size());
+        m_confluent_summand_index = detail::summand_index(m_confluent_summands.size());
+      }
+      else
+      {
+        m_regular_summand_index = detail::summand_index(m_regular_summands, m_process_parameters, lpsspec_.data(), m_rewr, m_sigma);
+        m_confluent_summand_index = detail::summand_index(m_confluent_summands, m_process_parameters, lpsspec_.data(), m_rewr, m_sigma);
+        mCRL2log(log::verbose) << "The summand index has " << m_regular_summand_index.size() + m_confluent_summand_index.size() << " nodes." << std::endl;
+      }
     }
 
     ~explorer() = default;
@@ -801,8 +1094,9 @@ class explorer: public abortable
         std::size_t s_index = discovered.find(s)->second;
         start_state(s, s_index);
         data::add_assignments(m_sigma, m_process_parameters, s);
-        for (const explorer_summand& summand: regular_summands)
+        for (std::size_t i: candidate_summands(s, regular_summands))
         {
+          const explorer_summand& summand = regular_summands[i];
           generate_transitions(
             summand,
             confluent_summands,
@@ -837,27 +1131,7 @@ class explorer: public abortable
               }
               else
               {
-                auto j = discovered.find(s1);
-                if (j == discovered.end())
-                {
-                  std::size_t k = discovered.size();
-                  if constexpr (Timed)
-                  {
-                    const data::data_expression& t = s[m_n];
-                    data::data_expression t1 = a.has_time() ? a.time() : t;
-                    state s1_at_t1 = make_timed_state(s1, t1);
-                    j = discovered.insert(std::make_pair(s1_at_t1, k)).first;
-                    discover_state(s1_at_t1, k);
-                    todo->insert(s1_at_t1);
-                  }
-                  else
-                  {
-                    j = discovered.insert(std::make_pair(s1, k)).first;
-                    discover_state(s1, k);
-                    todo->insert(s1);
-                  }
-                }
-                std::size_t s1_index = j->second;
+                std::size_t s1_index = discover_target_state(s, a, s1, discovered, *todo, discover_state);
                 examine_transition(s, s_index, a, s1, s1_index, summand.index);
               }
             }
@@ -907,6 +1181,13 @@ class explorer: public abortable
         {
           s0 = make_timed_state(s0, real_zero());
         }
+
+        if (m_options.number_of_threads > 1 && !recursive)
+        {
+          generate_state_space_parallel(s0, m_discovered, discover_state, examine_transition, start_state, finish_state);
+          m_must_abort = false;
+          return;
+        }
       }
       generate_state_space(recursive, s0, m_regular_summands, m_confluent_summands, m_discovered, discover_state, examine_transition, start_state, finish_state, discover_initial_state);
     }
@@ -917,8 +1198,9 @@ class explorer: public abortable
       data::data_expression_list process_parameter_undo = process_parameter_values();
       std::vector<std::pair<lps::multi_action, state_type>> result;
       data::add_assignments(m_sigma, m_process_parameters, d0);
-      for (const explorer_summand& summand: m_regular_summands)
+      for (std::size_t i: candidate_summands(d0, m_regular_summands))
       {
+        const explorer_summand& summand = m_regular_summands[i];
         generate_transitions(
           summand,
           m_confluent_summands,
@@ -1203,6 +1485,29 @@ class explorer: public abortable
       return m_discovered;
     }
 
+    /// \brief Adds the statistics of the enumeration caches to statistics.
+    void add_cache_statistics(detail::enumeration_cache_statistics& statistics) const
+    {
+      statistics.add(global_cache);
+      for (const explorer_summand& summand: m_regular_summands)
+      {
+        statistics.add(summand.local_cache);
+      }
+      for (const explorer_summand& summand: m_confluent_summands)
+      {
+        statistics.add(summand.local_cache);
+      }
+    }
+
+    /// \brief Returns the accumulated statistics of the enumeration caches, including those of the workers
+    /// of a parallel exploration.
+    detail::enumeration_cache_statistics cache_statistics() const
+    {
+      detail::enumeration_cache_statistics result = m_worker_cache_statistics;
+      add_cache_statistics(result);
+      return result;
+    }
+
     const std::vector<explorer_summand>& regular_summands() const
     {
       return m_regular_summands;
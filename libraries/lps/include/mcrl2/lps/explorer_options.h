@@ -17,6 +17,7 @@
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/lps/multi_action.h"
 #include "mcrl2/lps/exploration_strategy.h"
+#include "mcrl2/utilities/cache_policy.h"
 
 namespace mcrl2 {
 
@@ -31,6 +32,8 @@ struct explorer_options
   bool resolve_summand_variable_name_clashes = false;
   bool cached = false;
   bool global_cache = false;
+  std::size_t cache_size = 0; // the maximum number of keys of an enumeration cache, where 0 means unbounded
+  utilities::cache_replacement cache_policy = utilities::cache_replacement::lru;
   bool confluence = false;
   bool detect_deadlock = false;
   bool detect_nondeterminism = false;
@@ -40,10 +43,12 @@ struct explorer_options
   bool generate_traces = false;
   bool suppress_progress_messages = false;
   bool no_store = false;
+  bool no_summand_index = false;
   bool dfs_recursive = false;
   std::size_t max_states = std::numeric_limits<std::size_t>::max();
   std::size_t max_traces = 0;
   std::size_t todo_max = std::numeric_limits<std::size_t>::max();
+  std::size_t number_of_threads = 1;
   std::string priority_action;
   std::string trace_prefix;
   std::set<core::identifier_string> trace_actions;
@@ -59,6 +64,8 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "search-strategy = " << options.search_strategy << std::endl;
   out << "cached = " << std::boolalpha << options.cached << std::endl;
   out << "global-cache = " << std::boolalpha << options.global_cache << std::endl;
+  out << "cache-size = " << options.cache_size << std::endl;
+  out << "cache-policy = " << options.cache_policy << std::endl;
   out << "confluence = " << std::boolalpha << options.confluence << std::endl;
   out << "one-point-rule-rewrite = " << std::boolalpha << options.one_point_rule_rewrite << std::endl;
   out << "resolve-summand-variable-name-clashes = " << std::boolalpha << options.resolve_summand_variable_name_clashes << std::endl;
@@ -71,10 +78,12 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "generate-traces = " << std::boolalpha << options.generate_traces << std::endl;
   out << "suppress-progress-messages = " << std::boolalpha << options.suppress_progress_messages << std::endl;
   out << "no-store = " << std::boolalpha << options.no_store << std::endl;
+  out << "no-summand-index = " << std::boolalpha << options.no_summand_index << std::endl;
   out << "dfs-recursive = " << std::boolalpha << options.dfs_recursive << std::endl;
   out << "max-states = " << options.max_states << std::endl;
   out << "max-traces = " << options.max_traces << std::endl;
   out << "todo-max = " << options.todo_max << std::endl;
+  out << "threads = " << options.number_of_threads << std::endl;
   out << "priority-action = " << options.priority_action << std::endl;
   out << "trace-prefix = " << options.trace_prefix << std::endl;
   out << "trace-actions = " << core::detail::print_set(options.trace_actions) << std::endl;
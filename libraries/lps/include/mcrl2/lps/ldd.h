@@ -0,0 +1,569 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/ldd.h
+/// \brief List decision diagrams, which represent sets of vectors of natural numbers.
+
+#ifndef MCRL2_LPS_LDD_H
+#define MCRL2_LPS_LDD_H
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/indexed_set.h"
+
+namespace mcrl2
+{
+
+namespace lps
+{
+
+/// \brief Stores list decision diagrams (LDDs), which represent sets of vectors of natural numbers that
+///        all have the same length.
+/// \details An LDD is either false (the empty set), true (the set containing the empty vector), or a node
+///          with a value, a down node and a right node. It represents the vectors in its down node prefixed
+///          with its value, together with the vectors represented by its right node. The values along the
+///          right nodes are strictly increasing, and nodes with a false down node are removed, such that every
+///          set has a unique representation. Nodes are maximally shared and identified by their index; the
+///          children of a node always have a smaller index than the node itself.
+///
+///          Relations, as used by relational_product, are LDDs over vectors that contain for every parameter that
+///          is read the value before the step, followed by the value after the step if the parameter is written.
+///          Parameters that are neither read nor written do not occur in a relation.
+class ldd_manager
+{
+  public:
+    typedef std::uint32_t ldd;
+
+    static constexpr ldd ldd_false = 0;
+    static constexpr ldd ldd_true = 1;
+
+    /// \brief How a relation accesses a parameter.
+    enum class access
+    {
+      copy,       ///< The parameter is neither read nor written, its value is kept.
+      read,       ///< The parameter is read but not written.
+      write,      ///< The parameter is written, but its value is not read.
+      read_write  ///< The parameter is both read and written.
+    };
+
+  protected:
+    struct node
+    {
+      std::uint32_t value;
+      ldd down;
+      ldd right;
+
+      bool operator==(const node& other) const
+      {
+        return value == other.value && down == other.down && right == other.right;
+      }
+    };
+
+    struct node_hash
+    {
+      std::size_t operator()(const node& n) const
+      {
+        return utilities::detail::hash_combine(utilities::detail::hash_combine(n.value, n.down), n.right);
+      }
+    };
+
+    struct pair_hash
+    {
+      std::size_t operator()(const std::pair<ldd, ldd>& p) const
+      {
+        return utilities::detail::hash_combine(p.first, p.second);
+      }
+    };
+
+    utilities::indexed_set<node, node_hash> m_nodes;
+
+    std::unordered_map<std::pair<ldd, ldd>, ldd, pair_hash> m_union_cache;
+    std::unordered_map<std::pair<ldd, ldd>, ldd, pair_hash> m_minus_cache;
+
+    const node& get(ldd x) const
+    {
+      assert(x != ldd_false && x != ldd_true);
+      return m_nodes.at(x);
+    }
+
+    // Builds the chain of nodes with the given values and down nodes, which must be sorted on their values.
+    ldd make_chain(const std::vector<std::pair<std::uint32_t, ldd>>& chain)
+    {
+      ldd result = ldd_false;
+      for (auto i = chain.rbegin(); i != chain.rend(); ++i)
+      {
+        result = make_node(i->first, i->second, result);
+      }
+      return result;
+    }
+
+    ldd make_chain(const std::map<std::uint32_t, ldd>& chain)
+    {
+      ldd result = ldd_false;
+      for (auto i = chain.rbegin(); i != chain.rend(); ++i)
+      {
+        result = make_node(i->first, i->second, result);
+      }
+      return result;
+    }
+
+    // The local caches of the operations that depend on more than their arguments.
+    typedef std::unordered_map<std::pair<ldd, ldd>, ldd, pair_hash> relational_product_cache;
+    typedef std::unordered_map<ldd, ldd> project_cache;
+
+    ldd relational_product(ldd states, ldd relation, const std::vector<access>& meta, std::size_t level,
+                           std::size_t last_level, std::vector<relational_product_cache>& cache)
+    {
+      if (states == ldd_false || relation == ldd_false)
+      {
+        return ldd_false;
+      }
+      if (level >= last_level)
+      {
+        // The remaining parameters are copied.
+        assert(relation == ldd_true);
+        return states;
+      }
+
+      auto i = cache[level].find(std::make_pair(states, relation));
+      if (i != cache[level].end())
+      {
+        return i->second;
+      }
+
+      ldd result = ldd_false;
+      switch (meta[level])
+      {
+        case access::copy:
+        {
+          std::vector<std::pair<std::uint32_t, ldd>> chain;
+          for (ldd s = states; s != ldd_false; s = get(s).right)
+          {
+            const node n = get(s);
+            chain.emplace_back(n.value, relational_product(n.down, relation, meta, level + 1, last_level, cache));
+          }
+          result = make_chain(chain);
+          break;
+        }
+        case access::read:
+        {
+          std::vector<std::pair<std::uint32_t, ldd>> chain;
+          ldd s = states;
+          ldd r = relation;
+          while (s != ldd_false && r != ldd_false)
+          {
+            const node ns = get(s);
+            const node nr = get(r);
+            if (ns.value < nr.value)
+            {
+              s = ns.right;
+            }
+            else if (nr.value < ns.value)
+            {
+              r = nr.right;
+            }
+            else
+            {
+              chain.emplace_back(ns.value, relational_product(ns.down, nr.down, meta, level + 1, last_level, cache));
+              s = ns.right;
+              r = nr.right;
+            }
+          }
+          result = make_chain(chain);
+          break;
+        }
+        case access::write:
+        {
+          // The value is not read, so all vectors in states can take every step of the relation.
+          ldd downs = ldd_false;
+          for (ldd s = states; s != ldd_false; s = get(s).right)
+          {
+            downs = union_(downs, get(s).down);
+          }
+          std::vector<std::pair<std::uint32_t, ldd>> chain;
+          for (ldd w = relation; w != ldd_false; w = get(w).right)
+          {
+            const node nw = get(w);
+            chain.emplace_back(nw.value, relational_product(downs, nw.down, meta, level + 1, last_level, cache));
+          }
+          result = make_chain(chain);
+          break;
+        }
+        case access::read_write:
+        {
+          std::map<std::uint32_t, ldd> chain;
+          ldd s = states;
+          ldd r = relation;
+          while (s != ldd_false && r != ldd_false)
+          {
+            const node ns = get(s);
+            const node nr = get(r);
+            if (ns.value < nr.value)
+            {
+              s = ns.right;
+            }
+            else if (nr.value < ns.value)
+            {
+              r = nr.right;
+            }
+            else
+            {
+              for (ldd w = nr.down; w != ldd_false; w = get(w).right)
+              {
+                const node nw = get(w);
+                const ldd successors = relational_product(ns.down, nw.down, meta, level + 1, last_level, cache);
+                auto j = chain.find(nw.value);
+                if (j == chain.end())
+                {
+                  chain[nw.value] = successors;
+                }
+                else
+                {
+                  j->second = union_(j->second, successors);
+                }
+              }
+              s = ns.right;
+              r = nr.right;
+            }
+          }
+          result = make_chain(chain);
+          break;
+        }
+      }
+
+      cache[level][std::make_pair(states, relation)] = result;
+      return result;
+    }
+
+    ldd project(ldd states, const std::vector<bool>& keep, std::size_t level, std::vector<project_cache>& cache)
+    {
+      if (states == ldd_false || level == keep.size())
+      {
+        return states;
+      }
+
+      auto i = cache[level].find(states);
+      if (i != cache[level].end())
+      {
+        return i->second;
+      }
+
+      ldd result = ldd_false;
+      if (keep[level])
+      {
+        std::vector<std::pair<std::uint32_t, ldd>> chain;
+        for (ldd s = states; s != ldd_false; s = get(s).right)
+        {
+          const node n = get(s);
+          chain.emplace_back(n.value, project(n.down, keep, level + 1, cache));
+        }
+        result = make_chain(chain);
+      }
+      else
+      {
+        for (ldd s = states; s != ldd_false; s = get(s).right)
+        {
+          result = union_(result, project(get(s).down, keep, level + 1, cache));
+        }
+      }
+
+      cache[level][states] = result;
+      return result;
+    }
+
+    double count(ldd x, std::unordered_map<ldd, double>& cache) const
+    {
+      if (x == ldd_false)
+      {
+        return 0.0;
+      }
+      if (x == ldd_true)
+      {
+        return 1.0;
+      }
+      auto i = cache.find(x);
+      if (i != cache.end())
+      {
+        return i->second;
+      }
+      double result = 0.0;
+      for (ldd s = x; s != ldd_false; s = get(s).right)
+      {
+        result += count(get(s).down, cache);
+      }
+      cache[x] = result;
+      return result;
+    }
+
+    template <typename F>
+    void for_each(ldd x, std::vector<std::uint32_t>& vector, F& f) const
+    {
+      if (x == ldd_true)
+      {
+        f(vector);
+        return;
+      }
+      for (ldd s = x; s != ldd_false; s = get(s).right)
+      {
+        const node& n = get(s);
+        vector.push_back(n.value);
+        for_each(n.down, vector, f);
+        vector.pop_back();
+      }
+    }
+
+  public:
+    ldd_manager()
+    {
+      // Reserve the indices of false and true.
+      m_nodes.insert(node{ 0, ldd_false, ldd_false });
+      m_nodes.insert(node{ 1, ldd_true, ldd_true });
+    }
+
+    /// \returns The LDD with the given value, down and right node.
+    /// \pre The right node is false or has a value larger than value.
+    ldd make_node(std::uint32_t value, ldd down, ldd right)
+    {
+      if (down == ldd_false)
+      {
+        return right;
+      }
+      assert(right == ldd_false || value < get(right).value);
+      const std::size_t result = m_nodes.insert(node{ value, down, right }).first;
+      if (result > std::numeric_limits<ldd>::max())
+      {
+        throw mcrl2::runtime_error("The number of LDD nodes exceeds 2^32.");
+      }
+      return static_cast<ldd>(result);
+    }
+
+    /// \returns The LDD that contains only the given vector.
+    ldd cube(const std::vector<std::uint32_t>& vector)
+    {
+      ldd result = ldd_true;
+      for (auto i = vector.rbegin(); i != vector.rend(); ++i)
+      {
+        result = make_node(*i, result, ldd_false);
+      }
+      return result;
+    }
+
+    /// \returns The union of x and y.
+    ldd union_(ldd x, ldd y)
+    {
+      if (x == y || y == ldd_false)
+      {
+        return x;
+      }
+      if (x == ldd_false)
+      {
+        return y;
+      }
+      if (y < x)
+      {
+        std::swap(x, y);
+      }
+
+      auto i = m_union_cache.find(std::make_pair(x, y));
+      if (i != m_union_cache.end())
+      {
+        return i->second;
+      }
+
+      // The chains of right nodes can be long, so they are merged iteratively.
+      std::vector<std::pair<std::uint32_t, ldd>> chain;
+      ldd a = x;
+      ldd b = y;
+      while (a != ldd_false && b != ldd_false)
+      {
+        const node na = get(a);
+        const node nb = get(b);
+        if (na.value < nb.value)
+        {
+          chain.emplace_back(na.value, na.down);
+          a = na.right;
+        }
+        else if (nb.value < na.value)
+        {
+          chain.emplace_back(nb.value, nb.down);
+          b = nb.right;
+        }
+        else
+        {
+          chain.emplace_back(na.value, union_(na.down, nb.down));
+          a = na.right;
+          b = nb.right;
+        }
+      }
+      ldd result = a != ldd_false ? a : b;
+      for (auto j = chain.rbegin(); j != chain.rend(); ++j)
+      {
+        result = make_node(j->first, j->second, result);
+      }
+
+      m_union_cache[std::make_pair(x, y)] = result;
+      return result;
+    }
+
+    /// \returns The vectors in x that are not in y.
+    ldd minus(ldd x, ldd y)
+    {
+      if (x == y || x == ldd_false)
+      {
+        return ldd_false;
+      }
+      if (y == ldd_false)
+      {
+        return x;
+      }
+
+      auto i = m_minus_cache.find(std::make_pair(x, y));
+      if (i != m_minus_cache.end())
+      {
+        return i->second;
+      }
+
+      std::vector<std::pair<std::uint32_t, ldd>> chain;
+      ldd a = x;
+      ldd b = y;
+      while (a != ldd_false && b != ldd_false)
+      {
+        const node na = get(a);
+        const node nb = get(b);
+        if (na.value < nb.value)
+        {
+          chain.emplace_back(na.value, na.down);
+          a = na.right;
+        }
+        else if (nb.value < na.value)
+        {
+          b = nb.right;
+        }
+        else
+        {
+          chain.emplace_back(na.value, minus(na.down, nb.down));
+          a = na.right;
+          b = nb.right;
+        }
+      }
+      ldd result = a;
+      for (auto j = chain.rbegin(); j != chain.rend(); ++j)
+      {
+        result = make_node(j->first, j->second, result);
+      }
+
+      m_minus_cache[std::make_pair(x, y)] = result;
+      return result;
+    }
+
+    /// \returns The vectors that are reached from the vectors in states by one step of the relation.
+    /// \param meta How the relation accesses each position of the vectors in states.
+    ldd relational_product(ldd states, ldd relation, const std::vector<access>& meta)
+    {
+      std::size_t last_level = 0;
+      for (std::size_t i = 0; i < meta.size(); ++i)
+      {
+        if (meta[i] != access::copy)
+        {
+          last_level = i + 1;
+        }
+      }
+      std::vector<relational_product_cache> cache(meta.size());
+      return relational_product(states, relation, meta, 0, last_level, cache);
+    }
+
+    /// \returns The vectors in states restricted to the positions i for which keep[i] holds.
+    ldd project(ldd states, const std::vector<bool>& keep)
+    {
+      std::vector<project_cache> cache(keep.size());
+      return project(states, keep, 0, cache);
+    }
+
+    /// \returns The number of vectors in x.
+    double count(ldd x) const
+    {
+      std::unordered_map<ldd, double> cache;
+      return count(x, cache);
+    }
+
+    /// \brief Calls f for every vector in x, in lexicographical order.
+    template <typename F>
+    void for_each(ldd x, F f) const
+    {
+      if (x == ldd_false)
+      {
+        return;
+      }
+      std::vector<std::uint32_t> vector;
+      for_each(x, vector, f);
+    }
+
+    /// \returns The number of nodes that are stored, including the nodes that are no longer used.
+    std::size_t size() const
+    {
+      return m_nodes.size();
+    }
+
+    /// \brief Removes all nodes that cannot be reached from the given roots, and updates the roots.
+    /// \details This invalidates all LDDs except for the roots.
+    void garbage_collect(const std::vector<ldd*>& roots)
+    {
+      // Mark the reachable nodes. Children have smaller indices, so the nodes are visited in decreasing order.
+      std::vector<bool> reachable(m_nodes.size(), false);
+      reachable[ldd_false] = true;
+      reachable[ldd_true] = true;
+      for (const ldd* root: roots)
+      {
+        reachable[*root] = true;
+      }
+      for (std::size_t i = m_nodes.size(); i-- > 2; )
+      {
+        if (reachable[i])
+        {
+          reachable[m_nodes.at(i).down] = true;
+          reachable[m_nodes.at(i).right] = true;
+        }
+      }
+
+      // Insert the reachable nodes in increasing order, such that their children are renumbered first.
+      std::vector<ldd> renumbering(m_nodes.size(), ldd_false);
+      renumbering[ldd_true] = ldd_true;
+      utilities::indexed_set<node, node_hash> nodes;
+      nodes.insert(m_nodes.at(ldd_false));
+      nodes.insert(m_nodes.at(ldd_true));
+      for (std::size_t i = 2; i < m_nodes.size(); ++i)
+      {
+        if (reachable[i])
+        {
+          const node& n = m_nodes.at(i);
+          renumbering[i] = static_cast<ldd>(nodes.insert(node{ n.value, renumbering[n.down], renumbering[n.right] }).first);
+        }
+      }
+
+      std::swap(m_nodes, nodes);
+      for (ldd* root: roots)
+      {
+        *root = renumbering[*root];
+      }
+      m_union_cache.clear();
+      m_minus_cache.clear();
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_LDD_H
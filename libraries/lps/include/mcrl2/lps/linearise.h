@@ -41,6 +41,7 @@ struct t_lin_options
   bool ignore_time;
   bool do_not_apply_constelm;
   mcrl2::data::rewriter::strategy rewrite_strategy;
+  std::size_t number_of_threads; // The number of threads used to combine the summands of parallel processes.
 
   t_lin_options()
     : lin_method(lmRegular),
@@ -55,7 +56,8 @@ struct t_lin_options
       nodeltaelimination(false),
       ignore_time(false),
       do_not_apply_constelm(false),
-      rewrite_strategy(mcrl2::data::jitty)
+      rewrite_strategy(mcrl2::data::jitty),
+      number_of_threads(1)
   {}
 };
 
@@ -0,0 +1,252 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/lpsreach.h
+/// \brief Symbolic computation of the reachable states of a linear process, using list decision diagrams.
+
+#ifndef MCRL2_LPS_LPSREACH_H
+#define MCRL2_LPS_LPSREACH_H
+
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <vector>
+#include "mcrl2/data/find.h"
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lps/ldd.h"
+#include "mcrl2/utilities/indexed_set.h"
+#include "mcrl2/utilities/logger.h"
+
+namespace mcrl2::lps {
+
+struct lpsreach_options: public explorer_options
+{
+  bool chaining = false; // apply the summands one after another within an iteration
+};
+
+/// \brief Computes the reachable states of a linear process symbolically. States are vectors of indices of
+///        parameter values, and sets of states are stored as list decision diagrams.
+/// \details For every summand the parameters that it reads and writes are determined. The transition relation
+///          of a summand is only known for the values of its read parameters that have been encountered, and is
+///          learned on the fly by generating the transitions of the summand with the explorer, once for every new
+///          combination of values of its read parameters. As summands typically read few parameters, this needs
+///          far fewer calls to the rewriter than explicit exploration.
+class lpsreach_algorithm: public explorer<false, false, specification>
+{
+  typedef explorer<false, false, specification> super;
+  typedef ldd_manager::ldd ldd;
+  typedef ldd_manager::access access;
+
+  protected:
+    struct summand_group
+    {
+      const explorer_summand* summand;
+      std::vector<access> meta;        // How the summand accesses every parameter.
+      std::vector<bool> read;          // Whether the summand reads a parameter.
+      std::vector<std::size_t> read_parameters;
+      ldd relation = ldd_manager::ldd_false; // The transitions learned so far.
+      ldd learned = ldd_manager::ldd_false;  // The values of the read parameters for which the transitions are known.
+    };
+
+    const lpsreach_options& m_options;
+    ldd_manager m_ldd;
+    std::vector<utilities::indexed_set<data::data_expression>> m_values; // The values of every parameter.
+    std::vector<summand_group> m_groups;
+
+    // The number of nodes after the previous garbage collection.
+    std::size_t m_collected_size = 1 << 20;
+
+    void compute_dependencies(const explorer_summand& summand)
+    {
+      summand_group group;
+      group.summand = &summand;
+      group.read.resize(m_n, false);
+      group.meta.resize(m_n, access::copy);
+
+      std::set<data::variable> used = data::find_free_variables(summand.condition);
+      for (std::size_t j = 0; j < m_n; ++j)
+      {
+        if (summand.next_state[j] != m_process_parameters[j])
+        {
+          data::find_free_variables(summand.next_state[j], std::inserter(used, used.end()));
+        }
+      }
+
+      for (std::size_t j = 0; j < m_n; ++j)
+      {
+        const bool read = used.find(m_process_parameters[j]) != used.end();
+        const bool write = summand.next_state[j] != m_process_parameters[j];
+        group.read[j] = read;
+        if (read)
+        {
+          group.read_parameters.push_back(j);
+        }
+        group.meta[j] = read ? (write ? access::read_write : access::read) : (write ? access::write : access::copy);
+      }
+      m_groups.push_back(group);
+    }
+
+    std::uint32_t value_index(std::size_t j, const data::data_expression& value)
+    {
+      const std::size_t result = m_values[j].insert(value).first;
+      if (result > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw mcrl2::runtime_error("Parameter " + data::pp(m_process_parameters[j]) + " has more than 2^32 values.");
+      }
+      return static_cast<std::uint32_t>(result);
+    }
+
+    // Adds the transitions of the summand for the given values of its read parameters to its relation.
+    void learn_transitions(summand_group& group, const std::vector<std::uint32_t>& read_values)
+    {
+      assert(read_values.size() == group.read_parameters.size());
+      for (std::size_t i = 0; i < read_values.size(); ++i)
+      {
+        const std::size_t j = group.read_parameters[i];
+        m_sigma[m_process_parameters[j]] = m_values[j][read_values[i]];
+      }
+
+      std::vector<std::uint32_t> transition;
+      generate_transitions(*group.summand, std::vector<explorer_summand>(),
+        [&](const process::timed_multi_action&, const state& s1)
+        {
+          // The relation contains the read value followed by the written value of every parameter that
+          // is accessed by the summand.
+          transition.clear();
+          std::size_t r = 0;
+          for (std::size_t j = 0; j < m_n; ++j)
+          {
+            if (group.read[j])
+            {
+              transition.push_back(read_values[r++]);
+            }
+            if (group.meta[j] == access::write || group.meta[j] == access::read_write)
+            {
+              transition.push_back(value_index(j, s1.element_at(j, m_n)));
+            }
+          }
+          group.relation = m_ldd.union_(group.relation, m_ldd.cube(transition));
+        }
+      );
+      data::remove_assignments(m_sigma, group.summand->variables);
+    }
+
+    void learn_transitions(summand_group& group, ldd states)
+    {
+      const ldd projection = m_ldd.minus(m_ldd.project(states, group.read), group.learned);
+      group.learned = m_ldd.union_(group.learned, projection);
+      m_ldd.for_each(projection, [&](const std::vector<std::uint32_t>& read_values)
+        {
+          learn_transitions(group, read_values);
+        }
+      );
+    }
+
+    void garbage_collect(ldd& visited, ldd& todo)
+    {
+      if (m_ldd.size() < 2 * m_collected_size)
+      {
+        return;
+      }
+      std::vector<ldd*> roots = { &visited, &todo };
+      for (summand_group& group: m_groups)
+      {
+        roots.push_back(&group.relation);
+        roots.push_back(&group.learned);
+      }
+      m_ldd.garbage_collect(roots);
+      mCRL2log(log::debug) << "garbage collection reduced the number of LDD nodes to " << m_ldd.size() << std::endl;
+      m_collected_size = std::max(m_ldd.size(), m_collected_size);
+    }
+
+  public:
+    lpsreach_algorithm(const specification& lpsspec, const lpsreach_options& options)
+      : super(lpsspec, options),
+        m_options(options),
+        m_values(m_n)
+    {
+      for (const explorer_summand& summand: m_regular_summands)
+      {
+        compute_dependencies(summand);
+      }
+      for (const explorer_summand& summand: m_confluent_summands)
+      {
+        compute_dependencies(summand);
+      }
+    }
+
+    /// \brief Prints for every summand whether it reads (r), writes (w), or reads and writes (+) each parameter.
+    std::string print_dependencies() const
+    {
+      std::ostringstream out;
+      for (const summand_group& group: m_groups)
+      {
+        for (access a: group.meta)
+        {
+          out << (a == access::copy ? '-' : a == access::read ? 'r' : a == access::write ? 'w' : '+');
+        }
+        out << std::endl;
+      }
+      return out.str();
+    }
+
+    /// \returns The set of reachable states.
+    ldd run()
+    {
+      m_recursive = false;
+      const state s0 = compute_state(m_initial_state);
+      data::add_assignments(m_sigma, m_process_parameters, s0);
+      std::vector<std::uint32_t> initial_state;
+      for (std::size_t j = 0; j < m_n; ++j)
+      {
+        initial_state.push_back(value_index(j, s0.element_at(j, m_n)));
+      }
+
+      ldd visited = m_ldd.cube(initial_state);
+      ldd todo = visited;
+      std::size_t iteration = 0;
+      while (todo != ldd_manager::ldd_false && !m_must_abort)
+      {
+        ldd frontier = todo;
+        ldd next = ldd_manager::ldd_false;
+        for (summand_group& group: m_groups)
+        {
+          learn_transitions(group, frontier);
+          const ldd successors = m_ldd.minus(m_ldd.relational_product(frontier, group.relation, group.meta), visited);
+          visited = m_ldd.union_(visited, successors);
+          next = m_ldd.union_(next, successors);
+          if (m_options.chaining)
+          {
+            frontier = m_ldd.union_(frontier, successors);
+          }
+        }
+        todo = next;
+        garbage_collect(visited, todo);
+
+        mCRL2log(log::verbose) << "explored " << std::fixed << std::setprecision(0) << std::setw(12) << m_ldd.count(visited) << " states after "
+                               << std::setw(4) << ++iteration << " iterations (LDD nodes: " << m_ldd.size() << ")" << std::endl;
+      }
+      return visited;
+    }
+
+    /// \returns The number of states in the given set.
+    double count(ldd states) const
+    {
+      return m_ldd.count(states);
+    }
+
+    /// \returns The number of nodes used to store the sets of states and the transition relations.
+    std::size_t number_of_nodes() const
+    {
+      return m_ldd.size();
+    }
+};
+
+} // namespace mcrl2::lps
+
+#endif // MCRL2_LPS_LPSREACH_H
@@ -19,6 +19,8 @@
 
 #include "mcrl2/atermpp/detail/shared_subset.h"
 #include "mcrl2/data/enumerator_with_iterator.h"
+#include "mcrl2/lps/detail/enumeration_cache.h"
+#include "mcrl2/lps/detail/summand_index.h"
 #include "mcrl2/lps/probabilistic_data_expression.h"
 #include "mcrl2/lps/state.h"
 #include "mcrl2/lps/state_probability_pair.h"
@@ -63,7 +65,7 @@ class next_state_generator
       std::vector<std::size_t> condition_parameters;
       atermpp::function_symbol condition_arguments_function;
       atermpp::aterm_appl condition_arguments_function_dummy;
-      std::map<condition_arguments_t, summand_enumeration_t> enumeration_cache;
+      detail::enumeration_cache enumeration_cache;
     };
 
     struct pruning_tree_node_t
@@ -95,6 +97,7 @@ class next_state_generator
         bool m_use_summand_pruning;
 
         std::vector<std::size_t> m_summands;
+        lps::detail::summand_index m_summand_index; // selects positions in m_summands
 
         pruning_tree_node_t m_pruning_tree;
         std::vector<std::size_t> m_pruning_parameters;
@@ -102,6 +105,7 @@ class next_state_generator
 
         static bool summand_set_contains(const std::set<stochastic_action_summand>& summand_set, const summand_t& summand);
         void build_pruning_parameters(const stochastic_action_summand_vector& summands);
+        void build_summand_index();
         bool is_not_false(const summand_t& summand);
         atermpp::detail::shared_subset<summand_t>::iterator begin(const lps::state& state);
     };
@@ -164,14 +168,15 @@ class next_state_generator
         bool m_single_summand;
         std::size_t m_single_summand_index;
         bool m_use_summand_pruning;
-        std::vector<std::size_t>::iterator m_summand_iterator;
-        std::vector<std::size_t>::iterator m_summand_iterator_end;
+        const std::vector<std::size_t>* m_subset_summands;
+        std::vector<std::size_t>::const_iterator m_summand_iterator;
+        std::vector<std::size_t>::const_iterator m_summand_iterator_end;
         atermpp::detail::shared_subset<summand_t>::iterator m_summand_subset_iterator;
         summand_t *m_summand;
 
         bool m_cached;
-        summand_enumeration_t::iterator m_enumeration_cache_iterator;
-        summand_enumeration_t::iterator m_enumeration_cache_end;
+        detail::enumeration_cache::value_type m_enumeration_cache_solutions;
+        summand_enumeration_t::const_iterator m_enumeration_cache_iterator;
         enumerator_iterator_t m_enumeration_iterator;
         bool m_caching;
         condition_arguments_t m_enumeration_cache_key;
@@ -236,6 +241,7 @@ class next_state_generator
     enumerator_t m_enumerator;
 
     bool m_use_enumeration_caching;
+    bool m_use_summand_index;
 
     data::variable_vector m_process_parameters;
     std::vector<summand_t> m_summands;
@@ -253,14 +259,24 @@ class next_state_generator
     ///        repeatedly.
     /// \param use_enumeration_caching Cache intermediate enumeration results.
     /// \param use_summand_pruning Preprocess summands using pruning strategy.
+    /// \param enumeration_cache_size The number of enumeration results that is cached per summand, where 0 means unbounded.
+    /// \param enumeration_cache_policy The policy that decides which enumeration result is removed from a full cache.
+    /// \param use_summand_index Only try the summands of which the conditions are not falsified by the values of
+    ///        the process parameters. This is not used in combination with summand pruning.
     next_state_generator(const stochastic_specification& spec,
                          const data::rewriter& rewriter,
                          const substitution_t& base_substitution = data::mutable_indexed_substitution<>(),
                          bool use_enumeration_caching = false,
-                         bool use_summand_pruning = false);
+                         bool use_summand_pruning = false,
+                         std::size_t enumeration_cache_size = 0,
+                         utilities::cache_replacement enumeration_cache_policy = utilities::cache_replacement::lru,
+                         bool use_summand_index = true);
 
     ~next_state_generator();
 
+    /// \brief Returns the accumulated statistics of the enumeration caches of all summands.
+    detail::enumeration_cache_statistics enumeration_cache_statistics() const;
+
     /// \brief Returns an iterator for generating the successors of the given state.
     iterator begin(const state& state, enumerator_queue_t* enumeration_queue)
     {
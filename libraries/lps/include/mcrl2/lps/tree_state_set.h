@@ -0,0 +1,214 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/tree_state_set.h
+/// \brief A set of states that is stored using tree compression.
+
+#ifndef MCRL2_LPS_TREE_STATE_SET_H
+#define MCRL2_LPS_TREE_STATE_SET_H
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "mcrl2/lps/state.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/indexed_set.h"
+
+namespace mcrl2
+{
+
+namespace lps
+{
+
+/// \brief A set of states of a fixed length that assigns each state a unique index, like
+///        utilities::indexed_set<state>, but stores the states using tree compression.
+/// \details The parameter values of a state are stored in one table per parameter. A state
+///          is stored as a balanced binary tree over the indices of its parameter values, where
+///          every internal node is a pair of indices that is stored in one table per node of the tree.
+///          Successive states typically differ in a few parameters only, so inserting a new state
+///          usually adds a logarithmic number of pairs, of one machine word each. The index of a
+///          state is the index of its root node. Contrary to indexed_set<state> this does not keep
+///          the terms of the states alive, only the terms of the individual parameter values.
+class tree_state_set
+{
+  protected:
+    std::size_t m_size; // the number of parameters of the states
+    std::vector<utilities::indexed_set<data::data_expression>> m_leaves;
+    std::vector<utilities::indexed_set<std::uint64_t>> m_nodes;
+
+    // Used to store the indices of the parameter values during insert and index.
+    mutable std::vector<std::size_t> m_indices;
+
+    // An empty state is stored as a set with at most one element.
+    bool m_contains_empty_state = false;
+
+    // Both indices of a pair must fit in 32 bits.
+    static std::uint64_t pack(std::size_t left, std::size_t right)
+    {
+      if (left > std::numeric_limits<std::uint32_t>::max() || right > std::numeric_limits<std::uint32_t>::max())
+      {
+        throw mcrl2::runtime_error("The tree compressed state set can contain at most 2^32 different subvectors of a state.");
+      }
+      return (static_cast<std::uint64_t>(left) << 32) | static_cast<std::uint64_t>(right);
+    }
+
+    // Returns the index of the subvector [first, last) of m_indices; node is the number of the
+    // corresponding internal node, where nodes are numbered in preorder.
+    std::pair<std::size_t, bool> insert_node(std::size_t first, std::size_t last, std::size_t& node)
+    {
+      if (last - first == 1)
+      {
+        return { m_indices[first], false };
+      }
+      std::size_t n = node++;
+      std::size_t middle = first + (last - first) / 2;
+      std::size_t left = insert_node(first, middle, node).first;
+      std::size_t right = insert_node(middle, last, node).first;
+      return m_nodes[n].insert(pack(left, right));
+    }
+
+    std::size_t index_node(std::size_t first, std::size_t last, std::size_t& node) const
+    {
+      if (last - first == 1)
+      {
+        return m_indices[first];
+      }
+      std::size_t n = node++;
+      std::size_t middle = first + (last - first) / 2;
+      std::size_t left = index_node(first, middle, node);
+      if (left == npos)
+      {
+        return npos;
+      }
+      std::size_t right = index_node(middle, last, node);
+      if (right == npos)
+      {
+        return npos;
+      }
+      return m_nodes[n].index(pack(left, right));
+    }
+
+    void get_node(std::size_t index, std::size_t first, std::size_t last, std::size_t& node, std::vector<data::data_expression>& result) const
+    {
+      if (last - first == 1)
+      {
+        result[first] = m_leaves[first][index];
+        return;
+      }
+      std::size_t n = node++;
+      std::size_t middle = first + (last - first) / 2;
+      std::uint64_t pair = m_nodes[n][index];
+      get_node(static_cast<std::size_t>(pair >> 32), first, middle, node, result);
+      get_node(static_cast<std::size_t>(pair & std::numeric_limits<std::uint32_t>::max()), middle, last, node, result);
+    }
+
+  public:
+    static constexpr std::size_t npos = utilities::indexed_set<std::uint64_t>::npos;
+
+    /// \brief Constructor.
+    /// \param size The number of parameters of the states in this set.
+    explicit tree_state_set(std::size_t size = 0)
+      : m_size(size),
+        m_leaves(size),
+        m_nodes(size == 0 ? 0 : size - 1),
+        m_indices(size)
+    {}
+
+    /// \brief Inserts the state s.
+    /// \return The index of s, and a boolean that indicates whether s was not already in the set.
+    std::pair<std::size_t, bool> insert(const state& s)
+    {
+      assert(s.size() == m_size);
+      if (m_size == 0)
+      {
+        bool is_new = !m_contains_empty_state;
+        m_contains_empty_state = true;
+        return { 0, is_new };
+      }
+
+      std::size_t i = 0;
+      bool is_new = false;
+      for (const data::data_expression& x: s)
+      {
+        std::pair<std::size_t, bool> p = m_leaves[i].insert(x);
+        m_indices[i++] = p.first;
+        is_new = is_new || p.second;
+      }
+
+      if (m_size == 1)
+      {
+        return { m_indices[0], is_new };
+      }
+      std::size_t node = 0;
+      return insert_node(0, m_size, node);
+    }
+
+    /// \brief Returns the index of the state s, or npos if s is not in the set.
+    std::size_t index(const state& s) const
+    {
+      assert(s.size() == m_size);
+      if (m_size == 0)
+      {
+        return m_contains_empty_state ? 0 : npos;
+      }
+
+      std::size_t i = 0;
+      for (const data::data_expression& x: s)
+      {
+        std::size_t j = m_leaves[i].index(x);
+        if (j == npos)
+        {
+          return npos;
+        }
+        m_indices[i++] = j;
+      }
+
+      std::size_t node = 0;
+      return index_node(0, m_size, node);
+    }
+
+    /// \brief Returns the state with the given index.
+    state operator[](std::size_t index) const
+    {
+      assert(index < size());
+      if (m_size == 0)
+      {
+        return state();
+      }
+      std::vector<data::data_expression> result(m_size);
+      std::size_t node = 0;
+      get_node(index, 0, m_size, node, result);
+      return state(result.begin(), m_size);
+    }
+
+    /// \brief Returns the number of states in the set.
+    std::size_t size() const
+    {
+      if (m_size == 0)
+      {
+        return m_contains_empty_state ? 1 : 0;
+      }
+      if (m_size == 1)
+      {
+        return m_leaves[0].size();
+      }
+      return m_nodes[0].size();
+    }
+
+    /// \brief Returns true if the set is empty.
+    bool empty() const
+    {
+      return size() == 0;
+    }
+};
+
+} // namespace lps
+
+} // namespace mcrl2
+
+#endif // MCRL2_LPS_TREE_STATE_SET_H
@@ -33,6 +33,11 @@
 #include <sstream>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+
+#include "mcrl2/atermpp/shared_guard.h"
 
 // linear process libraries.
 #include "mcrl2/lps/detail/ultimate_delay.h"
@@ -197,6 +202,7 @@ class specification_basic_type
        com, bound, at, name, delta,
        tau, hide, rename, encap */
     mcrl2::data::rewriter rewr; /* The rewriter used while linearising */
+    std::vector < mcrl2::data::rewriter > m_worker_rewriters; /* The rewriters used by the threads that combine summands */
     action terminationAction;   /* A list of length one with the action that denotes termination */
     process_identifier terminatedProcId; /* A process identifier of which the body consists of the termination
                                             action */
@@ -276,6 +282,9 @@ class specification_basic_type
     }
 
   private:
+    /* Parallel compositions with fewer combinations of action summands are calculated by a single thread. */
+    static constexpr std::size_t minimal_parallel_combinations=10000;
+
     data_expression real_zero()
     {
       static data_expression zero=sort_real::creal(sort_int::cint(sort_nat::c0()),sort_pos::c1());
@@ -577,15 +586,22 @@ class specification_basic_type
       return n;
     }
 
+    /// \brief Recreates the rewriters if an equation has been added to the data specification.
+    void update_rewriter()
+    {
+      if (fresh_equation_added)
+      {
+        rewr=rewriter(data,options.rewrite_strategy);
+        m_worker_rewriters.clear();
+        fresh_equation_added=false;
+      }
+    }
+
     data_expression RewriteTerm(const data_expression& t)
     {
       if (!options.norewrite)
       {
-        if (fresh_equation_added)
-        {
-          rewr=rewriter(data,options.rewrite_strategy);
-          fresh_equation_added=false;
-        }
+        update_rewriter();
         return rewr(t);
       }
       return t;
@@ -7545,6 +7561,145 @@ class specification_basic_type
       return false;
     }
 
+    /* The maximal number of multisets in an allow set that is calculated for the operand of a
+       parallel composition or communication operator. Larger allow sets are not used. */
+    static constexpr std::size_t max_operand_allow_set_size=10000;
+
+    /// \brief Insert the multiset of names, sorted alphabetically, in result.
+    /// \details Returns false if result has become larger than max_operand_allow_set_size.
+    bool insert_operand_multiset(
+      std::vector<identifier_string> names,
+      std::set<std::vector<identifier_string> >& result)
+    {
+      if (names.empty())
+      {
+        return true;
+      }
+      std::sort(names.begin(), names.end(),
+                [](const identifier_string& s1, const identifier_string& s2) { return std::string(s1)<std::string(s2); });
+      result.insert(names);
+      return result.size()<=max_operand_allow_set_size;
+    }
+
+    /// \brief Insert all non empty sub multisets of names[i..] extended with current in result.
+    bool insert_sub_multisets(
+      const std::vector<identifier_string>& names,
+      const std::size_t i,
+      std::vector<identifier_string>& current,
+      std::set<std::vector<identifier_string> >& result)
+    {
+      if (i==names.size())
+      {
+        return insert_operand_multiset(current, result);
+      }
+      if (!insert_sub_multisets(names, i+1, current, result))
+      {
+        return false;
+      }
+      current.push_back(names[i]);
+      const bool success=insert_sub_multisets(names, i+1, current, result);
+      current.pop_back();
+      return success;
+    }
+
+    /// \brief Insert all multisets in result that are obtained by replacing names[i..] by the left hand
+    ///        side of a communication with that name as result, or by leaving them as they are.
+    bool insert_communication_inverses(
+      const std::vector<identifier_string>& names,
+      const std::size_t i,
+      const communication_expression_list& communications,
+      const bool sub_multisets,
+      std::vector<identifier_string>& current,
+      std::set<std::vector<identifier_string> >& result)
+    {
+      if (i==names.size())
+      {
+        if (sub_multisets)
+        {
+          std::vector<identifier_string> empty;
+          return insert_sub_multisets(current, 0, empty, result);
+        }
+        return insert_operand_multiset(current, result);
+      }
+
+      const std::size_t size=current.size();
+      current.push_back(names[i]);
+      if (!insert_communication_inverses(names, i+1, communications, sub_multisets, current, result))
+      {
+        return false;
+      }
+      current.resize(size);
+      for (const communication_expression& c: communications)
+      {
+        if (c.name()==names[i])
+        {
+          current.insert(current.end(), c.action_name().names().begin(), c.action_name().names().end());
+          if (!insert_communication_inverses(names, i+1, communications, sub_multisets, current, result))
+          {
+            return false;
+          }
+          current.resize(size);
+        }
+      }
+      return true;
+    }
+
+    /// \brief Calculates an allow set for the operand of a communication operator or parallel composition
+    ///        that occurs within allow(allowlist, comm(communications, _)).
+    /// \details A multi action of the operand of which the names do not occur in the result can never
+    ///          become a multi action that is allowed by allowlist, so it can be removed from the operand.
+    ///          If sub_multisets is true the operand is merged with other processes, so a multi action
+    ///          of the operand is only required to be part of such an allowed multi action.
+    ///          Communications may be empty. Returns false if the allow set would become too large to be useful.
+    bool operand_allow_set(
+      const action_name_multiset_list& allowlist,
+      const communication_expression_list& communications,
+      const bool sub_multisets,
+      action_name_multiset_list& result)
+    {
+      std::set<std::vector<identifier_string> > multisets;
+      for (const action_name_multiset& m: allowlist)
+      {
+        const std::vector<identifier_string> names(m.names().begin(), m.names().end());
+        std::vector<identifier_string> current;
+        if (!insert_communication_inverses(names, 0, communications, sub_multisets, current, multisets))
+        {
+          return false;
+        }
+      }
+
+      result=action_name_multiset_list();
+      for (const std::vector<identifier_string>& names: multisets)
+      {
+        result.push_front(action_name_multiset(identifier_string_list(names.begin(), names.end())));
+      }
+      return true;
+    }
+
+    /// \brief Calculates a block set for the operand of a communication operator or parallel composition
+    ///        that occurs within block(blocklist, comm(communications, _)).
+    /// \details Only the actions that do not occur in the left hand side of a communication can be
+    ///          blocked before the communications are applied.
+    identifier_string_list operand_block_set(
+      const identifier_string_list& blocklist,
+      const communication_expression_list& communications)
+    {
+      identifier_string_list result;
+      for (const identifier_string& a: blocklist)
+      {
+        if (std::none_of(communications.begin(), communications.end(),
+                         [&a](const communication_expression& c)
+                         {
+                           const identifier_string_list& names=c.action_name().names();
+                           return std::find(names.begin(), names.end(), a)!=names.end();
+                         }))
+        {
+          result.push_front(a);
+        }
+      }
+      return reverse(result);
+    }
+
     void allowblockcomposition(
       const action_name_multiset_list& allowlist1,  // This is a list of list of identifierstring.
       const bool is_allow,
@@ -8944,102 +9099,177 @@ class specification_basic_type
 
 
 
-    void calculate_communication_merge_action_summands(
-          const stochastic_action_summand_vector& action_summands1,
+    /// \brief Adds the combinations of summand1 with the summands in action_summands2 that are not removed
+    ///        by the allow or block set to action_summands, using rewriter to rewrite their conditions.
+    void combine_action_summand(
+          const stochastic_action_summand& summand1,
           const stochastic_action_summand_vector& action_summands2,
           const action_name_multiset_list& allowlist,   // This is a list of list of identifierstring.
           const bool is_allow,                          // If is_allow or is_block is set, perform inline allow/block filtering.
           const bool is_block,
+          mcrl2::data::rewriter& rewriter,
           stochastic_action_summand_vector& action_summands)
     {
-      // First combine the action summands.
-      for (const stochastic_action_summand& summand1: action_summands1)
+      const variable_list& sumvars1=summand1.summation_variables();
+      const action_list multiaction1=summand1.multi_action().actions();
+      const data_expression actiontime1=summand1.multi_action().time();
+      const data_expression& condition1=summand1.condition();
+      const assignment_list& nextstate1=summand1.assignments();
+      const stochastic_distribution& distribution1=summand1.distribution();
+
+      for (const stochastic_action_summand& summand2: action_summands2)
       {
-        const variable_list& sumvars1=summand1.summation_variables();
-        const action_list multiaction1=summand1.multi_action().actions();
-        const data_expression actiontime1=summand1.multi_action().time();
-        const data_expression& condition1=summand1.condition();
-        const assignment_list& nextstate1=summand1.assignments();
-        const stochastic_distribution& distribution1=summand1.distribution();
+        const variable_list& sumvars2=summand2.summation_variables();
+        const action_list multiaction2=summand2.multi_action().actions();
+        const data_expression actiontime2=summand2.multi_action().time();
+        const data_expression& condition2=summand2.condition();
+        const assignment_list& nextstate2=summand2.assignments();
+        const stochastic_distribution& distribution2=summand2.distribution();
 
-        for (const stochastic_action_summand& summand2: action_summands2)
+        if ((multiaction1 == action_list({ terminationAction })) == (multiaction2 == action_list({ terminationAction })))
         {
-          const variable_list& sumvars2=summand2.summation_variables();
-          const action_list multiaction2=summand2.multi_action().actions();
-          const data_expression actiontime2=summand2.multi_action().time();
-          const data_expression& condition2=summand2.condition();
-          const assignment_list& nextstate2=summand2.assignments();
-          const stochastic_distribution& distribution2=summand2.distribution();
+          action_list multiaction3;
+          if ((multiaction1 == action_list({ terminationAction })) && (multiaction2 == action_list({ terminationAction })))
+          {
+            multiaction3.push_front(terminationAction);
+          }
+          else
+          {
+            multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
+          }
 
-          if ((multiaction1 == action_list({ terminationAction })) == (multiaction2 == action_list({ terminationAction })))
+          if (is_allow && !allow_(allowlist,multiaction3))
           {
-            action_list multiaction3;
-            if ((multiaction1 == action_list({ terminationAction })) && (multiaction2 == action_list({ terminationAction })))
-            {
-              multiaction3.push_front(terminationAction);
-            }
-            else
-            {
-              multiaction3=linMergeMultiActionList(multiaction1,multiaction2);
-            }
+            continue;
+          }
+          if (is_block && encap(allowlist,multiaction3))
+          {
+            continue;
+          }
 
-            if (is_allow && !allow_(allowlist,multiaction3))
-            {
-              continue;
-            }
-            if (is_block && encap(allowlist,multiaction3))
+          const variable_list allsums=sumvars1+sumvars2;
+          data_expression condition3= lazy::and_(condition1,condition2);
+          data_expression action_time3;
+          bool has_time3=summand1.has_time()||summand2.has_time();
+
+          if (!summand1.has_time())
+          {
+            if (summand2.has_time())
             {
-              continue;
+              /* summand 2 has time*/
+              action_time3=actiontime2;
             }
-
-            const variable_list allsums=sumvars1+sumvars2;
-            data_expression condition3= lazy::and_(condition1,condition2);
-            data_expression action_time3;
-            bool has_time3=summand1.has_time()||summand2.has_time();
-
-            if (!summand1.has_time())
+          }
+          else
+          {
+            /* summand 1 has time */
+            if (!summand2.has_time())
             {
-              if (summand2.has_time())
-              {
-                /* summand 2 has time*/
-                action_time3=actiontime2;
-              }
+              action_time3=actiontime1;
             }
             else
             {
-              /* summand 1 has time */
-              if (!summand2.has_time())
-              {
-                action_time3=actiontime1;
-              }
-              else
-              {
-                /* both summand 1 and 2 have time */
-                action_time3=actiontime1;
-                condition3=lazy::and_(
-                             condition3,
-                             equal_to(actiontime1,actiontime2));
-              }
+              /* both summand 1 and 2 have time */
+              action_time3=actiontime1;
+              condition3=lazy::and_(
+                           condition3,
+                           equal_to(actiontime1,actiontime2));
             }
+          }
+
+          const assignment_list nextstate3=nextstate1+nextstate2;
+          const stochastic_distribution distribution3(
+                                            distribution1.variables()+distribution2.variables(),
+                                            real_times_optimized(distribution1.distribution(),distribution2.distribution()));
+
+          if (!options.norewrite)
+          {
+            condition3=rewriter(condition3);
+          }
+          if (condition3!=sort_bool::false_())
+          {
+            action_summands.push_back(stochastic_action_summand(
+                                         allsums,
+                                         condition3,
+                                         has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
+                                         nextstate3,
+                                         distribution3));
+          }
+        }
+      }
+    }
 
-            const assignment_list nextstate3=nextstate1+nextstate2;
-            const stochastic_distribution distribution3(
-                                              distribution1.variables()+distribution2.variables(),
-                                              real_times_optimized(distribution1.distribution(),distribution2.distribution()));
+    void calculate_communication_merge_action_summands(
+          const stochastic_action_summand_vector& action_summands1,
+          const stochastic_action_summand_vector& action_summands2,
+          const action_name_multiset_list& allowlist,   // This is a list of list of identifierstring.
+          const bool is_allow,                          // If is_allow or is_block is set, perform inline allow/block filtering.
+          const bool is_block,
+          stochastic_action_summand_vector& action_summands)
+    {
+      update_rewriter();
+      const std::size_t number_of_threads=(atermpp::detail::GlobalThreadSafe &&
+                                           action_summands1.size()*action_summands2.size()>=minimal_parallel_combinations)?
+                                             std::min(options.number_of_threads,action_summands1.size()):1;
+      if (number_of_threads<=1)
+      {
+        for (const stochastic_action_summand& summand1: action_summands1)
+        {
+          combine_action_summand(summand1, action_summands2, allowlist, is_allow, is_block, rewr, action_summands);
+        }
+        return;
+      }
 
-            condition3=RewriteTerm(condition3);
-            if (condition3!=sort_bool::false_())
+      // Every thread repeatedly takes the next summand of action_summands1 and combines it with all summands in
+      // action_summands2, using its own clone of the rewriter. The results are stored per summand, such that the
+      // resulting summands occur in the same order as when they are calculated sequentially.
+      while (m_worker_rewriters.size()<number_of_threads)
+      {
+        m_worker_rewriters.push_back(rewr.clone());
+      }
+      std::vector<stochastic_action_summand_vector> results(action_summands1.size());
+      std::atomic<std::size_t> next_summand(0);
+      std::vector<std::exception_ptr> exceptions(number_of_threads);
+      std::vector<std::thread> threads;
+      for (std::size_t i=0; i<number_of_threads; ++i)
+      {
+        threads.emplace_back([&, i]()
+        {
+          try
+          {
+            for (std::size_t j=next_summand++; j<action_summands1.size(); j=next_summand++)
             {
-              action_summands.push_back(stochastic_action_summand(
-                                           allsums,
-                                           condition3,
-                                           has_time3?multi_action(multiaction3,action_time3):multi_action(multiaction3),
-                                           nextstate3,
-                                           distribution3));
+              // Terms are only created and rewritten while holding the guard. It is released after every
+              // summand, such that a garbage collection does not have to wait until all summands are combined.
+              atermpp::shared_guard guard;
+              combine_action_summand(action_summands1[j], action_summands2, allowlist, is_allow, is_block,
+                                     m_worker_rewriters[i], results[j]);
             }
           }
+          catch (...)
+          {
+            exceptions[i]=std::current_exception();
+            next_summand=action_summands1.size();
+          }
+        });
+      }
+      for (std::thread& thread: threads)
+      {
+        thread.join();
+      }
+      for (const std::exception_ptr& exception: exceptions)
+      {
+        if (exception)
+        {
+          std::rethrow_exception(exception);
         }
       }
+
+      for (stochastic_action_summand_vector& result: results)
+      {
+        action_summands.insert(action_summands.end(), result.begin(), result.end());
+        stochastic_action_summand_vector().swap(result);
+      }
     }
 
     void calculate_communication_merge_action_deadlock_summands(
@@ -9435,9 +9665,20 @@ class specification_basic_type
           stochastic_action_summand_vector action_summands1, action_summands2;
           deadlock_summand_vector deadlock_summands1, deadlock_summands2;
           lps::detail::ultimate_delay ultimate_delay_condition1, ultimate_delay_condition2;
-          generateLPEmCRLterm(action_summands1,deadlock_summands1,process::merge(par).left(),
+          // Multi actions of operands that are parallel compositions themselves are already removed while
+          // they are calculated, if they are not part of an allowed multi action.
+          process_expression left=process::merge(par).left();
+          process_expression right=process::merge(par).right();
+          action_name_multiset_list operand_allowlist;
+          if ((is_merge(left) || is_merge(right)) &&
+              operand_allow_set(allow(t).allow_set(),communication_expression_list(),true,operand_allowlist))
+          {
+            left=is_merge(left)?process_expression(allow(operand_allowlist,left)):left;
+            right=is_merge(right)?process_expression(allow(operand_allowlist,right)):right;
+          }
+          generateLPEmCRLterm(action_summands1,deadlock_summands1,left,
                                 regular,rename_variables,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1);
-          generateLPEmCRLterm(action_summands2,deadlock_summands2,process::merge(par).right(),
+          generateLPEmCRLterm(action_summands2,deadlock_summands2,right,
                                 regular,true,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2);
           parallelcomposition(action_summands1,deadlock_summands1,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1,
                                 action_summands2,deadlock_summands2,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2,
@@ -9447,7 +9688,16 @@ class specification_basic_type
         }
         else if (!options.nodeltaelimination && options.ignore_time && is_comm(par))
         {
-          generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
+          // A parallel composition below the communication operator only needs to generate the multi actions
+          // that can become allowed by applying the communications.
+          process_expression operand=comm(par).operand();
+          action_name_multiset_list operand_allowlist;
+          if (is_merge(operand) &&
+              operand_allow_set(allow(t).allow_set(),comm(par).comm_set(),false,operand_allowlist))
+          {
+            operand=allow(operand_allowlist,operand);
+          }
+          generateLPEmCRLterm(action_summands,deadlock_summands,operand,
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
           communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands);
           return;
@@ -9470,9 +9720,14 @@ class specification_basic_type
           stochastic_action_summand_vector action_summands1, action_summands2;
           deadlock_summand_vector deadlock_summands1, deadlock_summands2;
           lps::detail::ultimate_delay ultimate_delay_condition1, ultimate_delay_condition2;
-          generateLPEmCRLterm(action_summands1,deadlock_summands1,process::merge(par).left(),
+          // Operands that are parallel compositions themselves are calculated modulo the same block set.
+          process_expression left=process::merge(par).left();
+          process_expression right=process::merge(par).right();
+          left=is_merge(left)?process_expression(block(block(t).block_set(),left)):left;
+          right=is_merge(right)?process_expression(block(block(t).block_set(),right)):right;
+          generateLPEmCRLterm(action_summands1,deadlock_summands1,left,
                                 regular,rename_variables,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1);
-          generateLPEmCRLterm(action_summands2,deadlock_summands2,process::merge(par).right(),
+          generateLPEmCRLterm(action_summands2,deadlock_summands2,right,
                                 regular,true,pars2,init2,initial_stochastic_distribution2,ultimate_delay_condition2);
           // Encode the actions of the block list in one multi action.
           parallelcomposition(action_summands1,deadlock_summands1,pars1,init1,initial_stochastic_distribution1,ultimate_delay_condition1,
@@ -9483,7 +9738,15 @@ class specification_basic_type
         }
         else if (!options.nodeltaelimination && options.ignore_time && is_comm(par))
         {
-          generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
+          // Actions that do not take part in a communication can already be blocked in a parallel
+          // composition below the communication operator.
+          process_expression operand=comm(par).operand();
+          const identifier_string_list operand_blocklist=operand_block_set(block(t).block_set(),comm(par).comm_set());
+          if (is_merge(operand) && !operand_blocklist.empty())
+          {
+            operand=block(operand_blocklist,operand);
+          }
+          generateLPEmCRLterm(action_summands,deadlock_summands,operand,
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
           // Encode the actions of the block list in one multi action.
           communicationcomposition(comm(par).comm_set(),action_name_multiset_list( { action_name_multiset(block(t).block_set())} ),
@@ -60,13 +60,17 @@ next_state_generator::next_state_generator(
   const data::rewriter& rewriter,
   const substitution_t& base_substitution,
   bool use_enumeration_caching,
-  bool use_summand_pruning)
+  bool use_summand_pruning,
+  std::size_t enumeration_cache_size,
+  utilities::cache_replacement enumeration_cache_policy,
+  bool use_summand_index)
   : m_specification(spec),
     m_rewriter(rewriter),
     m_substitution(base_substitution),
     m_base_substitution(base_substitution),
     m_enumerator(m_rewriter, m_specification.data(), m_rewriter, m_id_generator, (std::numeric_limits<std::size_t>::max)(),true),  // Generate exceptions.
-    m_use_enumeration_caching(use_enumeration_caching)
+    m_use_enumeration_caching(use_enumeration_caching),
+    m_use_summand_index(use_summand_index)
 {
   m_process_parameters = data::variable_vector(m_specification.process().process_parameters().begin(), m_specification.process().process_parameters().end());
 
@@ -113,6 +117,7 @@ next_state_generator::next_state_generator(
     summand.condition_arguments_function = atermpp::function_symbol("condition_arguments", summand.condition_parameters.size());
     std::vector<atermpp::aterm_int> dummy(summand.condition_arguments_function.arity(), atermpp::aterm_int(static_cast<std::size_t>(0)));
     summand.condition_arguments_function_dummy = atermpp::aterm_appl(summand.condition_arguments_function, dummy.begin(), dummy.end());
+    summand.enumeration_cache = lps::detail::enumeration_cache(enumeration_cache_size, enumeration_cache_policy);
 
     m_summands.push_back(summand);
   }
@@ -131,6 +136,16 @@ next_state_generator::next_state_generator(
 next_state_generator::~next_state_generator()
 {}
 
+lps::detail::enumeration_cache_statistics next_state_generator::enumeration_cache_statistics() const
+{
+  lps::detail::enumeration_cache_statistics result;
+  for (const summand_t& summand: m_summands)
+  {
+    result.add(summand.enumeration_cache);
+  }
+  return result;
+}
+
 next_state_generator::summand_subset_t::summand_subset_t(next_state_generator *generator, bool use_summand_pruning)
   : m_generator(generator),
     m_use_summand_pruning(use_summand_pruning)
@@ -146,6 +161,7 @@ next_state_generator::summand_subset_t::summand_subset_t(next_state_generator *g
     {
       m_summands.push_back(i);
     }
+    build_summand_index();
   }
 }
 
@@ -184,7 +200,31 @@ next_state_generator::summand_subset_t::summand_subset_t(
         m_summands.push_back(i);
       }
     }
+    build_summand_index();
+  }
+}
+
+// The summation variables and the condition of a summand, from which the summand index is computed.
+struct summand_guard
+{
+  data::variable_list variables;
+  data::data_expression condition;
+};
+
+void next_state_generator::summand_subset_t::build_summand_index()
+{
+  if (!m_generator->m_use_summand_index)
+  {
+    m_summand_index = lps::detail::summand_index(m_summands.size());
+    return;
+  }
+  std::vector<summand_guard> guards;
+  for (std::size_t i: m_summands)
+  {
+    guards.push_back(summand_guard{m_generator->m_summands[i].variables, m_generator->m_summands[i].condition});
   }
+  m_summand_index = lps::detail::summand_index(guards, m_generator->m_process_parameters, m_generator->m_specification.data(),
+                                               m_generator->m_rewriter, m_generator->m_base_substitution);
 }
 
 static float condition_selectivity(const data_expression& e, const variable& v)
@@ -346,8 +386,10 @@ next_state_generator::iterator::iterator(
   }
   else
   {
-    m_summand_iterator = summand_subset.m_summands.begin();
-    m_summand_iterator_end = summand_subset.m_summands.end();
+    const std::vector<std::size_t>& candidates = summand_subset.m_summand_index.candidates(state, generator->m_process_parameters.size());
+    m_subset_summands = &summand_subset.m_summands;
+    m_summand_iterator = candidates.begin();
+    m_summand_iterator_end = candidates.end();
   }
 
   std::size_t j=0;
@@ -468,7 +510,7 @@ const next_state_generator::transition_t::state_probability_list next_state_gene
 void next_state_generator::iterator::increment()
 {
   while (!m_summand ||
-         (m_cached && m_enumeration_cache_iterator == m_enumeration_cache_end) ||
+         (m_cached && m_enumeration_cache_iterator == m_enumeration_cache_solutions->end()) ||
          (!m_cached && m_enumeration_iterator == m_generator->m_enumerator.end())
         )
   {
@@ -478,7 +520,7 @@ void next_state_generator::iterator::increment()
     m_generator->m_id_generator.clear();
     if (m_caching)
     {
-      m_summand->enumeration_cache[m_enumeration_cache_key] = m_enumeration_log;
+      m_summand->enumeration_cache.insert(m_enumeration_cache_key, m_enumeration_log);
     }
 
     if (m_single_summand)
@@ -506,7 +548,7 @@ void next_state_generator::iterator::increment()
         m_generator = nullptr;
         return;
       }
-      m_summand = &(m_generator->m_summands[*m_summand_iterator++]);
+      m_summand = &(m_generator->m_summands[(*m_subset_summands)[*m_summand_iterator++]]);
     }
 
     if (m_generator->m_use_enumeration_caching)
@@ -517,8 +559,10 @@ void next_state_generator::iterator::increment()
                                                       m_summand->condition_parameters.end(),
                                                       apply_m_state);
 
-      std::map<condition_arguments_t, summand_enumeration_t>::iterator position = m_summand->enumeration_cache.find(m_enumeration_cache_key);
-      if (position == m_summand->enumeration_cache.end())
+      // The solutions are shared with the cache, such that they remain valid when they are removed from the
+      // cache by another iterator.
+      m_enumeration_cache_solutions = m_summand->enumeration_cache.find(m_enumeration_cache_key);
+      if (!m_enumeration_cache_solutions)
       {
         m_cached = false;
         m_caching = true;
@@ -528,8 +572,7 @@ void next_state_generator::iterator::increment()
       {
         m_cached = true;
         m_caching = false;
-        m_enumeration_cache_iterator = position->second.begin();
-        m_enumeration_cache_end = position->second.end();
+        m_enumeration_cache_iterator = m_enumeration_cache_solutions->begin();
       }
     }
     else
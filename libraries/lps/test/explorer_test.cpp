@@ -0,0 +1,82 @@
+// Author(s): mCRL2 team
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file explorer_test.cpp
+/// \brief Tests for the explicit state space exploration.
+
+#define BOOST_TEST_MODULE explorer_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <set>
+#include <tuple>
+#include "mcrl2/data/detail/rewrite_strategies.h"
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lps/linearise.h"
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+typedef std::set<std::tuple<state, process::timed_multi_action, state>> transition_set;
+
+static transition_set generate_transitions(const specification& spec, const explorer_options& options)
+{
+  transition_set result;
+  explorer<false, false, specification> explorer(spec, options);
+  explorer.generate_state_space(false,
+    utilities::skip(),
+    [&](const state& s, std::size_t, const process::timed_multi_action& a, const state& s1, std::size_t, std::size_t)
+    {
+      result.insert(std::make_tuple(s, a, s1));
+    }
+  );
+  return result;
+}
+
+static const std::string SPEC =
+  "act a: Nat;\n"
+  "    b, c;\n"
+  "proc P(i, j: Nat) = sum n: Nat. (n < 3) -> a(n).P((i + n) mod 11, j)\n"
+  "                  + (j < 7) -> b.P(i, j + 1)\n"
+  "                  + (j == 7) -> c.P(i, 0);\n"
+  "init P(0, 0);\n";
+
+BOOST_AUTO_TEST_CASE(test_explorer)
+{
+  const specification spec = remove_stochastic_operators(linearise(SPEC));
+  for (data::rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    explorer_options options;
+    options.rewrite_strategy = strategy;
+    options.search_strategy = es_breadth;
+    const transition_set transitions = generate_transitions(spec, options);
+    BOOST_CHECK_EQUAL(transitions.size(), 11u * 8u * 4u);
+  }
+}
+
+#ifdef MCRL2_ENABLE_MULTITHREADING
+// The workers of a parallel exploration use clones of the rewriter of the explorer, and copies of its summands.
+// Their results must be the same as those of a sequential exploration, also when the enumeration is cached.
+BOOST_AUTO_TEST_CASE(test_parallel_explorer)
+{
+  const specification spec = remove_stochastic_operators(linearise(SPEC));
+  for (data::rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    for (bool cached: { false, true })
+    {
+      explorer_options options;
+      options.rewrite_strategy = strategy;
+      options.search_strategy = es_breadth;
+      options.cached = cached;
+      const transition_set expected = generate_transitions(spec, options);
+
+      options.number_of_threads = 4;
+      BOOST_CHECK(generate_transitions(spec, options) == expected);
+    }
+  }
+}
+#endif // MCRL2_ENABLE_MULTITHREADING
@@ -186,6 +186,70 @@ BOOST_AUTO_TEST_CASE(linearisation_of_the_enclosed_spec_caused_a_name_conflict_w
   run_linearisation_test_case(spec,true);
 } 
 
+// The allow and block sets are also applied to the parallel compositions below a communication operator,
+// and to nested parallel compositions, which must not remove multi actions that can still be allowed.
+BOOST_AUTO_TEST_CASE(allow_and_block_within_nested_parallel_compositions)
+{
+  const std::string spec =
+    "act a,b,c,d,e;\n"
+    "proc P = a.d.P;\n"
+    "     Q = b.e.Q;\n"
+    "     R = a.b.R;\n"
+    "init allow({c, d|e, e}, comm({a|b -> c}, P || Q || R));\n";
+
+  t_lin_options options;
+  options.ignore_time=true;
+  lps::stochastic_specification s=linearise(spec, options);
+  std::set<std::string> multi_actions;
+  for (const lps::stochastic_action_summand& summand: s.process().action_summands())
+  {
+    multi_actions.insert(process::pp(summand.multi_action().actions()));
+  }
+  BOOST_CHECK(multi_actions == std::set<std::string>({ "c", "d, e", "e" }));
+
+  const std::string spec2 =
+    "act a,b,c,d,e;\n"
+    "proc P = a.d.P;\n"
+    "     Q = b.e.Q;\n"
+    "     R = a.b.R;\n"
+    "init block({a, b, d}, comm({a|b -> c}, P || Q || R));\n";
+  s=linearise(spec2, options);
+  multi_actions.clear();
+  for (const lps::stochastic_action_summand& summand: s.process().action_summands())
+  {
+    multi_actions.insert(process::pp(summand.multi_action().actions()));
+  }
+  BOOST_CHECK(multi_actions == std::set<std::string>({ "c", "c, e", "e" }));
+}
+
+#ifdef MCRL2_ENABLE_MULTITHREADING
+// The summands of large parallel compositions are combined by several threads, which must give the same
+// linear process as combining them sequentially.
+BOOST_AUTO_TEST_CASE(parallel_combination_of_summands)
+{
+  std::string P = "P(n: Nat) = delta";
+  std::string Q = "Q(m: Nat) = delta";
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    const std::string k = std::to_string(i);
+    P += "\n     + (n mod 2 == " + k + " mod 2) -> a(" + k + ").P((n + " + k + ") mod 5)";
+    Q += "\n     + (m mod 3 == " + k + " mod 3) -> b(" + k + ").Q((m + " + k + ") mod 7)";
+  }
+  const std::string spec =
+    "act a, b: Nat;\n"
+    "proc " + P + ";\n"
+    "     " + Q + ";\n"
+    "init P(0) || Q(0);\n";
+
+  t_lin_options options;
+  const lps::stochastic_specification expected = linearise(spec, options);
+  BOOST_CHECK_GE(expected.process().action_summands().size(), 100u * 100u);
+  options.number_of_threads = 4;
+  const lps::stochastic_specification result = linearise(spec, options);
+  BOOST_CHECK_EQUAL(lps::pp(result), lps::pp(expected));
+}
+#endif // MCRL2_ENABLE_MULTITHREADING
+
 #else // ndef MCRL2_SKIP_LONG_TESTS
 
 BOOST_AUTO_TEST_CASE(skip_linearization_test)
@@ -0,0 +1,138 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lpsreach_test.cpp
+/// \brief Tests for list decision diagrams and the symbolic computation of reachable states.
+
+#define BOOST_TEST_MODULE lpsreach_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include <set>
+#include "mcrl2/lps/linearise.h"
+#include "mcrl2/lps/lpsreach.h"
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+typedef ldd_manager::ldd ldd;
+typedef std::vector<std::uint32_t> vector;
+
+static std::set<vector> elements(const ldd_manager& manager, ldd x)
+{
+  std::set<vector> result;
+  manager.for_each(x, [&](const vector& v) { result.insert(v); });
+  return result;
+}
+
+static ldd make_set(ldd_manager& manager, const std::set<vector>& vectors)
+{
+  ldd result = ldd_manager::ldd_false;
+  for (const vector& v: vectors)
+  {
+    result = manager.union_(result, manager.cube(v));
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_set_operations)
+{
+  ldd_manager manager;
+  const std::set<vector> A = { {0, 1, 2}, {0, 2, 2}, {1, 1, 1}, {3, 0, 0} };
+  const std::set<vector> B = { {0, 2, 2}, {1, 1, 0}, {3, 0, 0}, {4, 4, 4} };
+
+  const ldd a = make_set(manager, A);
+  const ldd b = make_set(manager, B);
+  BOOST_CHECK(elements(manager, a) == A);
+  BOOST_CHECK_EQUAL(manager.count(a), 4.0);
+
+  std::set<vector> AB = A;
+  AB.insert(B.begin(), B.end());
+  BOOST_CHECK(elements(manager, manager.union_(a, b)) == AB);
+  BOOST_CHECK(manager.union_(a, b) == manager.union_(b, a));
+  BOOST_CHECK(make_set(manager, AB) == manager.union_(a, b));
+
+  std::set<vector> A_B = { {0, 1, 2}, {1, 1, 1} };
+  BOOST_CHECK(elements(manager, manager.minus(a, b)) == A_B);
+  BOOST_CHECK(manager.minus(a, a) == ldd_manager::ldd_false);
+
+  const std::set<vector> projection = { {0, 2}, {1, 1}, {3, 0} };
+  BOOST_CHECK(elements(manager, manager.project(a, { true, false, true })) == projection);
+  BOOST_CHECK(manager.project(a, { false, false, false }) == ldd_manager::ldd_true);
+
+  // Garbage collection keeps the roots, and their canonical representation.
+  ldd c = manager.minus(a, b);
+  ldd d = manager.union_(a, b);
+  manager.garbage_collect({ &c, &d });
+  BOOST_CHECK(elements(manager, c) == A_B);
+  BOOST_CHECK(elements(manager, d) == AB);
+  BOOST_CHECK(make_set(manager, AB) == d);
+}
+
+BOOST_AUTO_TEST_CASE(test_relational_product)
+{
+  typedef ldd_manager::access access;
+  ldd_manager manager;
+  const ldd states = make_set(manager, { {0, 0, 5}, {1, 0, 6}, {2, 1, 7} });
+
+  // x0 := x0 + 1 if x0 < 2, where x1 is written with 3, and x2 is copied.
+  const ldd relation = make_set(manager, { {0, 1, 3}, {1, 2, 3} });
+  const std::vector<access> meta = { access::read_write, access::write, access::copy };
+  const std::set<vector> successors = { {1, 3, 5}, {2, 3, 6} };
+  BOOST_CHECK(elements(manager, manager.relational_product(states, relation, meta)) == successors);
+
+  // A guard on x1 that is only read.
+  const ldd guard = make_set(manager, { {1} });
+  const std::vector<access> guard_meta = { access::copy, access::read, access::copy };
+  const std::set<vector> enabled = { {2, 1, 7} };
+  BOOST_CHECK(elements(manager, manager.relational_product(states, guard, guard_meta)) == enabled);
+}
+
+static std::size_t explicit_number_of_states(const specification& spec)
+{
+  explorer_options options;
+  options.search_strategy = es_breadth;
+  explorer<false, false, specification> explorer(spec, options);
+  explorer.generate_state_space(false);
+  return explorer.state_map().size();
+}
+
+static void check_lpsreach(const std::string& text)
+{
+  const specification spec = remove_stochastic_operators(linearise(text));
+  const std::size_t expected = explicit_number_of_states(spec);
+  for (bool chaining: { false, true })
+  {
+    lpsreach_options options;
+    options.chaining = chaining;
+    lpsreach_algorithm algorithm(spec, options);
+    BOOST_CHECK_EQUAL(algorithm.count(algorithm.run()), static_cast<double>(expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_lpsreach)
+{
+  check_lpsreach(
+    "act a, b;\n"
+    "proc P(i: Nat, j: Bool) = (i < 10) -> a.P(i + 1, !j) + j -> b.P(0, j);\n"
+    "init P(0, false);\n");
+
+  check_lpsreach(
+    "act a: Nat;\n"
+    "    b;\n"
+    "proc P(i, j: Nat) = sum n: Nat. (n < 3) -> a(n).P((i + n) mod 7, j)\n"
+    "                  + (j < 5) -> b.P(i, j + 1)\n"
+    "                  + (j == 5) -> b.P(i, 0);\n"
+    "init P(0, 0);\n");
+
+  check_lpsreach(
+    "sort D = struct d1 | d2;\n"
+    "act r, s: D;\n"
+    "proc P(b: Bool, d: D, k: Nat) = sum e: D. !b -> r(e).P(true, e, k)\n"
+    "                              + b -> s(d).P(false, d1, (k + 1) mod 3);\n"
+    "init P(false, d1, 0);\n");
+}
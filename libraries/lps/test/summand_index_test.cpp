@@ -0,0 +1,109 @@
+// Author(s): Wieger Wesselink
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file summand_index_test.cpp
+/// \brief Tests for the summand index.
+
+#define BOOST_TEST_MODULE summand_index_test
+#include <boost/test/included/unit_test_framework.hpp>
+#include "mcrl2/data/parse.h"
+#include "mcrl2/data/rewriter.h"
+#include "mcrl2/lps/detail/summand_index.h"
+#include "mcrl2/lps/parse.h"
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+struct summand_guard
+{
+  data::variable_list variables;
+  data::data_expression condition;
+};
+
+BOOST_AUTO_TEST_CASE(test_summand_index)
+{
+  std::string text =
+    "act a, c1, c2, d, e;                         \n"
+    "proc P(s: Pos, b: Bool) =                    \n"
+    "       (s == 1) -> a . P(s = 2)              \n"
+    "     + (s == 2 && b) -> c1 . P(s = 3, b = false) \n"
+    "     + (s == 2 && !b) -> c2 . P(s = 1)       \n"
+    "     + (3 == s) -> d . P(s = 1, b = true)    \n"
+    "     + sum n: Pos . (n == s) -> e . P()      \n"
+    "     + delta;                                \n"
+    "init P(1, true);                             \n"
+    ;
+  specification lpsspec = parse_linear_process_specification(text);
+  data::rewriter r(lpsspec.data());
+  data::rewriter::substitution_type sigma;
+
+  std::vector<summand_guard> guards;
+  for (const action_summand& summand: lpsspec.process().action_summands())
+  {
+    guards.push_back(summand_guard{summand.summation_variables(), summand.condition()});
+  }
+  const data::variable_list& parameters = lpsspec.process().process_parameters();
+  detail::summand_index index(guards, std::vector<data::variable>(parameters.begin(), parameters.end()), lpsspec.data(), r, sigma);
+
+  auto candidates = [&](std::size_t s, bool b)
+  {
+    std::vector<data::data_expression> values = { r(data::sort_pos::pos(s)), b ? data::sort_bool::true_() : data::sort_bool::false_() };
+    return index.candidates(state(values.begin(), 2), 2);
+  };
+
+  // The last summand does not have a condition of the form parameter = value.
+  BOOST_CHECK(candidates(1, true) == std::vector<std::size_t>({0, 4}));
+  BOOST_CHECK(candidates(2, true) == std::vector<std::size_t>({1, 4}));
+  BOOST_CHECK(candidates(2, false) == std::vector<std::size_t>({2, 4}));
+  BOOST_CHECK(candidates(3, false) == std::vector<std::size_t>({3, 4}));
+  BOOST_CHECK(candidates(4, true) == std::vector<std::size_t>({4}));
+
+  detail::summand_index all(guards.size());
+  BOOST_CHECK(all.candidates(state(), 0) == std::vector<std::size_t>({0, 1, 2, 3, 4}));
+}
+
+// Constructors declared with cons are not free, so c1 == c2 may hold even though c1 and c2 are different normal forms.
+BOOST_AUTO_TEST_CASE(test_summand_index_non_free_sort)
+{
+  std::string text =
+    "sort D;                                      \n"
+    "     E = struct e1 | e2;                     \n"
+    "cons c1, c2: D;                              \n"
+    "eqn  c1 == c2 = true;                        \n"
+    "     c2 == c1 = true;                        \n"
+    "act  a, b;                                   \n"
+    "proc P(d: D, e: E) =                         \n"
+    "       (d == c1) -> a . P(d = c2)            \n"
+    "     + (d == c2) -> b . P(d = c2)            \n"
+    "     + (e == e1) -> a . P(e = e2)            \n"
+    "     + (e == e2) -> b . P(e = e1)            \n"
+    "     + delta;                                \n"
+    "init P(c1, e1);                              \n"
+    ;
+  specification lpsspec = parse_linear_process_specification(text);
+  data::rewriter r(lpsspec.data());
+  data::rewriter::substitution_type sigma;
+
+  std::vector<summand_guard> guards;
+  for (const action_summand& summand: lpsspec.process().action_summands())
+  {
+    guards.push_back(summand_guard{summand.summation_variables(), summand.condition()});
+  }
+  const data::variable_list& parameters = lpsspec.process().process_parameters();
+  detail::summand_index index(guards, std::vector<data::variable>(parameters.begin(), parameters.end()), lpsspec.data(), r, sigma);
+
+  auto candidates = [&](const std::string& d, const std::string& e)
+  {
+    std::vector<data::data_expression> values = { data::parse_data_expression(d, lpsspec.data()), data::parse_data_expression(e, lpsspec.data()) };
+    return index.candidates(state(values.begin(), 2), 2);
+  };
+
+  // The parameter d is not used in the index, but the parameter e of a structured sort is.
+  BOOST_CHECK(candidates("c2", "e1") == std::vector<std::size_t>({0, 1, 2}));
+  BOOST_CHECK(candidates("c1", "e2") == std::vector<std::size_t>({0, 1, 3}));
+}
@@ -0,0 +1,82 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file tree_state_set_test.cpp
+/// \brief Tests for the tree compressed state set.
+
+#define BOOST_TEST_MODULE tree_state_set_test
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include "mcrl2/data/standard_numbers_utility.h"
+#include "mcrl2/lps/tree_state_set.h"
+
+using namespace mcrl2;
+using namespace mcrl2::lps;
+
+static state make_state(const std::vector<std::size_t>& values)
+{
+  std::vector<data::data_expression> v;
+  for (std::size_t i: values)
+  {
+    v.push_back(data::sort_nat::nat(i));
+  }
+  return state(v.begin(), v.size());
+}
+
+static void check_tree_state_set(std::size_t size)
+{
+  tree_state_set states(size);
+  BOOST_CHECK(states.empty());
+
+  // Insert all vectors with values in {0, 1, 2}, and every vector twice.
+  std::vector<state> inserted;
+  std::vector<std::size_t> values(size, 0);
+  while (true)
+  {
+    state s = make_state(values);
+    std::pair<std::size_t, bool> p = states.insert(s);
+    BOOST_CHECK(p.second);
+    BOOST_CHECK_EQUAL(p.first, inserted.size());
+    inserted.push_back(s);
+
+    p = states.insert(s);
+    BOOST_CHECK(!p.second);
+    BOOST_CHECK_EQUAL(p.first, inserted.size() - 1);
+
+    std::size_t i = 0;
+    while (i < size && values[i] == 2)
+    {
+      values[i++] = 0;
+    }
+    if (i == size)
+    {
+      break;
+    }
+    values[i]++;
+  }
+
+  BOOST_CHECK_EQUAL(states.size(), inserted.size());
+  for (std::size_t i = 0; i < inserted.size(); i++)
+  {
+    BOOST_CHECK_EQUAL(states.index(inserted[i]), i);
+    BOOST_CHECK_EQUAL(states[i], inserted[i]);
+  }
+
+  if (size > 0)
+  {
+    BOOST_CHECK_EQUAL(states.index(make_state(std::vector<std::size_t>(size, 3))), tree_state_set::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_tree_state_set)
+{
+  for (std::size_t size = 0; size <= 6; size++)
+  {
+    check_tree_state_set(size);
+  }
+}
@@ -18,6 +18,7 @@
 
 #include "mcrl2/trace/trace.h"
 #include "mcrl2/lps/next_state_generator.h"
+#include "mcrl2/lps/tree_state_set.h"
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/detail/bithashtable.h"
 #include "mcrl2/lts/detail/queue.h"
@@ -85,6 +86,45 @@ namespace detail
         }
     };
 
+    // Assigns unique numbers to states. The states are either stored in an indexed set, or,
+    // to save memory, in a tree compressed set.
+    class state_numbers_set
+    {
+      protected:
+        bool m_tree_compression = false;
+        utilities::indexed_set<lps::state> m_indexed_set;
+        lps::tree_state_set m_tree_set;
+
+      public:
+        state_numbers_set() = default;
+
+        state_numbers_set(std::size_t initial_table_size, bool tree_compression, std::size_t number_of_parameters)
+          : m_tree_compression(tree_compression),
+            m_indexed_set(tree_compression ? 0 : initial_table_size),
+            m_tree_set(tree_compression ? number_of_parameters : 0)
+        {}
+
+        std::pair<std::size_t, bool> insert(const lps::state& s)
+        {
+          return m_tree_compression ? m_tree_set.insert(s) : m_indexed_set.insert(s);
+        }
+
+        std::size_t index(const lps::state& s) const
+        {
+          return m_tree_compression ? m_tree_set.index(s) : m_indexed_set.index(s);
+        }
+
+        lps::state operator[](std::size_t i) const
+        {
+          return m_tree_compression ? m_tree_set[i] : m_indexed_set[i];
+        }
+
+        std::size_t size() const
+        {
+          return m_tree_compression ? m_tree_set.size() : m_indexed_set.size();
+        }
+    };
+
 } // end namespace detail
 
 class lps2lts_algorithm
@@ -101,7 +141,7 @@ class lps2lts_algorithm
     next_state_generator::summand_subset_t m_nonprioritized_subset;
     next_state_generator::summand_subset_t m_prioritized_subset;
 
-    utilities::indexed_set<lps::state> m_state_numbers;
+    detail::state_numbers_set m_state_numbers;
 
     bit_hash_table m_bit_hash_table;
 
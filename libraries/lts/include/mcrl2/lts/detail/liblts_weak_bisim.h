@@ -8,17 +8,26 @@
 //
 /// \file lts/detail/liblts_weak_bisim.h
 /// \brief This file defines an algorithm for weak bisimulation, by
-///        calculating the transitive tau closure and apply strong
-///        bisimulation afterwards. In order to apply this algorithm
-///        it is advisable to first apply a branching bisimulation reduction.
+///        signature refinement on the transition system after a branching
+///        bisimulation reduction. The weak transitions are computed on the
+///        fly in every iteration, such that the transitive tau closure is
+///        never added to the transition system.
 
 #ifndef _LIBLTS_WEAK_BISIM_H
 #define _LIBLTS_WEAK_BISIM_H
+#include <algorithm>
 #include <cmath>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <map>
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/hash_utility.h"
 #include "mcrl2/utilities/logger.h"
 #include "mcrl2/lts/lts.h"
+#include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/lts/detail/liblts_bisim_dnj.h"
 #include "mcrl2/lts/detail/liblts_scc.h"
 #include "mcrl2/lts/detail/liblts_tau_star_reduce.h"
 #include "mcrl2/lts/detail/liblts_merge.h"
@@ -34,6 +43,314 @@ namespace lts
 namespace detail
 {
 
+/// \brief This class contains a partitioner that computes weak bisimulation equivalence classes.
+/// \details The partition is computed by signature refinement as described in S. Blom, S. Orzan,
+///          "Distributed Branching Bisimulation Reduction of State Spaces", Proc. PDMC 2003. The
+///          signature of a state s consists of the pairs (a, B) such that s can reach block B by a weak
+///          a-step, i.e., s -tau*-> -a-> -tau*-> t for some t in B, and the pairs (tau, B) such that
+///          s -tau*-> t for some t in B.
+///
+///          The signatures are computed in a topological order of the tau transitions, such that the
+///          weak steps of a state are obtained from those of its tau successors. The weak steps of a state
+///          are discarded as soon as all its tau predecessors have been handled. So, apart from the blocks
+///          that each state can reach by internal steps, no saturated transition relation is stored.
+///          Therefore, the transition system may not contain tau loops other than tau self loops. Divergences
+///          can be preserved by replacing tau self loops by an explicit divergence label first.
+template < class LTS_TYPE>
+class weak_bisim_partitioner
+{
+  public:
+    /** \brief Creates a weak bisimulation partitioner for an LTS, and computes the partition.
+     *  \param[in] l reference to an LTS without tau loops, except for tau self loops. */
+    weak_bisim_partitioner(LTS_TYPE& l)
+      : aut(l),
+        block_index_of_a_state(l.num_states(), 0),
+        number_of_blocks(1)
+    {
+      mCRL2log(log::verbose) << "Weak bisimulation partitioner created for " << l.num_states() << " states and "
+                             << l.num_transitions() << " transitions.\n";
+      initialise_transitions();
+      compute_topological_order();
+
+      std::size_t iterations = 0;
+      std::size_t previous_number_of_blocks = 0;
+      while (previous_number_of_blocks != number_of_blocks)
+      {
+        previous_number_of_blocks = number_of_blocks;
+        refine();
+        ++iterations;
+        mCRL2log(log::debug) << "Iteration " << iterations << " yields " << number_of_blocks << " blocks.\n";
+      }
+      mCRL2log(log::verbose) << "Weak bisimulation partition computed in " << iterations << " iterations with "
+                             << number_of_blocks << " equivalence classes.\n";
+    }
+
+    /** \brief The lts for which this partitioner is created is replaced by the lts modulo the calculated partition.
+     *  \details Every transition s -a-> t is replaced by [s] -a-> [t], except for tau transitions within
+     *           an equivalence class, which are removed. The result is weakly bisimilar to the original
+     *           transition system. The state labels of the states in an equivalence class are merged. */
+    void replace_transition_system()
+    {
+      std::unordered_set<transition> resulting_transitions;
+      for (const transition& t: aut.get_transitions())
+      {
+        if (!aut.is_tau(aut.apply_hidden_label_map(t.label())) ||
+            block_index_of_a_state[t.from()] != block_index_of_a_state[t.to()])
+        {
+          resulting_transitions.insert(
+            transition(
+              block_index_of_a_state[t.from()],
+              aut.apply_hidden_label_map(t.label()),
+              block_index_of_a_state[t.to()]));
+        }
+      }
+
+      aut.clear_transitions(resulting_transitions.size());
+      for (const transition& t: resulting_transitions)
+      {
+        aut.add_transition(t);
+      }
+
+      if (aut.has_state_info())
+      {
+        std::vector<typename LTS_TYPE::state_label_t> new_labels(num_eq_classes());
+        for (std::size_t i = aut.num_states(); i > 0; )
+        {
+          --i;
+          const std::size_t new_index = block_index_of_a_state[i];
+          new_labels[new_index] = new_labels[new_index] + aut.state_label(i);
+        }
+        for (std::size_t i = 0; i < num_eq_classes(); ++i)
+        {
+          aut.set_state_label(i, new_labels[i]);
+        }
+      }
+
+      aut.set_num_states(num_eq_classes());
+      aut.set_initial_state(get_eq_class(aut.initial_state()));
+    }
+
+    /** \brief Gives the number of weak bisimulation equivalence classes of the LTS. */
+    std::size_t num_eq_classes() const
+    {
+      return number_of_blocks;
+    }
+
+    /** \brief Gives the equivalence class number of a state, which ranges from 0 upto (and excluding)
+     *         num_eq_classes(). */
+    std::size_t get_eq_class(const std::size_t s) const
+    {
+      return block_index_of_a_state[s];
+    }
+
+    /** \brief Returns whether two states are in the same weak bisimulation equivalence class. */
+    bool in_same_class(const std::size_t s, const std::size_t t) const
+    {
+      return get_eq_class(s) == get_eq_class(t);
+    }
+
+  protected:
+    typedef std::vector<std::pair<std::size_t, std::size_t> > signature_type; // Sorted pairs of a label and a block.
+
+    struct signature_hash
+    {
+      std::size_t operator()(const signature_type& signature) const
+      {
+        std::size_t result = signature.size();
+        for (const std::pair<std::size_t, std::size_t>& p: signature)
+        {
+          result = utilities::detail::hash_combine(result, utilities::detail::hash_combine(p.first, p.second));
+        }
+        return result;
+      }
+    };
+
+    LTS_TYPE& aut;
+    std::vector<std::size_t> block_index_of_a_state;
+    std::size_t number_of_blocks;
+
+    // The tau successors of a state s are tau_successors[tau_begin[s]], ..., tau_successors[tau_begin[s+1]-1],
+    // where tau self loops are left out. The other transitions are stored likewise as pairs of a label and a target.
+    std::vector<std::size_t> tau_begin;
+    std::vector<std::size_t> tau_successors;
+    std::vector<std::size_t> visible_begin;
+    std::vector<std::pair<std::size_t, std::size_t> > visible_transitions;
+
+    // The number of tau transitions that enter a state, excluding tau self loops.
+    std::vector<std::size_t> number_of_tau_predecessors;
+
+    // The states ordered such that every state occurs after all its tau successors.
+    std::vector<std::size_t> topological_order;
+
+    void initialise_transitions()
+    {
+      const std::size_t n = aut.num_states();
+      tau_begin.assign(n + 1, 0);
+      visible_begin.assign(n + 1, 0);
+      number_of_tau_predecessors.assign(n, 0);
+      for (const transition& t: aut.get_transitions())
+      {
+        if (!aut.is_tau(aut.apply_hidden_label_map(t.label())))
+        {
+          visible_begin[t.from() + 1]++;
+        }
+        else if (t.from() != t.to())
+        {
+          tau_begin[t.from() + 1]++;
+          number_of_tau_predecessors[t.to()]++;
+        }
+      }
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        tau_begin[s + 1] += tau_begin[s];
+        visible_begin[s + 1] += visible_begin[s];
+      }
+
+      tau_successors.resize(tau_begin[n]);
+      visible_transitions.resize(visible_begin[n]);
+      std::vector<std::size_t> tau_position(tau_begin.begin(), tau_begin.end() - 1);
+      std::vector<std::size_t> visible_position(visible_begin.begin(), visible_begin.end() - 1);
+      for (const transition& t: aut.get_transitions())
+      {
+        const std::size_t label = aut.apply_hidden_label_map(t.label());
+        if (!aut.is_tau(label))
+        {
+          visible_transitions[visible_position[t.from()]++] = std::make_pair(label, t.to());
+        }
+        else if (t.from() != t.to())
+        {
+          tau_successors[tau_position[t.from()]++] = t.to();
+        }
+      }
+    }
+
+    void compute_topological_order()
+    {
+      const std::size_t n = aut.num_states();
+
+      // The tau predecessors are only needed to compute the order.
+      std::vector<std::size_t> predecessor_begin(n + 1, 0);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        predecessor_begin[s + 1] = predecessor_begin[s] + number_of_tau_predecessors[s];
+      }
+      std::vector<std::size_t> predecessors(tau_successors.size());
+      std::vector<std::size_t> position(predecessor_begin.begin(), predecessor_begin.end() - 1);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        for (std::size_t i = tau_begin[s]; i < tau_begin[s + 1]; ++i)
+        {
+          predecessors[position[tau_successors[i]]++] = s;
+        }
+      }
+
+      // Repeatedly add a state of which all tau successors have been added.
+      std::vector<std::size_t> remaining_successors(n);
+      std::deque<std::size_t> todo;
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        remaining_successors[s] = tau_begin[s + 1] - tau_begin[s];
+        if (remaining_successors[s] == 0)
+        {
+          todo.push_back(s);
+        }
+      }
+      topological_order.reserve(n);
+      while (!todo.empty())
+      {
+        const std::size_t s = todo.front();
+        todo.pop_front();
+        topological_order.push_back(s);
+        for (std::size_t i = predecessor_begin[s]; i < predecessor_begin[s + 1]; ++i)
+        {
+          if (--remaining_successors[predecessors[i]] == 0)
+          {
+            todo.push_back(predecessors[i]);
+          }
+        }
+      }
+
+      if (topological_order.size() != n)
+      {
+        throw mcrl2::runtime_error("Weak bisimulation partitioning requires a transition system without tau loops.");
+      }
+    }
+
+    // Computes the signatures with respect to the current partition, and splits the blocks accordingly.
+    void refine()
+    {
+      const std::size_t n = aut.num_states();
+
+      // The blocks that every state can reach by zero or more tau steps.
+      std::vector<std::vector<std::size_t> > tau_reachable_blocks(n);
+      for (const std::size_t s: topological_order)
+      {
+        std::vector<std::size_t>& reachable = tau_reachable_blocks[s];
+        reachable.push_back(block_index_of_a_state[s]);
+        for (std::size_t i = tau_begin[s]; i < tau_begin[s + 1]; ++i)
+        {
+          const std::vector<std::size_t>& successor_reachable = tau_reachable_blocks[tau_successors[i]];
+          reachable.insert(reachable.end(), successor_reachable.begin(), successor_reachable.end());
+        }
+        std::sort(reachable.begin(), reachable.end());
+        reachable.erase(std::unique(reachable.begin(), reachable.end()), reachable.end());
+        reachable.shrink_to_fit();
+      }
+
+      // The weak a-steps, for a not equal to tau, of the states that still have unhandled tau predecessors.
+      std::vector<signature_type> weak_steps(n);
+      std::vector<std::size_t> remaining_predecessors(number_of_tau_predecessors);
+      std::unordered_map<signature_type, std::size_t, signature_hash> new_blocks;
+      std::vector<std::size_t> new_block_index_of_a_state(n);
+      signature_type signature;
+
+      for (const std::size_t s: topological_order)
+      {
+        signature_type& steps = weak_steps[s];
+        for (std::size_t i = visible_begin[s]; i < visible_begin[s + 1]; ++i)
+        {
+          const std::pair<std::size_t, std::size_t>& t = visible_transitions[i];
+          for (const std::size_t block: tau_reachable_blocks[t.second])
+          {
+            steps.emplace_back(t.first, block);
+          }
+        }
+        for (std::size_t i = tau_begin[s]; i < tau_begin[s + 1]; ++i)
+        {
+          const signature_type& successor_steps = weak_steps[tau_successors[i]];
+          steps.insert(steps.end(), successor_steps.begin(), successor_steps.end());
+        }
+        std::sort(steps.begin(), steps.end());
+        steps.erase(std::unique(steps.begin(), steps.end()), steps.end());
+
+        // The signature also contains the current block of s, such that blocks are only split.
+        signature = steps;
+        signature.emplace_back(std::size_t(-1), block_index_of_a_state[s]);
+        for (const std::size_t block: tau_reachable_blocks[s])
+        {
+          signature.emplace_back(aut.tau_label_index(), block);
+        }
+        new_block_index_of_a_state[s] = new_blocks.emplace(signature, new_blocks.size()).first->second;
+
+        // Discard the weak steps that are no longer needed.
+        for (std::size_t i = tau_begin[s]; i < tau_begin[s + 1]; ++i)
+        {
+          if (--remaining_predecessors[tau_successors[i]] == 0)
+          {
+            signature_type().swap(weak_steps[tau_successors[i]]);
+          }
+        }
+        if (remaining_predecessors[s] == 0)
+        {
+          signature_type().swap(steps);
+        }
+      }
+
+      block_index_of_a_state.swap(new_block_index_of_a_state);
+      number_of_blocks = new_blocks.size();
+    }
+};
+
 /** \brief Reduce LTS l with respect to (divergence-preserving) weak bisimulation.
  * \param[in/out] l The transition system that is reduced.
  * \param[in] preserve_divergences Indicates whether loops of internal actions on states must be preserved. If false
@@ -44,30 +361,30 @@ void weak_bisimulation_reduce(
   const bool preserve_divergences = false)
 {
   bisimulation_reduce_dnj(l, true, preserve_divergences);
-  //< Apply branching bisimulation to l.
+  //< Apply branching bisimulation to l, which also removes all tau loops except tau self loops.
 
   std::size_t divergence_label;
   if (preserve_divergences)
   {
     divergence_label=mark_explicit_divergence_transitions(l);
-  } 
-  reflexive_transitive_tau_closure(l);                        // Apply transitive tau closure to l.
-  bisimulation_reduce_dnj(l, false, false);                  // Apply strong bisimulation to l.
-  scc_reduce(l);                                              // Remove tau loops.
+  }
+  {
+    weak_bisim_partitioner<LTS_TYPE> weak_bisim_part(l);      // Apply weak bisimulation to l.
+    weak_bisim_part.replace_transition_system();
+  }
   remove_redundant_transitions(l);                            // Remove transitions s -a-> s' if also s-a->-tau->s' or s-tau->-a->s' is present.
-                                                              // Note that this is correct, because l is reduced modulo strong bisimulation and
-                                                              // does not contain tau loops. 
+                                                              // Note that this is correct, because l does not contain tau loops.
   if (preserve_divergences)
   {
     unmark_explicit_divergence_transitions(l,divergence_label);
-  } 
+  }
 }
 
 
 /** \brief Checks whether the initial states of two LTSs are weakly bisimilar.
  * \details The LTSs l1 and l2 are not usable anymore after this call.
- *          The space consumption is O(n) and running time is dominated by the
- *          transitive closure (after branching bisimulation).
+ *          The transition systems are merged, tau loops are contracted, after
+ *          which the weak bisimulation partition of the result is computed.
  * \param[in/out] l1 A first transition system.
  * \param[in/out] l2 A second transistion system.
  * \param[preserve_divergences] If true and branching is true, preserve tau loops on states.
@@ -78,20 +395,28 @@ bool destructive_weak_bisimulation_compare(
   LTS_TYPE& l2,
   const bool preserve_divergences=false)
 {
-  weak_bisimulation_reduce(l1,preserve_divergences);
-  weak_bisimulation_reduce(l2,preserve_divergences);
-  return destructive_bisimulation_compare_dnj(l1,l2);
+  std::size_t init_l2 = l2.initial_state() + l1.num_states();
+  detail::merge(l1, std::move(l2));
+  l2.clear(); // No use for l2 anymore.
+
+  // Contract each tau loop to a single state, with a tau self loop if divergences are preserved.
+  scc_partitioner<LTS_TYPE> scc_part(l1);
+  scc_part.replace_transition_system(preserve_divergences);
+  init_l2 = scc_part.get_eq_class(init_l2);
+  if (preserve_divergences)
+  {
+    mark_explicit_divergence_transitions(l1);
+  }
+
+  weak_bisim_partitioner<LTS_TYPE> weak_bisim_part(l1);
+  return weak_bisim_part.in_same_class(l1.initial_state(), init_l2);
 }
 
 
 /** \brief Checks whether the initial states of two LTSs are weakly bisimilar.
  *  \details The LTSs l1 and l2 are first duplicated and subsequently
- *           reduced modulo bisimulation. If memory space is a concern, one could consider to
- *           use destructive_weak_bisimulation_compare.  The running time
- *           of this routine is dominated by the transitive closure
- *           (after branching bisimulation).  It uses O(m+n) memory
- *           in addition to the copies of l1 and l2, where n is the
- *           number of states and m is the number of transitions.
+ *           compared. If memory space is a concern, one could consider to
+ *           use destructive_weak_bisimulation_compare.
  * \param[in/out] l1 A first transition system.
  * \param[in/out] l2 A second transistion system.
  * \param[preserve_divergences] If true and branching is true, preserve tau loops on states.
@@ -17,6 +17,7 @@
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lps/exploration_strategy.h"
 #include "mcrl2/process/parse.h"
+#include "mcrl2/utilities/cache_policy.h"
 
 namespace mcrl2
 {
@@ -48,6 +49,7 @@ class lts_generation_options
 
     bool bithashing;
     std::size_t bithashsize;
+    bool tree_compression;
 
     mcrl2::lts::lts_type outformat;
     bool outinfo;
@@ -66,7 +68,10 @@ class lts_generation_options
     std::set < mcrl2::lps::multi_action > trace_multiactions;
 
     bool use_enumeration_caching;
+    std::size_t enumeration_cache_size;
+    mcrl2::utilities::cache_replacement enumeration_cache_policy;
     bool use_summand_pruning;
+    bool use_summand_index;
     std::set< mcrl2::core::identifier_string > actions_internal_for_divergencies;
 
     /// \brief Constructor
@@ -81,6 +86,7 @@ class lts_generation_options
       suppress_progress_messages(false),
       bithashing(false),
       bithashsize(default_bithashsize),
+      tree_compression(false),
       outformat(mcrl2::lts::lts_none),
       outinfo(true),
       trace(false),
@@ -91,7 +97,10 @@ class lts_generation_options
       detect_divergence(false),
       detect_action(false),
       use_enumeration_caching(false),
-      use_summand_pruning(false)
+      enumeration_cache_size(0),
+      enumeration_cache_policy(mcrl2::utilities::cache_replacement::lru),
+      use_summand_pruning(false),
+      use_summand_index(true)
     {}
 
     /// \brief Copy assignment operator.
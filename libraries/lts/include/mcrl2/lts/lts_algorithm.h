@@ -56,9 +56,11 @@ namespace lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  * reduced.
+ * \param[in] number_of_threads The number of threads that is used by the
+ * signature refinement algorithms (the *_sigref equivalences).
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -548,7 +550,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l,lts_equivalence eq, std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -572,7 +574,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
@@ -593,7 +595,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
@@ -614,7 +616,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_divergence_preserving_branching_bisim_sigref:
     {
-      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l);
+      sigref<LTS_TYPE, signature_divergence_preserving_branching_bisim<LTS_TYPE> > s(l, number_of_threads);
       s.run();
       return;
     }
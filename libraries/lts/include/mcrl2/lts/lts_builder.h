@@ -48,6 +48,10 @@ struct lts_builder
     return i->second;
   }
 
+  // Called for every state that is discovered, in the order of their indices
+  virtual void add_state(const lps::state& /* s */, std::size_t /* index */)
+  {}
+
   // Add a transition to the LTS
   virtual void add_transition(std::size_t from, const process::timed_multi_action& a, std::size_t to) = 0;
 
@@ -189,6 +193,50 @@ class lts_lts_builder: public lts_builder
     }
 };
 
+// Write state labels, action labels and transitions immediately to disk, and write the header of the .lts file
+// in finalize.
+class lts_lts_disk_builder: public lts_builder
+{
+  protected:
+    lts_lts_disk_writer m_writer;
+    std::size_t m_number_of_states = 0;
+
+  public:
+    lts_lts_disk_builder(const std::string& filename, const data::data_specification& dataspec, const process::action_label_list& action_labels, const data::variable_list& process_parameters)
+      : m_writer(filename, dataspec, process_parameters, action_labels)
+    {
+      mCRL2log(log::verbose) << "writing state space in LTS format to '" << filename << "'." << std::endl;
+    }
+
+    void add_state(const lps::state& s, std::size_t index) override
+    {
+      utilities::mcrl2_unused(index);
+      assert(index == m_number_of_states);
+      m_writer.add_state(state_label_lts(s));
+      m_number_of_states++;
+    }
+
+    void add_transition(std::size_t from, const process::timed_multi_action& a, std::size_t to) override
+    {
+      std::size_t number_of_actions = m_actions.size();
+      std::size_t label = add_action(a);
+      if (m_actions.size() > number_of_actions)
+      {
+        m_writer.add_action(action_label_lts(lps::multi_action(a.actions(), a.time())));
+      }
+      m_writer.add_transition(transition(from, label, to));
+    }
+
+    // Write the remaining transitions and the header
+    void finalize(const std::unordered_map<lps::state, std::size_t>& state_map) override
+    {
+      m_writer.close(0, state_map.size());
+    }
+
+    void save(const std::string& /* filename */) override
+    { }
+};
+
 class lts_dot_builder: public lts_lts_builder
 {
   public:
@@ -19,9 +19,12 @@
 #ifndef MCRL2_LTS_LTS_MCRL2_H
 #define MCRL2_LTS_LTS_MCRL2_H
 
+#include <fstream>
+#include <memory>
 #include <string>
 #include <vector>
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/atermpp/aterm_io_binary.h"
 #include "mcrl2/core/detail/function_symbols.h"
 #include "mcrl2/core/parse.h"
 #include "mcrl2/data/variable.h"
@@ -453,6 +456,49 @@ class probabilistic_lts_lts_t :
      */
     void save(const std::string& filename) const;
 };
+
+/** \brief Writes a labelled transition system in .lts format while it is being generated, such that its
+ *         states and transitions do not have to be kept in memory.
+ *  \details State labels and action labels are written as soon as they are added, and must be added in the
+ *           order of their indices, where action labels start at index 1 as index 0 is reserved for tau.
+ *           Transitions are buffered and written in blocks. As the header of an .lts file is written after
+ *           all states and transitions, the number of states only has to be known when the writer is closed.
+ */
+class lts_lts_disk_writer
+{
+  public:
+    /** \brief Creates a writer for the given file.
+     *  \details If the filename is empty, the result is written to stdout.
+     */
+    lts_lts_disk_writer(const std::string& filename,
+                        const data::data_specification& data,
+                        const data::variable_list& process_parameters,
+                        const process::action_label_list& action_label_declarations);
+
+    /** \brief Writes the label of the next state. */
+    void add_state(const state_label_lts& label);
+
+    /** \brief Writes the next action label. */
+    void add_action(const action_label_lts& label);
+
+    void add_transition(const transition& t);
+
+    /** \brief Writes the remaining transitions and the header, and closes the file. */
+    void close(std::size_t initial_state, std::size_t number_of_states);
+
+  protected:
+    void write_transitions();
+
+    std::string m_filename;
+    data::data_specification m_data;
+    data::variable_list m_process_parameters;
+    process::action_label_list m_action_label_declarations;
+
+    std::ofstream m_fstream;
+    std::unique_ptr<atermpp::binary_aterm_output> m_stream;
+    std::vector<transition> m_transitions; // The transitions that have not been written yet.
+};
+
 } // namespace lts
 } // namespace mcrl2
 
@@ -0,0 +1,134 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/mapped_lts.h
+/// \brief A read-only labelled transition system that is memory mapped from a file.
+
+#ifndef MCRL2_LTS_MAPPED_LTS_H
+#define MCRL2_LTS_MAPPED_LTS_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include "mcrl2/lts/transition.h"
+#include "mcrl2/utilities/noncopyable.h"
+
+namespace mcrl2
+{
+namespace lts
+{
+
+/// \brief A read-only labelled transition system of which the transitions are memory mapped from a file.
+/// \details The file contains the outgoing transitions of all states, sorted on source, label and target,
+///          in a compressed sparse row layout: for every state the index of its first outgoing transition,
+///          followed by the labels and the targets of all transitions. The indices are stored in 32 bits
+///          whenever all of them fit, and in 64 bits otherwise. The operating system pages the file in on
+///          demand, so transition systems that are larger than the main memory can be inspected. Only the
+///          structure is stored; the action and state labels must be obtained from the original file.
+class mapped_lts : private mcrl2::utilities::noncopyable
+{
+  public:
+    /// \brief Maps the transition system in the given file into memory.
+    /// \details Throws a mcrl2::runtime_error if the file does not contain a mapped lts.
+    explicit mapped_lts(const std::string& filename);
+    ~mapped_lts();
+
+    /// \returns True iff the given file starts with the header of a mapped lts.
+    static bool is_mapped_lts(const std::string& filename);
+
+    std::size_t num_states() const
+    {
+      return m_num_states;
+    }
+
+    /// \returns The number of action labels, including tau which has index 0.
+    std::size_t num_action_labels() const
+    {
+      return m_num_action_labels;
+    }
+
+    std::size_t num_transitions() const
+    {
+      return m_num_transitions;
+    }
+
+    std::size_t initial_state() const
+    {
+      return m_initial_state;
+    }
+
+    /// \returns The index of the first outgoing transition of state s, the outgoing transitions of s are
+    ///          the transitions with an index in [outgoing_begin(s), outgoing_begin(s + 1)).
+    std::size_t outgoing_begin(std::size_t s) const
+    {
+      return get(m_offsets, s);
+    }
+
+    std::size_t label(std::size_t transition_index) const
+    {
+      return get(m_labels, transition_index);
+    }
+
+    std::size_t target(std::size_t transition_index) const
+    {
+      return get(m_targets, transition_index);
+    }
+
+  private:
+    /// \brief Reads the header and sets the pointers to the arrays in the given file contents.
+    void initialise(const unsigned char* data, std::size_t size, const std::string& filename);
+
+    std::size_t get(const unsigned char* array, std::size_t index) const
+    {
+      if (m_wide)
+      {
+        return static_cast<std::size_t>(reinterpret_cast<const std::uint64_t*>(array)[index]);
+      }
+      return reinterpret_cast<const std::uint32_t*>(array)[index];
+    }
+
+    std::size_t m_num_states = 0;
+    std::size_t m_num_action_labels = 0;
+    std::size_t m_num_transitions = 0;
+    std::size_t m_initial_state = 0;
+    bool m_wide = false; // Indicates that the indices are stored in 64 bits.
+
+    const unsigned char* m_offsets = nullptr;
+    const unsigned char* m_labels = nullptr;
+    const unsigned char* m_targets = nullptr;
+
+    void* m_mapping = nullptr; // The start of the mapped file.
+    std::size_t m_mapping_size = 0;
+    std::vector<std::uint64_t> m_buffer; // Holds the file contents on platforms without memory mapping.
+};
+
+/// \brief Saves the structure of a transition system as a mapped lts.
+/// \details The transitions are not copied. Besides the offsets of the states, only a permutation of the
+///          transitions is stored in memory while writing.
+/// \param filename The name of the output file.
+/// \param transitions The transitions, in any order.
+/// \param hidden_label_map Maps labels to the labels by which they are replaced, see lts::hidden_label_map().
+void save_mapped_lts(const std::string& filename,
+                     std::size_t num_states,
+                     std::size_t num_action_labels,
+                     std::size_t initial_state,
+                     const std::vector<transition>& transitions,
+                     const std::map<std::size_t, std::size_t>& hidden_label_map);
+
+/// \brief Saves the structure of the transition system l as a mapped lts.
+template <class LTS_TYPE>
+void save_mapped_lts(const LTS_TYPE& l, const std::string& filename)
+{
+  save_mapped_lts(filename, l.num_states(), l.num_action_labels(), l.initial_state(), l.get_transitions(), l.hidden_label_map());
+}
+
+} // namespace lts
+} // namespace mcrl2
+
+#endif // MCRL2_LTS_MAPPED_LTS_H
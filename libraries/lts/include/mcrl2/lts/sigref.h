@@ -14,11 +14,14 @@
 #ifndef MCRL2_LTS_SIGREF_H
 #define MCRL2_LTS_SIGREF_H
 
-#include <set>
-#include <map>
+#include <algorithm>
 #include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 #include "mcrl2/lts/lts.h"
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/utilities/hash_utility.h"
 #include "mcrl2/utilities/logger.h"
 
 namespace mcrl2
@@ -26,8 +29,62 @@ namespace mcrl2
 namespace lts
 {
 
-/** \brief A signature is a pair of an action label and a block */
-typedef std::set<std::pair<std::size_t, std::size_t> > signature_t;
+/** \brief A signature is a sorted vector of pairs of an action label and a block, without duplicates */
+typedef std::vector<std::pair<std::size_t, std::size_t> > signature_t;
+
+namespace detail
+{
+
+/** \brief Ranges of fewer elements than this are not divided over threads. */
+constexpr std::size_t sigref_minimal_parallel_size = 4096;
+
+/** \brief Applies f(thread_index, first, last) to consecutive ranges that together cover [0, n).
+  * \details If more than one thread is requested and n is at least minimal_size, the range
+  *          is divided over number_of_threads threads, and this function returns after all of
+  *          them have finished. Otherwise f(0, 0, n) is called by the calling thread.
+  */
+template <typename Function>
+void sigref_parallel_for(const std::size_t number_of_threads, const std::size_t n, const std::size_t minimal_size, Function f)
+{
+  if (number_of_threads <= 1 || n < minimal_size)
+  {
+    f(std::size_t(0), std::size_t(0), n);
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  const std::size_t chunk_size = (n + number_of_threads - 1) / number_of_threads;
+  for (std::size_t i = 0; i < number_of_threads; ++i)
+  {
+    const std::size_t first = std::min(i * chunk_size, n);
+    const std::size_t last = std::min(first + chunk_size, n);
+    threads.emplace_back([&f, i, first, last]() { f(i, first, last); });
+  }
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+}
+
+/** \brief Sorts a signature and removes duplicate pairs. */
+inline void normalise_signature(signature_t& sig)
+{
+  std::sort(sig.begin(), sig.end());
+  sig.erase(std::unique(sig.begin(), sig.end()), sig.end());
+}
+
+/** \brief Computes a hash value of a signature. */
+inline std::size_t hash_signature(const signature_t& sig)
+{
+  std::size_t result = sig.size();
+  for (const std::pair<std::size_t, std::size_t>& p: sig)
+  {
+    result = utilities::detail::hash_combine(result, utilities::detail::hash_combine(p.first, p.second));
+  }
+  return result;
+}
+
+} // namespace detail
 
 /** \brief Base class for signature computation */
 template < class LTS_T >
@@ -37,30 +94,48 @@ protected:
   /** \brief The labelled transition system for which the signature is computed */
   const LTS_T& m_lts;
 
+  /** \brief The number of threads that is used to compute the signatures */
+  std::size_t m_number_of_threads;
+
+  /** \brief The outgoing transitions per state */
+  outgoing_transitions_per_state_t m_succ_transitions;
+
   /** \brief Signature stored per state */
   std::vector<signature_t> m_sig;
 
 public:
   /** \brief Constructor
     */
-  signature(const LTS_T& lts_)
-    : m_lts(lts_), m_sig(m_lts.num_states(), signature_t())
+  signature(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : m_lts(lts_),
+      m_number_of_threads(std::max(number_of_threads, std::size_t(1))),
+      m_succ_transitions(lts_.get_transitions(), lts_.num_states(), true),
+      m_sig(m_lts.num_states(), signature_t())
   {}
 
+  virtual ~signature() = default;
+
+  /** \brief The number of threads that is used to compute the signatures. */
+  std::size_t number_of_threads() const
+  {
+    return m_number_of_threads;
+  }
+
   /** \brief Compute a new signature based on \a partition.
     * \param[in] partition The current partition
     */
   virtual void compute_signature(const std::vector<std::size_t>& partition) = 0;
 
   /** \brief Compute the transitions for the quotient according to \a partition.
+    * \details The transitions may contain duplicates.
     * \param[in] partition The partition that is used to compute the quotient
-    * \param[out] transitions A set to which the transitions of the quotient are written
+    * \param[out] transitions A vector to which the transitions of the quotient are written
     */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
   {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    for(const transition& t: m_lts.get_transitions())
     {
-      transitions.insert(transition(partition[i->from()], i->label(), partition[i->to()]));
+      transitions.emplace_back(partition[t.from()], m_lts.apply_hidden_label_map(t.label()), partition[t.to()]);
     }
   }
 
@@ -80,12 +155,14 @@ class signature_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_succ_transitions;
   using signature<LTS_T>::m_sig;
 
 public:
   /** \brief Constructor */
-  signature_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_)
+  signature_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature<LTS_T>(lts_, number_of_threads)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for strong bisimulation" << std::endl;
   }
@@ -94,65 +171,263 @@ public:
   virtual void
   compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      m_sig[i->from()].insert(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
-    }
+    // The signature of a state only depends on its own outgoing transitions.
+    detail::sigref_parallel_for(m_number_of_threads, m_lts.num_states(), detail::sigref_minimal_parallel_size,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          signature_t& sig = m_sig[s];
+          sig.clear();
+          for (std::size_t i = m_succ_transitions.lowerbound(s); i < m_succ_transitions.upperbound(s); ++i)
+          {
+            const outgoing_pair_t& p = m_succ_transitions.get_transitions()[i];
+            sig.emplace_back(m_lts.apply_hidden_label_map(label(p)), partition[to(p)]);
+          }
+          detail::normalise_signature(sig);
+        }
+      });
   }
 
 };
 
-/** \brief Class for computing the signature for branching bisimulation */
+/** \brief Class for computing the signature for branching bisimulation
+  *
+  * The signature of a state s consists of the pairs (a, B) for which there is a path
+  * s -tau-> s1 -tau-> ... -tau-> sn -a-> t with s, s1, ..., sn in the same block, t in B,
+  * and a not an inert tau step, as described in S. Blom, S. Orzan,
+  * "Distributed Branching Bisimulation Reduction of State Spaces", Proc. PDMC 2003.
+  *
+  * The states on a tau loop always reside in the same block and have the same signature,
+  * which is therefore stored per tau strongly connected component. The components are
+  * ordered by their distance to a component without outgoing tau transitions once, when
+  * this class is created. In every iteration, the components at the same distance are
+  * handled in parallel, after the signatures of all their tau successors are known.
+  */
 template < class LTS_T >
 class signature_branching_bisim: public signature<LTS_T>
 {
 protected:
   using signature<LTS_T>::m_lts;
+  using signature<LTS_T>::m_number_of_threads;
+  using signature<LTS_T>::m_succ_transitions;
   using signature<LTS_T>::m_sig;
 
-  /** \brief Store the incoming transitions per state */
-  outgoing_transitions_per_state_t m_prev_transitions;
+  /** \brief Indicates whether inert tau steps to divergent states are part of the signature */
+  bool m_preserve_divergence;
 
-  /** \brief Insert function
-    * \param[in] partition The current partition
-    * \param[in] t source state
-    * \param[in] label_ transition label
-    * \param[in] block target block
-    *
-    * Insert function as described in S. Blom, S. Orzan,
-    * "Distributed Branching Bisimulation Reduction of State Spaces",
-    * Proc. PDMC 2003.
-    *
-    * Inserts the pair (label_, block) in the signature of t, as well as
-    * the signatures of all tau-predecessors of t within the same block.
+  /** \brief The tau strongly connected component of every state */
+  std::vector<std::size_t> m_scc;
+
+  /** \brief The states of component c are m_scc_states[m_scc_begin[c]], ..., m_scc_states[m_scc_begin[c+1]-1] */
+  std::vector<std::size_t> m_scc_begin;
+  std::vector<std::size_t> m_scc_states;
+
+  /** \brief The components at distance d are m_level_sccs[m_level_begin[d]], ..., m_level_sccs[m_level_begin[d+1]-1] */
+  std::vector<std::size_t> m_level_begin;
+  std::vector<std::size_t> m_level_sccs;
+
+  /** \brief Records for each component whether it has more than one state or a tau self loop */
+  std::vector<bool> m_divergent;
+
+  bool is_tau_transition(const outgoing_pair_t& p) const
+  {
+    return m_lts.is_tau(m_lts.apply_hidden_label_map(label(p)));
+  }
+
+  /** \brief Iterative implementation of Tarjan's SCC algorithm on the tau transitions.
+    * \details Components are numbered in the order in which they are completed, so every
+    *          tau transition leaving component c enters a component with a smaller number.
     */
-  void insert(const std::vector<std::size_t>& partition, const std::size_t t, const std::size_t label_, const std::size_t block)
+  void compute_tau_sccs()
   {
-    if(m_sig[t].insert(std::make_pair(label_, block)).second)
+    const std::size_t n = m_lts.num_states();
+    const std::size_t undefined = std::size_t(-1);
+    std::vector<std::size_t> index(n, undefined);
+    std::vector<std::size_t> low(n, 0);
+    std::vector<bool> on_stack(n, false);
+    std::vector<std::size_t> scc_stack;
+    std::vector<std::pair<std::size_t, std::size_t> > call_stack; // Pairs of a state and the position of the next transition.
+    std::size_t next_index = 0;
+    std::size_t number_of_sccs = 0;
+
+    m_scc.assign(n, undefined);
+    for (std::size_t root = 0; root < n; ++root)
+    {
+      if (index[root] != undefined)
+      {
+        continue;
+      }
+      index[root] = low[root] = next_index++;
+      scc_stack.push_back(root);
+      on_stack[root] = true;
+      call_stack.emplace_back(root, m_succ_transitions.lowerbound(root));
+
+      while (!call_stack.empty())
+      {
+        const std::size_t v = call_stack.back().first;
+        std::size_t& position = call_stack.back().second;
+        if (position < m_succ_transitions.upperbound(v))
+        {
+          const outgoing_pair_t& p = m_succ_transitions.get_transitions()[position++];
+          if (!is_tau_transition(p))
+          {
+            continue;
+          }
+          const std::size_t w = to(p);
+          if (index[w] == undefined)
+          {
+            index[w] = low[w] = next_index++;
+            scc_stack.push_back(w);
+            on_stack[w] = true;
+            call_stack.emplace_back(w, m_succ_transitions.lowerbound(w));
+          }
+          else if (on_stack[w])
+          {
+            low[v] = std::min(low[v], index[w]);
+          }
+          continue;
+        }
+
+        call_stack.pop_back();
+        if (low[v] == index[v])
+        {
+          std::size_t w;
+          do
+          {
+            w = scc_stack.back();
+            scc_stack.pop_back();
+            on_stack[w] = false;
+            m_scc[w] = number_of_sccs;
+          }
+          while (w != v);
+          ++number_of_sccs;
+        }
+        if (!call_stack.empty())
+        {
+          const std::size_t u = call_stack.back().first;
+          low[u] = std::min(low[u], low[v]);
+        }
+      }
+    }
+
+    // Group the states per component.
+    m_scc_begin.assign(number_of_sccs + 1, 0);
+    for (std::size_t s = 0; s < n; ++s)
     {
-      // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> pred_range
-      //    = m_prev_transitions.equal_range(t);
+      m_scc_begin[m_scc[s] + 1]++;
+    }
+    for (std::size_t c = 0; c < number_of_sccs; ++c)
+    {
+      m_scc_begin[c + 1] += m_scc_begin[c];
+    }
+    m_scc_states.resize(n);
+    std::vector<std::size_t> position(m_scc_begin.begin(), m_scc_begin.end() - 1);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      m_scc_states[position[m_scc[s]]++] = s;
+    }
 
-      // for(outgoing_transitions_per_state_t::const_iterator i = pred_range.first; i != pred_range.second; ++i)
-      // for(const outgoing_pair_t& p: m_prev_transitions[t])
-      for (std::size_t i=m_prev_transitions.lowerbound(t); i<m_prev_transitions.upperbound(t); ++i)
+    // Determine the divergent components and the distance of every component to a component
+    // without outgoing tau transitions. Components with a smaller number are handled first.
+    m_divergent.assign(number_of_sccs, false);
+    std::vector<std::size_t> level(number_of_sccs, 0);
+    std::size_t number_of_levels = number_of_sccs == 0 ? 0 : 1;
+    for (std::size_t c = 0; c < number_of_sccs; ++c)
+    {
+      m_divergent[c] = m_scc_begin[c + 1] - m_scc_begin[c] > 1;
+      for (std::size_t j = m_scc_begin[c]; j < m_scc_begin[c + 1]; ++j)
       {
-        const outgoing_pair_t& p = m_prev_transitions.get_transitions()[i];
-        if(m_lts.is_tau(m_lts.apply_hidden_label_map(label(p))) && partition[t] == partition[to(p)])
+        const std::size_t s = m_scc_states[j];
+        for (std::size_t i = m_succ_transitions.lowerbound(s); i < m_succ_transitions.upperbound(s); ++i)
+        {
+          const outgoing_pair_t& p = m_succ_transitions.get_transitions()[i];
+          if (is_tau_transition(p))
+          {
+            if (m_scc[to(p)] != c)
+            {
+              level[c] = std::max(level[c], level[m_scc[to(p)]] + 1);
+            }
+            else if (to(p) == s)
+            {
+              m_divergent[c] = true;
+            }
+          }
+        }
+      }
+      number_of_levels = std::max(number_of_levels, level[c] + 1);
+    }
+
+    m_level_begin.assign(number_of_levels + 1, 0);
+    for (std::size_t c = 0; c < number_of_sccs; ++c)
+    {
+      m_level_begin[level[c] + 1]++;
+    }
+    for (std::size_t d = 0; d < number_of_levels; ++d)
+    {
+      m_level_begin[d + 1] += m_level_begin[d];
+    }
+    m_level_sccs.resize(number_of_sccs);
+    position.assign(m_level_begin.begin(), m_level_begin.end() - 1);
+    for (std::size_t c = 0; c < number_of_sccs; ++c)
+    {
+      m_level_sccs[position[level[c]]++] = c;
+    }
+
+    m_sig.assign(number_of_sccs, signature_t());
+    mCRL2log(log::verbose, "sigref") << "found " << number_of_sccs << " tau strongly connected components at "
+                                     << number_of_levels << " distinct distances" << std::endl;
+  }
+
+  /** \brief Computes the signature of component c, assuming that the signatures of
+    *        the components reachable by a tau transition are known.
+    */
+  void compute_scc_signature(const std::vector<std::size_t>& partition, const std::size_t c)
+  {
+    signature_t& sig = m_sig[c];
+    sig.clear();
+    for (std::size_t j = m_scc_begin[c]; j < m_scc_begin[c + 1]; ++j)
+    {
+      const std::size_t s = m_scc_states[j];
+      for (std::size_t i = m_succ_transitions.lowerbound(s); i < m_succ_transitions.upperbound(s); ++i)
+      {
+        const outgoing_pair_t& p = m_succ_transitions.get_transitions()[i];
+        const std::size_t a = m_lts.apply_hidden_label_map(label(p));
+        const std::size_t t = to(p);
+        if (m_lts.is_tau(a) && partition[s] == partition[t])
+        {
+          // An inert tau step; s inherits the signature of t.
+          if (m_scc[t] != c)
+          {
+            const signature_t& successor_sig = m_sig[m_scc[t]];
+            sig.insert(sig.end(), successor_sig.begin(), successor_sig.end());
+          }
+          if (m_preserve_divergence && m_divergent[m_scc[t]])
+          {
+            sig.emplace_back(a, partition[t]);
+          }
+        }
+        else
         {
-          insert(partition, to(p), label_, block);
+          sig.emplace_back(a, partition[t]);
         }
       }
     }
+    detail::normalise_signature(sig);
+  }
+
+  /** \brief Constructor that indicates whether divergences must be preserved. */
+  signature_branching_bisim(const LTS_T& lts_, const std::size_t number_of_threads, const bool preserve_divergence)
+    : signature<LTS_T>(lts_, number_of_threads),
+      m_preserve_divergence(preserve_divergence)
+  {
+    compute_tau_sccs();
   }
 
 public:
   /** \brief Constructor  */
-  signature_branching_bisim(const LTS_T& lts_)
-    : signature<LTS_T>(lts_),
-      m_prev_transitions(lts_.get_transitions(),lts_.num_states(),false)  // transitions stored backward. 
+  signature_branching_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature_branching_bisim(lts_, number_of_threads, false)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for branching bisimulation" << std::endl;
   }
@@ -160,28 +435,36 @@ public:
   /** \overload */
   virtual void compute_signature(const std::vector<std::size_t>& partition)
   {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    for (std::size_t d = 0; d + 1 < m_level_begin.size(); ++d)
     {
-      if (!(m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())) && (partition[i->from()] == partition[i->to()])))
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
+      detail::sigref_parallel_for(m_number_of_threads, m_level_begin[d + 1] - m_level_begin[d], detail::sigref_minimal_parallel_size,
+        [&](std::size_t, std::size_t first, std::size_t last)
+        {
+          for (std::size_t j = m_level_begin[d] + first; j < m_level_begin[d] + last; ++j)
+          {
+            compute_scc_signature(partition, m_level_sccs[j]);
+          }
+        });
     }
   }
 
   /** \overload */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
   {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    for(const transition& t: m_lts.get_transitions())
     {
-      if(partition[i->from()] != partition[i->to()] || !m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
+      if(partition[t.from()] != partition[t.to()] || !m_lts.is_tau(m_lts.apply_hidden_label_map(t.label())))
       {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
+        transitions.emplace_back(partition[t.from()], m_lts.apply_hidden_label_map(t.label()), partition[t.to()]);
       }
     }
   }
+
+  /** \overload */
+  virtual const signature_t& get_signature(std::size_t i) const
+  {
+    return m_sig[m_scc[i]];
+  }
 };
 
 /** \brief Class for computing the signature for divergence preserving branching bisimulation */
@@ -190,152 +473,35 @@ class signature_divergence_preserving_branching_bisim: public signature_branchin
 {
 protected:
   using signature_branching_bisim<LTS_T>::m_lts;
-  using signature_branching_bisim<LTS_T>::m_sig;
-  using signature_branching_bisim<LTS_T>::insert;
-
-  /** \brief Record for each vertex whether it is in a tau-scc */
-  std::vector<bool> m_divergent;
-
-  /** \brief Iterative implementation of Tarjan's SCC algorithm.
-   *
-   * based on an earlier implementation by Sjoerd Cranen
-   *
-   * For the non-trivial tau-sccs (i.e. SCCs with more than one state, or
-   * single-state SCCs with a tau-loop, we set \a m_divergent to true.
-   */
-  void compute_tau_sccs()
-  {
-    std::size_t unused = 1, lastscc = 1;
-    std::vector<std::size_t> scc(m_lts.num_states(), 0);
-    std::vector<std::size_t> low(m_lts.num_states(), 0);
-    std::stack<std::size_t> stack;
-    std::stack<std::size_t> sccstack;
-
-    // Record forward transition relation sorted by state.
-    outgoing_transitions_per_state_t m_lts_succ_transitions(m_lts.get_transitions(),m_lts.num_states(),true);
-
-    for (std::size_t i = 0; i < m_lts.num_states(); ++i)
-    {
-      if (scc[i] == 0)
-        stack.push(i);
-      while (!stack.empty())
-      {
-        const std::size_t vi = stack.top();
-
-        // Outgoing transitions of vi.
-        // std::pair<outgoing_transitions_per_state_t::const_iterator, outgoing_transitions_per_state_t::const_iterator> succ_range
-        //  = m_lts_succ_transitions.equal_range(vi);
-
-        if (low[vi] == 0 && scc[vi] == 0)
-        {
-          scc[vi] = unused;
-          low[vi] = unused++;
-          sccstack.push(vi);
-
-          // for (outgoing_transitions_per_state_t::const_iterator t = succ_range.first; t != succ_range.second; ++t)
-          // for (const outgoing_pair_t& t: m_lts_succ_transitions[vi]) 
-          // for (const outgoing_pair_t& t: m_lts_succ_transitions[vi]) 
-          for (std::size_t i=m_lts_succ_transitions.lowerbound(vi); i<m_lts_succ_transitions.upperbound(vi); ++i)
-          {
-            const outgoing_pair_t& t=m_lts_succ_transitions.get_transitions()[i];
-            if ((low[to(t)] == 0) && (scc[to(t)] == 0) && (m_lts.is_tau(m_lts.apply_hidden_label_map(label(t)))))
-            {
-              stack.push(to(t));
-            }
-          }
-        }
-        else
-        {
-          // for (outgoing_transitions_per_state_t::const_iterator t = succ_range.first; t != succ_range.second; ++t)
-          for (std::size_t i=m_lts_succ_transitions.lowerbound(vi); i<m_lts_succ_transitions.upperbound(vi); ++i)
-          {
-            const outgoing_pair_t& t=m_lts_succ_transitions.get_transitions()[i];
-            if ((low[to(t)] != 0) && (m_lts.is_tau(m_lts.apply_hidden_label_map(label(t)))))
-              low[vi] = low[vi] < low[to(t)] ? low[vi] : low[to(t)];
-          }
-          if (low[vi] == scc[vi])
-          {
-            std::size_t tos, scc_id = lastscc++;
-            std::vector<std::size_t> this_scc;
-            do
-            {
-              tos = sccstack.top();
-              low[tos] = 0;
-              scc[tos] = scc_id;
-              sccstack.pop();
-              this_scc.push_back(tos);
-            }
-            while (tos != vi);
-
-            // We only consider non-trivial sccs, hence
-            // if the scc consists of a single schate, check whether it has a tau-loop
-            if(this_scc.size() == 1)
-            {
-              // for(outgoing_transitions_per_state_t::const_iterator i = succ_range.first; i != succ_range.second; ++i)
-              // for (const outgoing_pair_t& i: m_lts_succ_transitions[vi]) 
-              for (std::size_t i_=m_lts_succ_transitions.lowerbound(vi); i_<m_lts_succ_transitions.upperbound(vi); ++i_)
-              {
-                const outgoing_pair_t& i=m_lts_succ_transitions.get_transitions()[i_];
-                if(vi == to(i) && m_lts.is_tau(m_lts.apply_hidden_label_map(label(i))))
-                {
-                  m_divergent[tos] = true;
-                  break;
-                }
-              }
-            }
-            else
-            {
-              m_divergent[tos] = true;
-            }
-          }
-          stack.pop();
-        }
-      }
-    }
-  }
 
 public:
   /** \brief Constructor
     *
-    * This initialises \a m_divergent to record for each vertex whether it is
-    * in a tau-scc.
+    * A state is divergent if it is in a tau strongly connected component with more than
+    * one state, or if it has a tau self loop.
     */
-  signature_divergence_preserving_branching_bisim(const LTS_T& lts_)
-    : signature_branching_bisim<LTS_T>(lts_),
-      m_divergent(lts_.num_states(), false)
+  signature_divergence_preserving_branching_bisim(const LTS_T& lts_, const std::size_t number_of_threads = 1)
+    : signature_branching_bisim<LTS_T>(lts_, number_of_threads, true)
   {
     mCRL2log(log::verbose, "sigref") << "initialising signature computation for divergence preserving branching bisimulation" << std::endl;
-    compute_tau_sccs();
   }
 
   /** \overload
     *
-    * Compute the signature as in branching bisimulation. In addition, add the
-    * (tau, B) for edges s -tau-> t for which s,t in B and m_divergent[t]
+    * The signature is computed as in branching bisimulation. In addition, it contains
+    * (tau, B) for edges s -tau-> t for which s,t in B and t is divergent. An inert tau
+    * transition s -tau-> t is kept as a tau loop on B if (tau, B) is in the signature of s.
     */
-  virtual void compute_signature(const std::vector<std::size_t>& partition)
-  {
-    // compute signatures
-    m_sig = std::vector<signature_t>(m_lts.num_states(), signature_t());
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
-    {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_divergent[i->to()])
-      {
-        insert(partition, i->from(), m_lts.apply_hidden_label_map(i->label()), partition[i->to()]);
-      }
-    }
-  }
-
-  /** \overload */
-  virtual void quotient_transitions(std::set<transition>& transitions, const std::vector<std::size_t>& partition)
+  virtual void quotient_transitions(std::vector<transition>& transitions, const std::vector<std::size_t>& partition)
   {
-    for(std::vector<transition>::const_iterator i = m_lts.get_transitions().begin(); i != m_lts.get_transitions().end(); ++i)
+    for(const transition& t: m_lts.get_transitions())
     {
-      if(!(partition[i->from()] == partition[i->to()] && m_lts.is_tau(m_lts.apply_hidden_label_map(i->label())))
-         || m_sig[i->from()].find(std::make_pair(m_lts.apply_hidden_label_map(i->label()), partition[i->to()])) != m_sig[i->from()].end())
+      const std::size_t a = m_lts.apply_hidden_label_map(t.label());
+      if(!(partition[t.from()] == partition[t.to()] && m_lts.is_tau(a))
+         || std::binary_search(this->get_signature(t.from()).begin(), this->get_signature(t.from()).end(),
+                               std::make_pair(a, partition[t.to()])))
       {
-        transitions.insert(transition(partition[i->from()], m_lts.apply_hidden_label_map(i->label()), partition[i->to()]));
+        transitions.emplace_back(partition[t.from()], a, partition[t.to()]);
       }
     }
   }
@@ -348,7 +514,14 @@ public:
   * S. Blom, S. Orzan. "Distributed Branching Bisimulation Reduction of State
   * Spaces", in Proc. PDMC 2003.
   *
-  * The specific signature is a parameter of the algorithm.
+  * The specific signature is a parameter of the algorithm. In every iteration the
+  * signatures of all states are computed, and states with equal signatures are
+  * grouped by inserting them in a hash table. Both steps are divided over the
+  * number of threads with which the signature is created. The hash table is split
+  * in shards by the hash value of the signatures, such that every shard is filled
+  * by a single thread without locking. The blocks are numbered in the order of
+  * the first state with a signature, so the result does not depend on the number
+  * of threads.
   */
 template < class LTS_T, typename Signature >
 class sigref
@@ -369,27 +542,97 @@ protected:
              current equivalence */
   Signature m_signature;
 
+  /** \brief Hashes a state by the precomputed hash value of its signature */
+  struct state_hash
+  {
+    const std::vector<std::size_t>& m_hashes;
+
+    std::size_t operator()(const std::size_t s) const
+    {
+      return m_hashes[s];
+    }
+  };
+
+  /** \brief Considers two states equal if their signatures are equal */
+  struct state_equal
+  {
+    const Signature& m_signature;
+
+    bool operator()(const std::size_t s, const std::size_t t) const
+    {
+      return m_signature.get_signature(s) == m_signature.get_signature(t);
+    }
+  };
+
   /** \brief Print a signature (for debugging purposes) */
   std::string print_sig(const signature_t& sig)
   {
     std::stringstream os;
     os << "{ ";
-    for(signature_t::const_iterator i = sig.begin(); i != sig.end() ; ++i)
+    for(const std::pair<std::size_t, std::size_t>& p: sig)
     {
-      os << " (" << pp(m_lts.action_label(i->first)) << ", " << i->second << ") ";
+      os << " (" << pp(m_lts.action_label(p.first)) << ", " << p.second << ") ";
     }
     os << " }";
     return os.str();
   }
 
+  /** \brief Map every state to the smallest state with the same signature. */
+  void compute_representatives(std::vector<std::size_t>& representative)
+  {
+    const std::size_t n = m_lts.num_states();
+    const std::size_t number_of_threads = m_signature.number_of_threads();
+    const std::size_t number_of_shards = number_of_threads == 1 ? 1 : 16 * number_of_threads;
+
+    std::vector<std::size_t> hashes(n);
+    detail::sigref_parallel_for(number_of_threads, n, detail::sigref_minimal_parallel_size,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t s = first; s < last; ++s)
+        {
+          hashes[s] = detail::hash_signature(m_signature.get_signature(s));
+        }
+      });
+
+    // Sort the states stably by shard.
+    std::vector<std::size_t> shard_begin(number_of_shards + 1, 0);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      shard_begin[hashes[s] % number_of_shards + 1]++;
+    }
+    for (std::size_t i = 0; i < number_of_shards; ++i)
+    {
+      shard_begin[i + 1] += shard_begin[i];
+    }
+    std::vector<std::size_t> states(n);
+    std::vector<std::size_t> position(shard_begin.begin(), shard_begin.end() - 1);
+    for (std::size_t s = 0; s < n; ++s)
+    {
+      states[position[hashes[s] % number_of_shards]++] = s;
+    }
+
+    detail::sigref_parallel_for(number_of_threads, number_of_shards, 1,
+      [&](std::size_t, std::size_t first, std::size_t last)
+      {
+        for (std::size_t shard = first; shard < last; ++shard)
+        {
+          std::unordered_set<std::size_t, state_hash, state_equal> table(
+            shard_begin[shard + 1] - shard_begin[shard], state_hash{hashes}, state_equal{m_signature});
+          for (std::size_t i = shard_begin[shard]; i < shard_begin[shard + 1]; ++i)
+          {
+            representative[states[i]] = *table.insert(states[i]).first;
+          }
+        }
+      });
+  }
+
   /** \brief Compute the partition. Repeatedly updates the signatures, and
              the partition, until the partition stabilises */
   void compute_partition()
   {
     std::size_t count_prev = m_count;
     std::size_t iterations = 0;
-
-    m_lts.sort_transitions(mcrl2::lts::lbl_tgt_src);
+    std::vector<std::size_t> representative(m_lts.num_states());
 
     do
     {
@@ -400,22 +643,20 @@ protected:
 
       count_prev = m_count;
 
-      // Map signatures to block numbers
-      std::map<signature_t, std::size_t> hashtable;
+      // Map signatures to block numbers, in the order of the first state with that signature.
+      compute_representatives(representative);
       m_count = 0;
       for(std::size_t i = 0; i < m_lts.num_states(); ++i)
       {
-        if(hashtable.find(m_signature.get_signature(i)) == hashtable.end())
+        if (representative[i] == i)
         {
           mCRL2log(log::debug, "sigref") << "Adding block for signature " << print_sig(m_signature.get_signature(i)) << std::endl;
-          hashtable[m_signature.get_signature(i)] = m_count++;
+          m_partition[i] = m_count++;
+        }
+        else
+        {
+          m_partition[i] = m_partition[representative[i]];
         }
-      }
-
-      // Map states to block numbers
-      for(std::size_t i = 0; i < m_lts.num_states(); ++i)
-      {
-        m_partition[i] = hashtable[m_signature.get_signature(i)];
       }
 
       ++iterations;
@@ -435,26 +676,29 @@ protected:
 
     // Compute quotient transitions
     // implemented in the signature class because it differs per equivalence.
-    std::set<transition> transitions;
+    std::vector<transition> transitions;
     m_signature.quotient_transitions(transitions, m_partition);
+    std::sort(transitions.begin(), transitions.end());
+    transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
 
     // Set quotient transitions
-    m_lts.clear_transitions();
-    for(std::set<transition>::const_iterator i = transitions.begin(); i != transitions.end(); ++i)
+    m_lts.clear_transitions(transitions.size());
+    for(const transition& t: transitions)
     {
-      m_lts.add_transition(*i);
+      m_lts.add_transition(t);
     }
   }
 
 public:
   /** \brief Constructor
     * \param[in] lts_ The LTS that is being reduced
+    * \param[in] number_of_threads The number of threads used to compute the partition
     */
-  sigref(LTS_T& lts_)
+  sigref(LTS_T& lts_, const std::size_t number_of_threads = 1)
     : m_partition(std::vector<std::size_t>(lts_.num_states(), 0)),
       m_count(0),
       m_lts(lts_),
-      m_signature(lts_)
+      m_signature(lts_, number_of_threads)
   {}
 
   /** \brief Perform the reduction, modulo the equivalence for which the
@@ -630,6 +630,10 @@ struct state_space_generator
         // discover_state
         [&](const lps::state& s, std::size_t s_index)
         {
+          if constexpr (!Stochastic)
+          {
+            builder.add_state(s, s_index);
+          }
           if (options.generate_traces && source)
           {
             m_trace_constructor.add_edge(*source, s);
@@ -704,6 +708,10 @@ struct state_space_generator
         }
       );
       m_progress_monitor.finish_exploration(explorer.state_map().size());
+      if (options.cached)
+      {
+        mCRL2log(log::verbose) << explorer.cache_statistics() << std::endl;
+      }
       builder.finalize(explorer.state_map());
     }
     catch (const data::enumerator_error& e)
@@ -103,7 +103,8 @@ void lps2lts_algorithm::initialise_lts_generation(const lts_generation_options&
   }
   else
   {
-    m_state_numbers = utilities::indexed_set<lps::state>(m_options.initial_table_size);
+    m_state_numbers = detail::state_numbers_set(m_options.initial_table_size, m_options.tree_compression,
+                                                 m_options.specification.process().process_parameters().size());
   }
 
   m_num_states = 0;
@@ -267,7 +268,8 @@ void lps2lts_algorithm::initialise_lts_generation(const lts_generation_options&
       }
     }
   }
-  m_generator = new next_state_generator(specification, rewriter, base_substitution, m_options.use_enumeration_caching, m_options.use_summand_pruning);
+  m_generator = new next_state_generator(specification, rewriter, base_substitution, m_options.use_enumeration_caching, m_options.use_summand_pruning,
+                                         m_options.enumeration_cache_size, m_options.enumeration_cache_policy, m_options.use_summand_index);
 
   if (m_use_confluence_reduction)
   {
@@ -411,6 +413,11 @@ bool lps2lts_algorithm::generate_lts(const lts_generation_options& options)
     return false;
   }
 
+  if (m_options.use_enumeration_caching)
+  {
+    mCRL2log(verbose) << m_generator->enumeration_cache_statistics() << std::endl;
+  }
+
   finalise_lts_generation();
   return true;
 }
@@ -8,10 +8,14 @@
 //
 /// \file liblts_aut.cpp
 
-#include <string>
-#include <sstream>
+#include <cctype>
+#include <charconv>
 #include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
 #include <unordered_map>
+#include <vector>
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
 
@@ -20,24 +24,181 @@ using namespace mcrl2::lts;
 using namespace std;
 
 
-static void read_newline(istream& is, const std::size_t line_no)
+namespace
+{
+
+/// \brief Reads an input stream in large blocks and provides the character level operations
+///        to tokenize an .aut file, which avoids the overhead of formatted extraction per character.
+class aut_input
+{
+  protected:
+    istream& m_stream;
+    std::vector<char> m_buffer;
+    const char* m_current = nullptr;
+    const char* m_end = nullptr;
+
+    // Reads the next block of the stream. Returns false if there are no more characters.
+    bool fill()
+    {
+      m_stream.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+      m_current = m_buffer.data();
+      m_end = m_current + m_stream.gcount();
+      return m_current != m_end;
+    }
+
+  public:
+    static constexpr int end_of_input = -1;
+
+    explicit aut_input(istream& stream)
+      : m_stream(stream),
+        m_buffer(1 << 16)
+    {}
+
+    /// \returns The next character without consuming it, or end_of_input.
+    int peek()
+    {
+      if (m_current == m_end && !fill())
+      {
+        return end_of_input;
+      }
+      return static_cast<unsigned char>(*m_current);
+    }
+
+    /// \returns The next character, or end_of_input.
+    int get()
+    {
+      int ch = peek();
+      if (ch != end_of_input)
+      {
+        ++m_current;
+      }
+      return ch;
+    }
+
+    void skip_whitespace()
+    {
+      do
+      {
+        for (; m_current != m_end; ++m_current)
+        {
+          if (!std::isspace(static_cast<unsigned char>(*m_current)))
+          {
+            return;
+          }
+        }
+      }
+      while (fill());
+    }
+
+    /// \returns The next character that is not a whitespace, or end_of_input.
+    int get_non_whitespace()
+    {
+      skip_whitespace();
+      return get();
+    }
+
+    /// \returns The next character that is not a whitespace without consuming it, or end_of_input.
+    int peek_non_whitespace()
+    {
+      skip_whitespace();
+      return peek();
+    }
+
+    /// \brief Skips whitespace and reads a natural number.
+    /// \returns False if the next non whitespace character is not a digit.
+    bool read_number(std::size_t& result)
+    {
+      int ch = peek_non_whitespace();
+      if (!std::isdigit(ch))
+      {
+        return false;
+      }
+
+      result = 0;
+      do
+      {
+        result = 10 * result + static_cast<std::size_t>(ch - '0');
+        ++m_current;
+        ch = peek();
+      }
+      while (std::isdigit(ch));
+      return true;
+    }
+};
+
+/// \brief Collects the output in a large buffer that is written to the stream in blocks,
+///        and formats numbers without the overhead of formatted output streams.
+class aut_output
 {
-  char ch;
-  is.get(ch);
+  protected:
+    static constexpr std::size_t buffer_size = 1 << 16;
+
+    ostream& m_stream;
+    std::string m_buffer;
+
+  public:
+    explicit aut_output(ostream& stream)
+      : m_stream(stream)
+    {
+      m_buffer.reserve(buffer_size + 64);
+    }
+
+    void write(char ch)
+    {
+      m_buffer.push_back(ch);
+    }
+
+    void write(const char* s)
+    {
+      m_buffer.append(s);
+    }
+
+    void write(const std::string& s)
+    {
+      m_buffer.append(s);
+    }
+
+    void write(std::size_t n)
+    {
+      char digits[std::numeric_limits<std::size_t>::digits10 + 1];
+      m_buffer.append(digits, std::to_chars(digits, digits + sizeof(digits), n).ptr);
+    }
+
+    /// \brief Writes the buffer to the stream if it is full.
+    void flush_if_full()
+    {
+      if (m_buffer.size() >= buffer_size)
+      {
+        flush();
+      }
+    }
+
+    void flush()
+    {
+      m_stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+      m_buffer.clear();
+    }
+};
+
+} // namespace
+
+static void read_newline(aut_input& is, const std::size_t line_no)
+{
+  int ch = is.get();
 
   // Skip over spaces
   while (ch == ' ')
   {
-    is.get(ch);
+    ch = is.get();
   }
 
   // Windows systems typically have a carriage return before a newline.
   if (ch == '\r')
   {
-    is.get(ch);
+    ch = is.get();
   }
 
-  if (ch != '\n' && !is.eof()) // Last line does not need to be terminated with an eoln.
+  if (ch != '\n' && ch != aut_input::end_of_input) // Last line does not need to be terminated with an eoln.
   {
     if (line_no==1)
     {
@@ -50,17 +211,15 @@ static void read_newline(istream& is, const std::size_t line_no)
   }
 }
 
-// reads a number, puts it in s, and reads one extra character, which must be either a space or a closing bracket.
-static void read_natural_number_to_string(istream& is, string& s, const std::size_t line_no)
+// reads a number and puts it in s.
+static void read_natural_number_to_string(aut_input& is, string& s, const std::size_t line_no)
 {
   assert(s.empty());
-  char ch;
-  is >> skipws >> ch;
-  for( ; isdigit(ch) ; is.get(ch))
+  is.skip_whitespace();
+  while (std::isdigit(is.peek()))
   {
-    s.push_back(ch);
+    s.push_back(static_cast<char>(is.get()));
   }
-  is.putback(ch);
   if (s.empty())
   {
     throw mcrl2::runtime_error("Expect a number at line " + std::to_string(line_no) + ".");
@@ -104,48 +263,43 @@ static void check_states(mcrl2::lts::probabilistic_lts_aut_t::probabilistic_stat
   }
 } 
 
+static void read_state(aut_input& is, std::size_t& state, const std::size_t line_no)
+{
+  if (!is.read_number(state))
+  {
+    throw mcrl2::runtime_error("Expect a state number at line " + std::to_string(line_no) + ".");
+  }
+}
+
 // This procedure tries to read states, indicated by numbers
 // with in between fractions of the shape number/number. The
 // last state number is put in state. The remainder as pairs
 // in the vector. Typical expected input is 3 2/3 4 1/6 78 1/6 3.
 static void read_probabilistic_state(
-  istream& is,
+  aut_input& is,
   mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& result,
   const std::size_t line_no)
 {
   assert(result.size()==0);
 
   std::size_t state;
-
-  is >> skipws >> state;
-
-  if (!is.good())
-  {
-    throw mcrl2::runtime_error("Expect a state number at line " + std::to_string(line_no) + ".");
-  }
+  read_state(is, state, line_no);
 
   // Check whether the next character is a digit. If so a probability follows.
-  char ch;
-  is >> skipws >> ch;
-  is.putback(ch);
-
-  if (!isdigit(ch))
+  if (!std::isdigit(is.peek_non_whitespace()))
   {
     // There is only a single state.
     result.set(state);
     return;
   }
-  bool ready=false;
 
   mcrl2::lts::probabilistic_arbitrary_precision_fraction remainder=mcrl2::lts::probabilistic_arbitrary_precision_fraction::one();
-  while (is.good() && !ready)
+  do
   {
     // Now read a probabilities followed by the next state.
     string enumerator;
     read_natural_number_to_string(is,enumerator,line_no);
-    char ch;
-    is >> skipws >> ch;
-    if (ch != '/')
+    if (is.get_non_whitespace() != '/')
     {
       throw mcrl2::runtime_error("Expect a / in a probability at line " + std::to_string(line_no) + ".");
     }
@@ -155,73 +309,55 @@ static void read_probabilistic_state(
     mcrl2::lts::probabilistic_arbitrary_precision_fraction frac(enumerator,denominator);
     remainder=remainder-frac;
     result.add(state, frac);
-    
-    is >> skipws >> state;
-
-    if (!is.good())
-    {
-      throw mcrl2::runtime_error("Expect a state number at line " + std::to_string(line_no) + ".");
-    }
 
-    // Check whether the next character is a digit.
-    
-    is >> skipws >> ch;
-    is.putback(ch);
-
-    if (!isdigit(ch))
-    {
-      ready=true;
-    }
+    read_state(is, state, line_no);
   }
-  
+  while (std::isdigit(is.peek_non_whitespace())); // Check whether the next character is a digit.
+
   result.add(state, remainder);
 }
 
 
 static void read_aut_header(
-  istream& is,
+  aut_input& is,
   mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& initial_state,
   std::size_t& num_transitions,
   std::size_t& num_states)
 {
-  string s;
-  is.width(3);
-  is >> skipws >> s;
-
-  if (s!="des")
+  is.skip_whitespace();
+  if (is.get() != 'd' || is.get() != 'e' || is.get() != 's')
   {
     throw mcrl2::runtime_error("Expect an .aut file to start with 'des'.");
   }
 
-  char ch;
-  is >> skipws >> ch;
-
-  if (ch != '(')
+  if (is.get_non_whitespace() != '(')
   {
     throw mcrl2::runtime_error("Expect an opening bracket '(' after 'des' in the first line of a .aut file.");
   }
 
   read_probabilistic_state(is,initial_state,1);
 
-  is >> skipws >> ch;
-  if (ch != ',')
+  if (is.get_non_whitespace() != ',')
   {
     throw mcrl2::runtime_error("Expect a comma after the first number in the first line of a .aut file.");
   }
 
-  is >> skipws >> num_transitions;
+  if (!is.read_number(num_transitions))
+  {
+    throw mcrl2::runtime_error("Expect the number of transitions as the second number in the first line of a .aut file.");
+  }
 
-  is >> skipws >> ch;
-  if (ch != ',')
+  if (is.get_non_whitespace() != ',')
   {
     throw mcrl2::runtime_error("Expect a comma after the second number in the first line of a .aut file.");
   }
 
-  is >> skipws >> num_states;
-
-  is >> ch;
+  if (!is.read_number(num_states))
+  {
+    throw mcrl2::runtime_error("Expect the number of states as the third number in the first line of a .aut file.");
+  }
 
-  if (ch != ')')
+  if (is.get_non_whitespace() != ')')
   {
     throw mcrl2::runtime_error("Expect a closing bracket ')' after the third number in the first line of a .aut file.");
   }
@@ -230,14 +366,13 @@ static void read_aut_header(
 }
 
 static bool read_initial_part_of_an_aut_transition(
-  istream& is,
+  aut_input& is,
   std::size_t& from,
   string& label,
   const std::size_t line_no)
 {
-  char ch;
-  is >> skipws >> ch;
-  if (is.eof())
+  int ch = is.get_non_whitespace();
+  if (ch == aut_input::end_of_input)
   {
     return false;
   }
@@ -246,42 +381,39 @@ static bool read_initial_part_of_an_aut_transition(
     throw mcrl2::runtime_error("Expect opening bracket at line " + std::to_string(line_no) + ".");
   }
 
-  is >> skipws >> from;
+  read_state(is, from, line_no);
 
-  is >> skipws >> ch;
-  if (ch != ',')
+  if (is.get_non_whitespace() != ',')
   {
     throw mcrl2::runtime_error("Expect that the first number is followed by a comma at line " + std::to_string(line_no) + ".");
   }
 
-  is >> skipws >> ch;
+  label.clear();
+  ch = is.get_non_whitespace();
   if (ch == '"')
   {
-    label="";
     // In case the label is using quotes whitespaces
     // in the label are preserved. 
-    is >> noskipws >> ch;
-    while ((ch != '"') && !is.eof())
+    ch = is.get();
+    while (ch != '"' && ch != aut_input::end_of_input)
     {
-      label.push_back(ch);
-      is >> ch;
+      label.push_back(static_cast<char>(ch));
+      ch = is.get();
     }
     if (ch != '"')
     {
       throw mcrl2::runtime_error("Expect that the second item is a quoted label (using \") at line " + std::to_string(line_no) + ".");
     }
-    is >> skipws >> ch;
+    ch = is.get_non_whitespace();
   }
   else
   {
     // In case the label is not within quotes,
     // whitespaces are removed from the label. 
-    label = ch;
-    is >> ch;
-    while ((ch != ',') && !is.eof())
+    while (ch != ',' && ch != aut_input::end_of_input)
     {
-      label.push_back(ch);
-      is >> ch;
+      label.push_back(static_cast<char>(ch));
+      ch = is.get_non_whitespace();
     }
   }
 
@@ -293,8 +425,18 @@ static bool read_initial_part_of_an_aut_transition(
   return true;
 }
 
+static void read_end_of_aut_transition(aut_input& is, const std::size_t line_no)
+{
+  if (is.get_non_whitespace() != ')')
+  {
+    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
+  }
+
+  read_newline(is,line_no);
+}
+
 static bool read_aut_transition(
-  istream& is,
+  aut_input& is,
   std::size_t& from,
   string& label,
   mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& target_probabilistic_state,
@@ -306,20 +448,12 @@ static bool read_aut_transition(
   }
 
   read_probabilistic_state(is,target_probabilistic_state,line_no);
-
-  char ch;
-  is >> ch;
-  if (ch != ')')
-  {
-    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
-  }
-
-  read_newline(is,line_no);
+  read_end_of_aut_transition(is,line_no);
   return true;
 }
 
 static bool read_aut_transition(
-  istream& is,
+  aut_input& is,
   std::size_t& from,
   string& label,
   std::size_t& to,
@@ -330,22 +464,15 @@ static bool read_aut_transition(
     return false;
   }
 
-  is >> skipws >> to;
-
-  char ch;
-  is >> ch;
-  if (ch != ')')
-  {
-    throw mcrl2::runtime_error("Expect a closing bracket at the end of the transition at line " + std::to_string(line_no) + ".");
-  }
-
-  read_newline(is,line_no);
+  read_state(is, to, line_no);
+  read_end_of_aut_transition(is,line_no);
   return true;
 }
 
 
-static void read_from_aut(probabilistic_lts_aut_t& l, istream& is)
+static void read_from_aut(probabilistic_lts_aut_t& l, istream& stream)
 {
+  aut_input is(stream);
   std::size_t line_no = 1;
   std::size_t ntrans=0, nstate=0;
 
@@ -377,7 +504,7 @@ static void read_from_aut(probabilistic_lts_aut_t& l, istream& is)
   std::size_t from;
   string s;
 
-  while (!is.eof())
+  while (true)
   {
     probabilistic_target_state.clear();
 
@@ -424,8 +551,9 @@ static void read_from_aut(probabilistic_lts_aut_t& l, istream& is)
   }
 }
 
-static void read_from_aut(lts_aut_t& l, istream& is)
+static void read_from_aut(lts_aut_t& l, istream& stream)
 {
+  aut_input is(stream);
   std::size_t line_no = 1;
   std::size_t ntrans=0, nstate=0;
 
@@ -453,7 +581,7 @@ static void read_from_aut(lts_aut_t& l, istream& is)
 
   std::size_t from, to;
   string s;
-  while (!is.eof())
+  while (true)
   {
     line_no++;
 
@@ -475,7 +603,7 @@ static void read_from_aut(lts_aut_t& l, istream& is)
 }
 
 
-static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, ostream& os)
+static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t::probabilistic_state_t& prob_state, aut_output& os)
 {
   mcrl2::lts::probabilistic_arbitrary_precision_fraction previous_probability;
   bool first_element=true;
@@ -483,45 +611,80 @@ static void write_probabilistic_state(const mcrl2::lts::probabilistic_lts_aut_t:
   {
     if (first_element)
     {
-      os << p.state();
+      os.write(p.state());
       previous_probability=p.probability();
       first_element=false;
     }
     else
     {
-      os << " " << pp(previous_probability) << " " << p.state();
+      os.write(' ');
+      os.write(pp(previous_probability));
+      os.write(' ');
+      os.write(p.state());
       previous_probability=p.probability();
     }
   }
 }
 
-static void write_to_aut(const probabilistic_lts_aut_t& l, ostream& os)
+// Returns for every action label the text that is written between the source and the target of a transition.
+template <class AUT_LTS_TYPE>
+static std::vector<std::string> aut_label_texts(const AUT_LTS_TYPE& l)
+{
+  std::vector<std::string> result;
+  result.reserve(l.num_action_labels());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    result.push_back(",\"" + pp(l.action_label(l.apply_hidden_label_map(i))) + "\",");
+  }
+  return result;
+}
+
+static void write_to_aut(const probabilistic_lts_aut_t& l, ostream& stream)
 {
-  // Do not use "endl" below to avoid flushing. Use "\n" instead.
-  os << "des (";
+  aut_output os(stream);
+  os.write("des (");
   write_probabilistic_state(l.initial_probabilistic_state(),os);
+  os.write(',');
+  os.write(l.num_transitions());
+  os.write(',');
+  os.write(l.num_states());
+  os.write(")\n");
 
-  os << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n";
-
+  const std::vector<std::string> label_texts = aut_label_texts(l);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\",";
+    os.write('(');
+    os.write(t.from());
+    os.write(label_texts[t.label()]);
     write_probabilistic_state(l.probabilistic_state(t.to()),os);
-    os << ")" << "\n";
+    os.write(")\n");
+    os.flush_if_full();
   }
+  os.flush();
 }
 
-static void write_to_aut(const lts_aut_t& l, ostream& os)
+static void write_to_aut(const lts_aut_t& l, ostream& stream)
 {
-  // Do not use "endl" below to avoid flushing. Use "\n" instead.
-  os << "des (" << l.initial_state() << "," << l.num_transitions() << "," << l.num_states() << ")" << "\n"; 
-
+  aut_output os(stream);
+  os.write("des (");
+  os.write(l.initial_state());
+  os.write(',');
+  os.write(l.num_transitions());
+  os.write(',');
+  os.write(l.num_states());
+  os.write(")\n");
+
+  const std::vector<std::string> label_texts = aut_label_texts(l);
   for (const transition& t: l.get_transitions())
   {
-    os << "(" << t.from() << ",\"" 
-       << pp(l.action_label(l.apply_hidden_label_map(t.label()))) << "\"," 
-       << t.to() << ")" << "\n";
+    os.write('(');
+    os.write(t.from());
+    os.write(label_texts[t.label()]);
+    os.write(t.to());
+    os.write(")\n");
+    os.flush_if_full();
   }
+  os.flush();
 }
 
 namespace mcrl2
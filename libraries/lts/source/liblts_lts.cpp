@@ -14,6 +14,7 @@
 #include "mcrl2/lps/multi_action.h"
 #include "mcrl2/lts/lts_lts.h"
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <cstring>
@@ -44,6 +45,17 @@ static atermpp::function_symbol lts_header()
   return lts_h;
 }
 
+// The revision of the format, which is written as the first term of an .lts file. Files without this term have
+// revision 0, in which every transition is written as a separate term. As of revision 1, the transitions of non
+// probabilistic transition systems are written as blocks of integers, see write_transitions.
+static const std::size_t lts_format_revision = 1;
+
+static atermpp::function_symbol lts_revision_header()
+{
+  static atermpp::function_symbol r_h("labelled_transition_system_revision", 1);
+  return r_h;
+}
+
 // A simple transition of three aterm_int indicating the from, label and to states.
 static atermpp::function_symbol transition_header()
 {
@@ -58,6 +70,14 @@ static atermpp::function_symbol probabilistic_transition_header()
   return t_h;
 }
 
+// A header with a single aterm_int indicating the number of transitions that directly follow it as a block of
+// integers, see write_transitions.
+static atermpp::function_symbol transitions_header()
+{
+  static atermpp::function_symbol t_h("transitions", 1);
+  return t_h;
+}
+
 static atermpp::function_symbol multi_action_header()
 {
   static atermpp::function_symbol ma_h("multi_action", 2);
@@ -124,12 +144,70 @@ static void decode_initial_state(probabilistic_lts_lts_t& lts, const probabilist
   lts.set_initial_probabilistic_state(initial_state);
 }
 
-static aterm encode_transition(const lts_lts_t& lts, const transition& trans)
+/// \brief Encodes the difference x - y as a natural number, such that small differences have small encodings.
+static std::size_t encode_difference(std::size_t x, std::size_t y)
+{
+  return x >= y ? (x - y) << 1 : ((y - x) << 1) - 1;
+}
+
+/// \brief Returns the x such that encode_difference(x, y) is equal to difference.
+static std::size_t decode_difference(std::size_t difference, std::size_t y)
+{
+  return (difference & 1) == 0 ? y + (difference >> 1) : y - ((difference + 1) >> 1);
+}
+
+/// \brief Writes the transitions as a block of integers, instead of a term per transition.
+/// \details The block is preceded by a transitions_header term with the number of transitions. Every transition is
+///          written as the difference between its source and the source of the previous transition, its label, and
+///          the difference between its target and its source. All these numbers are written in a variable width
+///          encoding, so this typically takes a few bytes per transition. The label of every transition is
+///          replaced by label(trans.label()).
+template <typename LabelFunction>
+static void write_transitions(atermpp::binary_aterm_output& stream, const std::vector<transition>& transitions, LabelFunction label)
 {
-  return atermpp::aterm_appl(transition_header(),
-    aterm_int(trans.from()),
-    aterm_int(lts.apply_hidden_label_map(trans.label())),
-    aterm_int(trans.to()));
+  stream << atermpp::aterm_appl(transitions_header(), aterm_int(transitions.size()));
+
+  std::size_t previous_from = 0;
+  for (const transition& trans : transitions)
+  {
+    stream.write_integer(encode_difference(trans.from(), previous_from));
+    stream.write_integer(label(trans.label()));
+    stream.write_integer(encode_difference(trans.to(), trans.from()));
+    previous_from = trans.from();
+  }
+}
+
+static void add_transition(lts_lts_t& lts, std::size_t from, std::size_t label, std::size_t to)
+{
+  lts.add_transition(transition(from, label, to));
+}
+
+static void add_transition(probabilistic_lts_lts_t& lts, std::size_t from, std::size_t label, std::size_t to)
+{
+  std::size_t target_index = lts.add_probabilistic_state(probabilistic_lts_lts_t::probabilistic_state_t(to));
+  lts.add_transition(transition(from, label, target_index));
+}
+
+/// \brief Reads a block of number_of_transitions transitions that is written by write_transitions.
+template <class LTS_TRANSITION_SYSTEM>
+static void read_transitions(atermpp::binary_aterm_input& stream, LTS_TRANSITION_SYSTEM& lts, std::size_t number_of_transitions)
+{
+  // A file can contain many blocks, so the capacity is increased geometrically.
+  std::vector<transition>& transitions = lts.get_transitions();
+  if (transitions.capacity() < transitions.size() + number_of_transitions)
+  {
+    transitions.reserve(std::max(transitions.size() + number_of_transitions, 2 * transitions.capacity()));
+  }
+
+  std::size_t previous_from = 0;
+  for (std::size_t i = 0; i < number_of_transitions; ++i)
+  {
+    const std::size_t from = decode_difference(stream.read_integer(), previous_from);
+    const std::size_t label = stream.read_integer();
+    const std::size_t to = decode_difference(stream.read_integer(), from);
+    add_transition(lts, from, label, to);
+    previous_from = from;
+  }
 }
 
 static aterm encode_transition(const probabilistic_lts_lts_t& lts, const transition& trans)
@@ -221,6 +299,8 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
   try
   {
     atermpp::binary_aterm_input stream(filename.empty() ? std::cin : fstream, data::detail::add_index_impl);
+    const std::string source = filename.empty() ? std::string("standard input") : "the file " + filename;
+    std::size_t revision = 0;
 
     while (true)
     {
@@ -231,8 +311,28 @@ static void read_from_lts(LTS_TRANSITION_SYSTEM& lts, const std::string& filenam
         break;
       }
 
-      if (term.function() == transition_header() || term.function() == probabilistic_transition_header())
+      if (term.function() == lts_revision_header())
+      {
+        revision = static_cast<const aterm_int&>(static_cast<const aterm_appl&>(term)[0]).value();
+        if (revision > lts_format_revision)
+        {
+          throw mcrl2::runtime_error("The lts in " + source + " has format revision " + std::to_string(revision) +
+                                     ", but this version of the toolset can only read revisions up to " +
+                                     std::to_string(lts_format_revision) + ".");
+        }
+      }
+      else if (term.function() == transitions_header())
       {
+        if (revision < 1)
+        {
+          throw mcrl2::runtime_error("The lts in " + source + " contains a block of transitions, but does not start with a format revision.");
+        }
+        const aterm_appl& appl = static_cast<const aterm_appl&>(term);
+        read_transitions(stream, lts, static_cast<const aterm_int&>(appl[0]).value());
+      }
+      else if (term.function() == transition_header() || term.function() == probabilistic_transition_header())
+      {
+        // Transitions written as separate terms, which are written for probabilistic transition systems and by earlier versions.
         const aterm_appl& appl = static_cast<const aterm_appl&>(term);
         decode_transition(lts, appl);
       }
@@ -311,6 +411,7 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
   try
   {
     atermpp::binary_aterm_output stream(filename.empty() ? std::cout : fstream, data::detail::remove_index_impl);
+    stream << atermpp::aterm_appl(lts_revision_header(), aterm_int(lts_format_revision));
 
     if (lts.has_state_info())
     {
@@ -329,9 +430,16 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
       }
     }
 
-    for (auto& trans : lts.get_transitions())
+    if constexpr (std::is_same<LTS_TRANSITION_SYSTEM, lts_lts_t>::value)
+    {
+      write_transitions(stream, lts.get_transitions(), [&](std::size_t label) { return lts.apply_hidden_label_map(label); });
+    }
+    else
     {
-      stream << encode_transition(lts, trans);
+      for (auto& trans : lts.get_transitions())
+      {
+        stream << encode_transition(lts, trans);
+      }
     }
 
     // Write the header of the labelled transition system at the end, because the initial state must be set of adding the transitions.
@@ -355,6 +463,118 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
 
 // Implementation of public functions.
 
+// The number of transitions that lts_lts_disk_writer writes in a single block.
+static const std::size_t lts_lts_disk_writer_block_size = 1 << 16;
+
+lts_lts_disk_writer::lts_lts_disk_writer(const std::string& filename,
+                                         const data::data_specification& data,
+                                         const data::variable_list& process_parameters,
+                                         const process::action_label_list& action_label_declarations)
+  : m_filename(filename),
+    m_data(data),
+    m_process_parameters(process_parameters),
+    m_action_label_declarations(action_label_declarations)
+{
+  mCRL2log(log::verbose) << "Starting to write an lts to the file " << filename << ".\n";
+  if (!filename.empty())
+  {
+    m_fstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    try
+    {
+      m_fstream.open(filename, std::ofstream::out | std::ofstream::binary);
+    }
+    catch (std::ofstream::failure&)
+    {
+      throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+    }
+  }
+  m_stream.reset(new atermpp::binary_aterm_output(filename.empty() ? std::cout : m_fstream, data::detail::remove_index_impl));
+  try
+  {
+    *m_stream << atermpp::aterm_appl(detail::lts_revision_header(), atermpp::aterm_int(detail::lts_format_revision));
+  }
+  catch (std::ofstream::failure&)
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + m_filename + ".");
+  }
+  m_transitions.reserve(lts_lts_disk_writer_block_size);
+}
+
+void lts_lts_disk_writer::add_state(const state_label_lts& label)
+{
+  try
+  {
+    *m_stream << label;
+  }
+  catch (std::ofstream::failure&)
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + m_filename + ".");
+  }
+}
+
+void lts_lts_disk_writer::add_action(const action_label_lts& label)
+{
+  try
+  {
+    *m_stream << atermpp::aterm_appl(detail::multi_action_header(), label.actions(), label.time());
+  }
+  catch (std::ofstream::failure&)
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + m_filename + ".");
+  }
+}
+
+void lts_lts_disk_writer::add_transition(const transition& t)
+{
+  m_transitions.push_back(t);
+  if (m_transitions.size() == lts_lts_disk_writer_block_size)
+  {
+    write_transitions();
+  }
+}
+
+void lts_lts_disk_writer::write_transitions()
+{
+  try
+  {
+    detail::write_transitions(*m_stream, m_transitions, [](std::size_t label) { return label; });
+  }
+  catch (std::ofstream::failure&)
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + m_filename + ".");
+  }
+  m_transitions.clear();
+}
+
+void lts_lts_disk_writer::close(std::size_t initial_state, std::size_t number_of_states)
+{
+  if (!m_transitions.empty())
+  {
+    write_transitions();
+  }
+
+  try
+  {
+    *m_stream << atermpp::aterm_appl(detail::lts_header(),
+                  data::detail::data_specification_to_aterm(m_data),
+                  m_process_parameters,
+                  m_action_label_declarations,
+                  detail::encode_probabilitistic_state(probabilistic_lts_lts_t::probabilistic_state_t(initial_state)),
+                  atermpp::aterm_int(number_of_states));
+
+    // Destroying the stream writes the end of the stream.
+    m_stream.reset();
+    if (m_fstream.is_open())
+    {
+      m_fstream.close();
+    }
+  }
+  catch (std::ofstream::failure&)
+  {
+    throw mcrl2::runtime_error("Fail to write lts correctly to the file " + m_filename + ".");
+  }
+}
+
 void probabilistic_lts_lts_t::save(const std::string& filename) const
 {
   mCRL2log(log::verbose) << "Starting to save a probabilistic lts to the file " << filename << ".\n";
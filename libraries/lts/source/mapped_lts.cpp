@@ -0,0 +1,288 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mapped_lts.cpp
+
+#include "mcrl2/lts/mapped_lts.h"
+#include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/platform.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mcrl2
+{
+namespace lts
+{
+
+namespace
+{
+
+/// \brief The header of a mapped lts, followed by num_states + 1 offsets, num_transitions labels and num_transitions
+///        targets. All fields are stored in the byte order of the machine that wrote the file.
+struct mapped_lts_header
+{
+  char magic[8];
+  std::uint64_t byte_order;
+  std::uint64_t index_width; // 4 or 8 bytes.
+  std::uint64_t num_states;
+  std::uint64_t num_action_labels;
+  std::uint64_t num_transitions;
+  std::uint64_t initial_state;
+  std::uint64_t reserved;
+};
+
+constexpr char MAPPED_LTS_MAGIC[8] = { 'm', 'C', 'R', 'L', '2', 'm', 'l', 't' };
+constexpr std::uint64_t MAPPED_LTS_BYTE_ORDER = 0x0102030405060708ULL;
+
+/// \brief Writes value(i) for all i < size as an array of T.
+template <typename T, typename Function>
+void write_array(std::ofstream& stream, std::size_t size, Function value)
+{
+  // Write in chunks to avoid constructing the whole array in memory.
+  constexpr std::size_t chunk_size = 1 << 16;
+  std::vector<T> buffer;
+  buffer.reserve(chunk_size);
+  for (std::size_t first = 0; first < size; first += chunk_size)
+  {
+    buffer.clear();
+    std::size_t last = std::min(first + chunk_size, size);
+    for (std::size_t i = first; i < last; ++i)
+    {
+      buffer.push_back(static_cast<T>(value(i)));
+    }
+    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(T));
+  }
+}
+
+template <typename T>
+void write_arrays(std::ofstream& stream,
+                  const std::vector<std::size_t>& offsets,
+                  const std::vector<std::size_t>& order,
+                  const std::vector<transition>& transitions,
+                  const std::vector<std::size_t>& hidden_label)
+{
+  write_array<T>(stream, offsets.size(), [&](std::size_t i) { return offsets[i]; });
+  write_array<T>(stream, order.size(), [&](std::size_t i) { return hidden_label[transitions[order[i]].label()]; });
+  write_array<T>(stream, order.size(), [&](std::size_t i) { return transitions[order[i]].to(); });
+}
+
+} // namespace
+
+void save_mapped_lts(const std::string& filename,
+                     std::size_t num_states,
+                     std::size_t num_action_labels,
+                     std::size_t initial_state,
+                     const std::vector<transition>& transitions,
+                     const std::map<std::size_t, std::size_t>& hidden_label_map)
+{
+  std::vector<std::size_t> hidden_label(num_action_labels);
+  for (std::size_t a = 0; a < num_action_labels; ++a)
+  {
+    const auto i = hidden_label_map.find(a);
+    hidden_label[a] = i == hidden_label_map.end() ? a : i->second;
+  }
+
+  // Determine the offsets of the outgoing transitions of every state with a counting sort on the source.
+  std::vector<std::size_t> offsets(num_states + 1, 0);
+  for (const transition& t : transitions)
+  {
+    ++offsets[t.from() + 1];
+  }
+  for (std::size_t s = 0; s < num_states; ++s)
+  {
+    offsets[s + 1] += offsets[s];
+  }
+
+  // The transitions are written in the order given by this permutation.
+  std::vector<std::size_t> order(transitions.size());
+  {
+    std::vector<std::size_t> position(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < transitions.size(); ++i)
+    {
+      order[position[transitions[i].from()]++] = i;
+    }
+  }
+  for (std::size_t s = 0; s < num_states; ++s)
+  {
+    std::sort(order.begin() + offsets[s], order.begin() + offsets[s + 1],
+              [&](std::size_t i, std::size_t j)
+              {
+                const std::size_t label_i = hidden_label[transitions[i].label()];
+                const std::size_t label_j = hidden_label[transitions[j].label()];
+                return label_i < label_j || (label_i == label_j && transitions[i].to() < transitions[j].to());
+              });
+  }
+
+  const std::size_t largest = std::max({ transitions.size(), num_states, num_action_labels });
+  const bool wide = largest > std::numeric_limits<std::uint32_t>::max();
+
+  mapped_lts_header header;
+  std::memcpy(header.magic, MAPPED_LTS_MAGIC, sizeof(header.magic));
+  header.byte_order = MAPPED_LTS_BYTE_ORDER;
+  header.index_width = wide ? 8 : 4;
+  header.num_states = num_states;
+  header.num_action_labels = num_action_labels;
+  header.num_transitions = transitions.size();
+  header.initial_state = initial_state;
+  header.reserved = 0;
+
+  std::ofstream stream(filename, std::ofstream::out | std::ofstream::binary);
+  if (!stream.is_open())
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+  }
+
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (wide)
+  {
+    write_arrays<std::uint64_t>(stream, offsets, order, transitions, hidden_label);
+  }
+  else
+  {
+    write_arrays<std::uint32_t>(stream, offsets, order, transitions, hidden_label);
+  }
+
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Fail to write the mapped lts correctly to the file " + filename + ".");
+  }
+}
+
+bool mapped_lts::is_mapped_lts(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  char magic[sizeof(MAPPED_LTS_MAGIC)];
+  return stream.read(magic, sizeof(magic)) && std::memcmp(magic, MAPPED_LTS_MAGIC, sizeof(magic)) == 0;
+}
+
+mapped_lts::mapped_lts(const std::string& filename)
+{
+  const unsigned char* data = nullptr;
+  std::size_t size = 0;
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  // Read the whole file into memory instead.
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+  if (!stream.is_open())
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read a mapped lts.");
+  }
+  size = static_cast<std::size_t>(stream.tellg());
+  m_buffer.resize((size + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t));
+  stream.seekg(0);
+  if (!stream.read(reinterpret_cast<char*>(m_buffer.data()), size))
+  {
+    throw mcrl2::runtime_error("Fail to read the mapped lts from the file " + filename + ".");
+  }
+  data = reinterpret_cast<const unsigned char*>(m_buffer.data());
+#else
+  int descriptor = open(filename.c_str(), O_RDONLY);
+  if (descriptor == -1)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read a mapped lts.");
+  }
+
+  struct stat status;
+  if (fstat(descriptor, &status) == -1)
+  {
+    close(descriptor);
+    throw mcrl2::runtime_error("Fail to determine the size of the file " + filename + ".");
+  }
+  size = static_cast<std::size_t>(status.st_size);
+
+  if (size > 0)
+  {
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    close(descriptor);
+    if (mapping == MAP_FAILED)
+    {
+      throw mcrl2::runtime_error("Fail to map the file " + filename + " into memory.");
+    }
+    m_mapping = mapping;
+    m_mapping_size = size;
+    data = static_cast<const unsigned char*>(mapping);
+  }
+  else
+  {
+    close(descriptor);
+  }
+#endif
+
+  try
+  {
+    initialise(data, size, filename);
+  }
+  catch (...)
+  {
+#ifndef MCRL2_PLATFORM_WINDOWS
+    if (m_mapping != nullptr)
+    {
+      munmap(m_mapping, m_mapping_size);
+    }
+#endif
+    throw;
+  }
+}
+
+void mapped_lts::initialise(const unsigned char* data, std::size_t size, const std::string& filename)
+{
+  mapped_lts_header header;
+  if (size < sizeof(header))
+  {
+    throw mcrl2::runtime_error("The file " + filename + " does not contain a mapped lts.");
+  }
+  std::memcpy(&header, data, sizeof(header));
+
+  if (std::memcmp(header.magic, MAPPED_LTS_MAGIC, sizeof(header.magic)) != 0)
+  {
+    throw mcrl2::runtime_error("The file " + filename + " does not contain a mapped lts.");
+  }
+  if (header.byte_order != MAPPED_LTS_BYTE_ORDER || (header.index_width != 4 && header.index_width != 8))
+  {
+    throw mcrl2::runtime_error("The mapped lts in " + filename + " was written on a machine with a different architecture.");
+  }
+
+  m_wide = header.index_width == 8;
+  m_num_states = static_cast<std::size_t>(header.num_states);
+  m_num_action_labels = static_cast<std::size_t>(header.num_action_labels);
+  m_num_transitions = static_cast<std::size_t>(header.num_transitions);
+  m_initial_state = static_cast<std::size_t>(header.initial_state);
+
+  const std::size_t width = static_cast<std::size_t>(header.index_width);
+  if (size < sizeof(header) + width * (m_num_states + 1 + 2 * m_num_transitions))
+  {
+    throw mcrl2::runtime_error("The mapped lts in " + filename + " is truncated.");
+  }
+
+  m_offsets = data + sizeof(header);
+  m_labels = m_offsets + width * (m_num_states + 1);
+  m_targets = m_labels + width * m_num_transitions;
+}
+
+mapped_lts::~mapped_lts()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  if (m_mapping != nullptr)
+  {
+    munmap(m_mapping, m_mapping_size);
+  }
+#endif
+}
+
+} // namespace lts
+} // namespace mcrl2
@@ -408,3 +408,56 @@ BOOST_AUTO_TEST_CASE(failures_divergence_incomparable_test)
   BOOST_CHECK(preorder_compare(bP, aPtauP, lts_pre_failures_divergence_refinement)); // failures(bP) subset failures(aPtau) != empty because divergences.
 }
 
+
+// a.(tau.b+c) + a.b
+const std::string a_taub_c_ab =
+  "des (0,6,5)\n"
+  "(0,\"a\",1)\n"
+  "(1,\"tau\",2)\n"
+  "(2,\"b\",3)\n"
+  "(1,\"c\",3)\n"
+  "(0,\"a\",4)\n"
+  "(4,\"b\",3)\n";
+
+// a.(tau.b+c)
+const std::string a_taub_c =
+  "des (0,4,4)\n"
+  "(0,\"a\",1)\n"
+  "(1,\"tau\",2)\n"
+  "(2,\"b\",3)\n"
+  "(1,\"c\",3)\n";
+
+// a.(b+c)
+const std::string a_b_c_tau_loop =
+  "des (0,5,3)\n"
+  "(0,\"a\",1)\n"
+  "(1,\"tau\",2)\n"
+  "(2,\"tau\",1)\n"
+  "(1,\"b\",0)\n"
+  "(2,\"c\",0)\n";
+
+// P = a.(b+c).P, which is weakly bisimilar to a_b_c_tau_loop, except for its divergence.
+const std::string a_b_c_P =
+  "des (0,3,2)\n"
+  "(0,\"a\",1)\n"
+  "(1,\"b\",0)\n"
+  "(1,\"c\",0)\n";
+
+// a.(tau.b+c) + a.b is weakly bisimilar to a.(tau.b+c), but not branching bisimilar.
+BOOST_AUTO_TEST_CASE(weak_bisimulation_test)
+{
+  BOOST_CHECK(compare(a_taub_c_ab, a_taub_c, lts_eq_weak_bisim));
+  BOOST_CHECK(compare(a_taub_c, a_taub_c_ab, lts_eq_divergence_preserving_weak_bisim));
+  BOOST_CHECK(!compare(a_taub_c_ab, a_taub_c, lts_eq_branching_bisim));
+  BOOST_CHECK(!compare(l3, a_taub_c, lts_eq_weak_bisim));
+  BOOST_CHECK(compare(l3, l1, lts_eq_weak_bisim));
+  BOOST_CHECK(!compare(a_taub_tauc, l2, lts_eq_weak_bisim));
+
+  BOOST_CHECK(compare(a_b_c_tau_loop, a_b_c_P, lts_eq_weak_bisim));
+  BOOST_CHECK(!compare(a_b_c_tau_loop, a_b_c_P, lts_eq_divergence_preserving_weak_bisim));
+
+  lts_aut_t l = parse_aut(a_taub_c_ab);
+  reduce(l, lts_eq_weak_bisim);
+  BOOST_CHECK(l.num_states() == 4);
+  BOOST_CHECK(compare(l, parse_aut(a_taub_c), lts_eq_branching_bisim));
+}
@@ -10,11 +10,16 @@
 /// \brief Add your file description here.
 
 #define BOOST_TEST_MODULE lts_test
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <boost/test/included/unit_test_framework.hpp>
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/lts/lts_lts.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 using namespace mcrl2;
 
@@ -858,6 +863,179 @@ void test_is_deterministic()
   is_deterministic_test2();
 }
 
+// Check that the transitions of an .lts file are read back correctly, in particular
+// the transitions whose source is smaller than that of the previous transition.
+void test_lts_save_load()
+{
+  lts::lts_lts_t l;
+  l.set_num_states(1001, false);
+  l.add_action(lts::action_label_lts(lps::multi_action(process::action(
+    process::action_label(core::identifier_string("a"), data::sort_expression_list()), data::data_expression_list()))));
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    l.add_transition(lts::transition(i, i % 2, i + 1));
+    l.add_transition(lts::transition(1000 - i, 1, (i * 7919) % 1001));
+  }
+  l.set_initial_state(0);
+
+  const std::string filename = "lts_test_save_load.lts";
+  l.save(filename);
+
+  lts::lts_lts_t l_in;
+  l_in.load(filename);
+  std::remove(filename.c_str());
+
+  BOOST_CHECK_EQUAL(l_in.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(l_in.num_action_labels(), l.num_action_labels());
+  BOOST_CHECK_EQUAL(l_in.initial_state(), l.initial_state());
+  BOOST_CHECK(l_in.get_transitions() == l.get_transitions());
+}
+
+// Check that an lts that is written while it is generated can be read, where the transitions take several blocks.
+void test_lts_disk_writer()
+{
+  const std::size_t number_of_states = 100000;
+  const lts::action_label_lts a(lps::multi_action(process::action(
+    process::action_label(core::identifier_string("a"), data::sort_expression_list()), data::data_expression_list())));
+
+  const std::string filename = "lts_test_disk_writer.lts";
+  std::vector<lts::transition> transitions;
+  {
+    lts::lts_lts_disk_writer writer(filename, data::data_specification(), data::variable_list(), process::action_label_list());
+    writer.add_action(a);
+    for (std::size_t i = 0; i < number_of_states; ++i)
+    {
+      writer.add_state(lts::state_label_lts(data::data_expression_vector({ data::sort_nat::nat(i) })));
+      transitions.emplace_back(i, i % 2, (i + 1) % number_of_states);
+      transitions.emplace_back(i, 1, (i * 7919) % number_of_states);
+      writer.add_transition(transitions[transitions.size() - 2]);
+      writer.add_transition(transitions.back());
+    }
+    writer.close(0, number_of_states);
+  }
+
+  lts::lts_lts_t l;
+  l.load(filename);
+  std::remove(filename.c_str());
+
+  BOOST_CHECK_EQUAL(l.num_states(), number_of_states);
+  BOOST_CHECK_EQUAL(l.num_state_labels(), number_of_states);
+  BOOST_CHECK_EQUAL(l.num_action_labels(), 2u);
+  BOOST_CHECK(l.action_label(1) == a);
+  BOOST_CHECK_EQUAL(l.initial_state(), 0u);
+  BOOST_CHECK(l.get_transitions() == transitions);
+  BOOST_CHECK(l.state_label(12345) == lts::state_label_lts(data::data_expression_vector({ data::sort_nat::nat(12345) })));
+}
+
+// Check that a mapped lts contains the outgoing transitions of every state, sorted on label and target.
+void test_mapped_lts()
+{
+  lts::lts_aut_t l;
+  l.set_num_states(5, false);
+  l.add_action(lts::action_label_string("a"));
+  l.add_action(lts::action_label_string("b"));
+  l.add_transition(lts::transition(3, 2, 4));
+  l.add_transition(lts::transition(0, 1, 2));
+  l.add_transition(lts::transition(0, 0, 1));
+  l.add_transition(lts::transition(3, 1, 0));
+  l.add_transition(lts::transition(0, 1, 1));
+  l.set_initial_state(3);
+
+  const std::string filename = "lts_test_mapped_lts.mlts";
+  lts::save_mapped_lts(l, filename);
+  BOOST_CHECK(lts::mapped_lts::is_mapped_lts(filename));
+  {
+    lts::mapped_lts m(filename);
+    BOOST_CHECK_EQUAL(m.num_states(), 5u);
+    BOOST_CHECK_EQUAL(m.num_action_labels(), 3u);
+    BOOST_CHECK_EQUAL(m.num_transitions(), 5u);
+    BOOST_CHECK_EQUAL(m.initial_state(), 3u);
+
+    const std::vector<std::size_t> offsets = { 0, 3, 3, 3, 5, 5 };
+    const std::vector<std::size_t> labels = { 0, 1, 1, 1, 2 };
+    const std::vector<std::size_t> targets = { 1, 1, 2, 0, 4 };
+    for (std::size_t s = 0; s <= m.num_states(); ++s)
+    {
+      BOOST_CHECK_EQUAL(m.outgoing_begin(s), offsets[s]);
+    }
+    for (std::size_t i = 0; i < m.num_transitions(); ++i)
+    {
+      BOOST_CHECK_EQUAL(m.label(i), labels[i]);
+      BOOST_CHECK_EQUAL(m.target(i), targets[i]);
+    }
+  }
+  std::remove(filename.c_str());
+
+  // Hidden labels are replaced before the transitions are sorted.
+  l.hidden_label_map()[2] = 0;
+  lts::save_mapped_lts(l, filename);
+  {
+    lts::mapped_lts m(filename);
+    BOOST_CHECK_EQUAL(m.outgoing_begin(3), 3u);
+    BOOST_CHECK_EQUAL(m.label(3), 0u);
+    BOOST_CHECK_EQUAL(m.target(3), 4u);
+    BOOST_CHECK_EQUAL(m.label(4), 1u);
+    BOOST_CHECK_EQUAL(m.target(4), 0u);
+  }
+  std::remove(filename.c_str());
+
+  BOOST_CHECK(!lts::mapped_lts::is_mapped_lts("lts_test_mapped_lts_does_not_exist.mlts"));
+}
+
+// Writes a transition system with a transition from i to i+1 for all i < n, in the format of .lts files
+// before revision 1, in which there is no revision term and every transition is a separate term.
+// If revision is not zero, the file starts with a revision term with that value.
+static void write_lts_without_transition_blocks(const std::string& filename, std::size_t n, std::size_t revision = 0)
+{
+  std::ofstream fstream(filename, std::ofstream::out | std::ofstream::binary);
+  atermpp::binary_aterm_output stream(fstream, data::detail::remove_index_impl);
+  if (revision != 0)
+  {
+    stream << atermpp::aterm_appl(atermpp::function_symbol("labelled_transition_system_revision", 1), atermpp::aterm_int(revision));
+  }
+  const process::action_label a(core::identifier_string("a"), data::sort_expression_list());
+  stream << atermpp::aterm_appl(atermpp::function_symbol("multi_action", 2),
+                                process::action_list({ process::action(a, data::data_expression_list()) }),
+                                data::undefined_real());
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    stream << atermpp::aterm_appl(atermpp::function_symbol("transition", 3), atermpp::aterm_int(i), atermpp::aterm_int(1), atermpp::aterm_int(i + 1));
+  }
+  atermpp::aterm_list initial_state;
+  initial_state.push_front(lps::probabilistic_data_expression::one());
+  initial_state.push_front(atermpp::aterm_int(0));
+  stream << atermpp::aterm_appl(atermpp::function_symbol("labelled_transition_system", 5),
+                                data::detail::data_specification_to_aterm(data::data_specification()),
+                                data::variable_list(),
+                                process::action_label_list({ a }),
+                                initial_state,
+                                atermpp::aterm_int(n + 1));
+}
+
+// Check that .lts files in the format before revision 1 can still be read, and that files with
+// a revision that is not known are rejected.
+void test_lts_load_revisions()
+{
+  const std::string filename = "lts_test_load_revisions.lts";
+  write_lts_without_transition_blocks(filename, 10);
+  lts::lts_lts_t l;
+  l.load(filename);
+  BOOST_CHECK_EQUAL(l.num_states(), 11u);
+  BOOST_CHECK_EQUAL(l.num_action_labels(), 2u);
+  BOOST_CHECK_EQUAL(l.num_transitions(), 10u);
+  BOOST_CHECK_EQUAL(l.initial_state(), 0u);
+  for (const lts::transition& t: l.get_transitions())
+  {
+    BOOST_CHECK_EQUAL(t.to(), t.from() + 1);
+    BOOST_CHECK_EQUAL(t.label(), 1u);
+  }
+
+  write_lts_without_transition_blocks(filename, 10, 2);
+  lts::lts_lts_t l_future;
+  BOOST_CHECK_THROW(l_future.load(filename), mcrl2::runtime_error);
+  std::remove(filename.c_str());
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   reduce_simple_loop();
@@ -871,5 +1049,9 @@ BOOST_AUTO_TEST_CASE(test_main)
   counterexample_jk_1(3);
   counterexample_postprocessing();
   regression_delete_old_bb_slice();
+  test_lts_save_load();
+  test_lts_load_revisions();
+  test_lts_disk_writer();
+  test_mapped_lts();
   // TODO: Add groote wijs branching bisimulation and add weak bisimulation tests. For the last Peterson is a good candidate.
 }
@@ -707,3 +707,62 @@ BOOST_AUTO_TEST_CASE(test_state_space_reductions)
  }
 }
 
+
+// Generates an lts with tau loops, tau chains and a few visible actions, which is large
+// enough for the signature refinement algorithms to divide their work over threads.
+static lts_aut_t generate_lts(const std::size_t number_of_states)
+{
+  std::stringstream s;
+  std::size_t seed = 12345;
+  std::vector<std::string> transitions;
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    for (std::size_t j = 0; j < 2; ++j)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      const std::size_t r = seed >> 33;
+      const std::size_t target = (r % 4 == 0 ? (i + 1) % number_of_states : (r / 4) % number_of_states);
+      const std::string label = (r % 3 == 0 ? "tau" : (r % 3 == 1 ? "a" : "b"));
+      transitions.push_back("(" + std::to_string(i) + ",\"" + label + "\"," + std::to_string(target) + ")\n");
+    }
+  }
+  s << "des (0," << transitions.size() << "," << number_of_states << ")\n";
+  for (const std::string& t: transitions)
+  {
+    s << t;
+  }
+  return parse_aut(s.str());
+}
+
+BOOST_AUTO_TEST_CASE(test_parallel_sigref)
+{
+  const lts_aut_t original = generate_lts(20000);
+  for (lts_equivalence eq: { lts_eq_bisim_sigref, lts_eq_branching_bisim_sigref, lts_eq_divergence_preserving_branching_bisim_sigref })
+  {
+    lts_aut_t sequential = original;
+    reduce(sequential, eq);
+    lts_aut_t parallel = original;
+    reduce(parallel, eq, 4);
+    BOOST_CHECK(sequential.num_states() == parallel.num_states());
+    BOOST_CHECK(sequential.initial_state() == parallel.initial_state());
+    BOOST_CHECK(sequential.get_transitions() == parallel.get_transitions());
+  }
+
+  lts_aut_t l1 = original;
+  reduce(l1, lts_eq_bisim_sigref, 4);
+  lts_aut_t l2 = original;
+  reduce(l2, lts_eq_bisim);
+  BOOST_CHECK(l1.num_states() == l2.num_states() && l1.num_transitions() == l2.num_transitions());
+
+  l1 = original;
+  reduce(l1, lts_eq_branching_bisim_sigref, 4);
+  l2 = original;
+  reduce(l2, lts_eq_branching_bisim);
+  BOOST_CHECK(l1.num_states() == l2.num_states() && l1.num_transitions() == l2.num_transitions());
+
+  l1 = original;
+  reduce(l1, lts_eq_divergence_preserving_branching_bisim_sigref, 4);
+  l2 = original;
+  reduce(l2, lts_eq_divergence_preserving_branching_bisim);
+  BOOST_CHECK(l1.num_states() == l2.num_states() && l1.num_transitions() == l2.num_transitions());
+}
@@ -17,6 +17,7 @@
 
 #include <boost/test/included/unit_test_framework.hpp>
 
+#include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/parse.h"
 
 using namespace mcrl2;
@@ -93,3 +94,53 @@ BOOST_AUTO_TEST_CASE(fsm_parser_test)
   );
 }
 
+
+// Parses the text as an .aut file, and checks that saving the result yields the expected text.
+template <typename LTS>
+void test_aut_parser(const std::string& text, const std::string& expected)
+{
+  LTS l;
+  std::istringstream is(text);
+  l.load(is);
+
+  std::string temp_filename = "parse_test_aut.tmp";
+  l.save(temp_filename);
+  std::string text1 = utilities::read_text(temp_filename);
+  std::remove(temp_filename.c_str());
+
+  if (expected != text1)
+  {
+    std::cerr << "--- Error: difference detected ---\n" << expected << "\n-------------------\n" << text1 << "\n-------------------\n";
+  }
+  BOOST_CHECK(expected == text1);
+}
+
+BOOST_AUTO_TEST_CASE(aut_parser_test)
+{
+  test_aut_parser<lts::lts_aut_t>(
+    "des (0,4,3)\n"
+    "(0,\"a b\",1)\n"
+    "( 1 , c , 2 )  \r\n"
+    "(2,\"tau\",0)\n"
+    "(2,\"a b\",2)",
+    "des (0,4,3)\n"
+    "(0,\"a b\",1)\n"
+    "(1,\"c\",2)\n"
+    "(2,\"tau\",0)\n"
+    "(2,\"a b\",2)\n"
+  );
+
+  test_aut_parser<lts::probabilistic_lts_aut_t>(
+    "des (0 1/2 1,2,3)\n"
+    "(0,\"a\",1 1/3 2)\n"
+    "(1,\"b\",2)\n",
+    "des (0 1/2 1,2,3)\n"
+    "(0,\"a\",1 1/3 2)\n"
+    "(1,\"b\",2)\n"
+  );
+
+  // The number of transitions in the header does not match.
+  lts::lts_aut_t l;
+  std::istringstream is("des (0,2,2)\n(0,\"a\",1)\n");
+  BOOST_CHECK_THROW(l.load(is), mcrl2::runtime_error);
+}
@@ -25,6 +25,7 @@
 #include "mcrl2/pbes/rewriters/enumerate_quantifiers_rewriter.h"
 #include "mcrl2/pbes/search_strategy.h"
 #include "mcrl2/pbes/transformation_strategy.h"
+#include "mcrl2/utilities/indexed_set.h"
 #include <cassert>
 #include <ctime>
 #include <deque>
@@ -33,7 +34,6 @@
 #include <sstream>
 #include <stack>
 #include <unordered_map>
-#include <unordered_set>
 
 namespace mcrl2
 {
@@ -44,27 +44,30 @@ namespace pbes_system
 namespace detail
 {
   // The following function is a helper function to allow to create m_pv_renaming outside
-  // the class such that the class becomes a lightweight object.
-
-  std::unordered_map<propositional_variable_instantiation,propositional_variable_instantiation>
-  create_pv_renaming(std::vector<std::vector<propositional_variable_instantiation> >& instantiations,
-                                bool short_renaming_scheme)
+  // the class such that the class becomes a lightweight object. The result maps the index
+  // of a BES variable in bes_variables to its new name.
+
+  inline
+  std::vector<propositional_variable_instantiation>
+  create_pv_renaming(const utilities::indexed_set<propositional_variable_instantiation>& bes_variables,
+                     const std::vector<std::vector<std::size_t> >& instantiations,
+                     bool short_renaming_scheme)
   {
     std::size_t index=0;
-    std::unordered_map<propositional_variable_instantiation,propositional_variable_instantiation> pv_renaming;
-    for(const std::vector<propositional_variable_instantiation>& vec: instantiations)
+    std::vector<propositional_variable_instantiation> pv_renaming(bes_variables.size());
+    for(const std::vector<std::size_t>& vec: instantiations)
     {
-      for(const propositional_variable_instantiation& inst:vec)
+      for(const std::size_t i: vec)
       {
         if (short_renaming_scheme)
         {
           std::stringstream ss;
           ss << "X" << index;
-          pv_renaming[inst]=propositional_variable_instantiation(ss.str(),data::data_expression_list());
+          pv_renaming[i]=propositional_variable_instantiation(ss.str(),data::data_expression_list());
         }
         else
         {
-          pv_renaming[inst]=pbesinst_rename()(inst);
+          pv_renaming[i]=pbesinst_rename()(bes_variables[i]);
         }
         index++;
       }
@@ -75,18 +78,22 @@ namespace detail
   class rename_pbesinst_consecutively
   {
     protected:
-      const std::unordered_map<propositional_variable_instantiation,propositional_variable_instantiation>& m_pv_renaming;
+      const utilities::indexed_set<propositional_variable_instantiation>& m_bes_variables;
+      const std::vector<propositional_variable_instantiation>& m_pv_renaming;
 
     public:
-      rename_pbesinst_consecutively(const std::unordered_map<propositional_variable_instantiation,propositional_variable_instantiation>& pv_renaming)
-       :  m_pv_renaming(pv_renaming)
+      rename_pbesinst_consecutively(const utilities::indexed_set<propositional_variable_instantiation>& bes_variables,
+                                    const std::vector<propositional_variable_instantiation>& pv_renaming)
+       :  m_bes_variables(bes_variables),
+          m_pv_renaming(pv_renaming)
       {}
 
 
       propositional_variable_instantiation operator()(const propositional_variable_instantiation& v) const
       {
-        assert(m_pv_renaming.count(v)>0);
-        return m_pv_renaming.at(v);
+        const std::size_t i = m_bes_variables.index(v);
+        assert(i < m_pv_renaming.size());
+        return m_pv_renaming[i];
       }
   };
 } // end namespace detail
@@ -171,26 +178,39 @@ class pbesinst_alternative_lazy_algorithm
     /// Values are: none, some or all.
     const mcrl2::bes::remove_level m_erase_unused_bes_variables;
 
-    /// \brief Propositional variable instantiations that need to be handled.
-    std::deque<propositional_variable_instantiation> todo;
+    /// \brief The status of a BES variable.
+    enum class bes_variable_status: unsigned char
+    {
+      todo,     ///< The right hand side has not been computed yet.
+      explored, ///< The right hand side has been computed.
+      true_,    ///< The right hand side has been computed, and is known to be true.
+      false_    ///< The right hand side has been computed, and is known to be false.
+    };
+
+    /// \brief The propositional variable instantiations that have been encountered. The information
+    ///        about a BES variable below is stored at the index of the variable in this set.
+    utilities::indexed_set<propositional_variable_instantiation> bes_variables;
+
+    /// \brief The indices of the BES variables that need to be handled.
+    std::deque<std::size_t> todo;
 
-    /// \brief The content of todo as a set.
-    std::unordered_set<propositional_variable_instantiation> todo_set;
+    /// \brief occurrence[i] contains the indices of the BES variables on whose right hand
+    ///        sides the i-th BES variable appears.
+    std::vector<std::vector<std::size_t> > occurrence;
 
-    /// \brief Map a variable instantiation to a set of other variable
-    ///        instantiations on whose right hand sides it appears.
-    std::unordered_map<propositional_variable_instantiation, std::unordered_set<propositional_variable_instantiation> > occurrence;
+    /// \brief equation[i] contains the right hand side of the i-th BES variable, if it has been explored.
+    std::vector<pbes_expression> equation;
 
-    /// \brief Map a variable instantiation to its right hand side.
-    std::unordered_map<propositional_variable_instantiation, pbes_expression> equation;
+    /// \brief status[i] indicates whether the i-th BES variable has been explored, and whether its
+    ///        right hand side is trivial (either true or false).
+    std::vector<bes_variable_status> status;
 
-    /// \brief Map a variable instantiations to its right hand side
-    ///        when the latter is trivial (either true or false).
-    std::unordered_map<propositional_variable_instantiation, pbes_expression> trivial;
+    /// \brief The number of BES variables that have been explored.
+    std::size_t m_number_of_equations;
 
-    /// \brief instantiations[i] contains all instantiations of the variable
+    /// \brief instantiations[i] contains the indices of all instantiations of the variable
     ///        of the i-th equation in the PBES.
-    std::vector<std::vector<propositional_variable_instantiation> > instantiations;
+    std::vector<std::vector<std::size_t> > instantiations;
 
     /// \brief symbols[i] contains the fixedpoint symbol of the i-th equation
     ///        in the PBES.
@@ -265,6 +285,7 @@ class pbesinst_alternative_lazy_algorithm
         m_approximate_true(approximate_true),
         m_elements_not_stored_in_todo_buffer(0),
         m_erase_unused_bes_variables(erase_unused_bes_variables),
+        m_number_of_equations(0),
         m_search_strategy(search_strategy),
         m_transformation_strategy(transformation_strategy)
     {
@@ -279,31 +300,77 @@ class pbesinst_alternative_lazy_algorithm
         m_search_strategy = depth_first;
     }
 
-    inline propositional_variable_instantiation next_todo()
+    /// \brief Returns the index of X, where X is added as a BES variable that has not been explored if
+    ///        it was not encountered before. The boolean indicates whether X was added.
+    std::pair<std::size_t, bool> insert_bes_variable(const propositional_variable_instantiation& X)
+    {
+      const std::pair<std::size_t, bool> result = bes_variables.insert(X);
+      if (result.second)
+      {
+        occurrence.emplace_back();
+        equation.emplace_back();
+        status.push_back(bes_variable_status::todo);
+      }
+      return result;
+    }
+
+    bool is_explored(const std::size_t i) const
+    {
+      return status[i] != bes_variable_status::todo;
+    }
+
+    bool is_trivial(const std::size_t i) const
+    {
+      return status[i] == bes_variable_status::true_ || status[i] == bes_variable_status::false_;
+    }
+
+    /// \brief Stores the right hand side of the i-th BES variable, which has not been explored before.
+    void set_equation(const std::size_t i, const pbes_expression& rhs)
+    {
+      assert(!is_explored(i));
+      equation[i] = rhs;
+      status[i] = bes_variable_status::explored;
+      ++m_number_of_equations;
+    }
+
+    /// \brief Records that the right hand side of the i-th BES variable is equal to value, which is either true or false.
+    void set_trivial(const std::size_t i, const pbes_expression& value)
+    {
+      assert(is_explored(i) && (is_true(value) || is_false(value)));
+      status[i] = is_true(value) ? bes_variable_status::true_ : bes_variable_status::false_;
+    }
+
+    /// \brief Gives the i-th BES variable an approximate value, instead of exploring it.
+    void approximate(const std::size_t i)
+    {
+      const pbes_expression value = (m_approximate_true?false_():true_());
+      set_equation(i, value);
+      set_trivial(i, value);
+      instantiations[equation_index[bes_variables[i].name()]].push_back(i);
+    }
+
+    inline std::size_t next_todo()
     {
-      assert(todo.size()==todo_set.size());
       if (m_search_strategy == breadth_first)
       {
-        const propositional_variable_instantiation X_e = todo.front();
+        const std::size_t i = todo.front();
         todo.pop_front();
-        todo_set.erase(X_e);
-        return X_e;
+        return i;
       }
       else
       {
-        const propositional_variable_instantiation X_e = todo.back();
+        const std::size_t i = todo.back();
         todo.pop_back();
-        todo_set.erase(X_e);
-        return X_e;
+        return i;
       }
     }
 
-    inline void add_todo(const propositional_variable_instantiation& X)
+    inline void add_todo(const std::size_t i)
     {
+      assert(!is_explored(i));
       if (todo.size()<m_maximum_todo_size)  // If there is no limit on todo, m_maximimum_todo_size is equal to npos.
       {
-        todo.push_back(X);
-        todo_set.insert(X); // XXXXX
+        todo.push_back(i);
       }
       else
       {
@@ -311,20 +378,12 @@ class pbesinst_alternative_lazy_algorithm
         if ((rand() % (todo.size() + m_elements_not_stored_in_todo_buffer)) < todo.size())
         {
           std::size_t index = rand() % (todo.size());
-          const propositional_variable_instantiation Y=todo[index];
-          equation[Y]=(m_approximate_true?false_():true_());
-          trivial[Y]=equation[Y];
-          instantiations[equation_index[Y.name()]].push_back(Y);
-
-          todo_set.erase(Y);
-          todo[index]=X;
-          todo_set.insert(X);
+          approximate(todo[index]);
+          todo[index]=i;
         }
         else
         {
-          equation[X]=(m_approximate_true?false_():true_());
-          instantiations[equation_index[X.name()]].push_back(X);
-          trivial[X]=equation[X];
+          approximate(i);
         }
       }
     }
@@ -339,7 +398,7 @@ class pbesinst_alternative_lazy_algorithm
         const pbes_expression& expr,
         propositional_variable_instantiation X,
         std::size_t rank,
-        std::unordered_map<propositional_variable_instantiation, bool>& visited)
+        std::unordered_map<std::size_t, bool>& visited)
     {
       if (is_false(expr) || is_true(expr))
       {
@@ -356,17 +415,19 @@ class pbesinst_alternative_lazy_algorithm
         {
           return false;
         }
-        if (visited.count(Y))
+        const std::size_t i = bes_variables.index(Y);
+        if (i == bes_variables.npos || !is_explored(i))
         {
-          return visited[Y];
+          return false;
         }
-        if (equation.count(Y) == 0)
+        const std::unordered_map<std::size_t, bool>::const_iterator j = visited.find(i);
+        if (j != visited.end())
         {
-          return false;
+          return j->second;
         }
-        visited[Y] = false;
-        bool b = find_loop_rec<is_mu>(equation[Y], X, rank, visited);
-        visited[Y] = b;
+        visited[i] = false;
+        bool b = find_loop_rec<is_mu>(equation[i], X, rank, visited);
+        visited[i] = b;
         return b;
       }
 
@@ -406,7 +467,7 @@ class pbesinst_alternative_lazy_algorithm
     template <bool is_mu>
     bool find_loop(pbes_expression expr, propositional_variable_instantiation X)
     {
-      std::unordered_map<propositional_variable_instantiation, bool> visited;
+      std::unordered_map<std::size_t, bool> visited;
       return find_loop_rec<is_mu>(expr, X, get_rank(X), visited);
     }
 
@@ -419,19 +480,9 @@ class pbesinst_alternative_lazy_algorithm
         return;
       }
 
-      // Create a set of reachable propositional_variable_instantiations
-      // and use that to clean up the set of equations.
-      std::unordered_set<propositional_variable_instantiation> reachable;
-
-      todo.clear();
-      todo_set.clear();
-      occurrence.clear();
-      for(std::vector<propositional_variable_instantiation>& vec: instantiations)
-      {
-        vec.clear();
-      }
-      assert(instantiations.size()==0 || instantiations[0].size()==0);
-
+      // Determine the reachable BES variables, and use them to clean up the set of equations.
+      std::vector<bool> reachable(bes_variables.size(), false);
+      std::vector<std::size_t> unexplored;
 
       std::stack<pbes_expression> stack;
       stack.push(init);
@@ -443,17 +494,18 @@ class pbesinst_alternative_lazy_algorithm
 
         if (is_propositional_variable_instantiation(expr))
         {
-          const propositional_variable_instantiation& X = atermpp::vertical_cast<propositional_variable_instantiation>(expr);
-          if (reachable.count(X) == 0)
+          const std::size_t i = bes_variables.index(atermpp::down_cast<propositional_variable_instantiation>(expr));
+          assert(i != bes_variables.npos);
+          if (!reachable[i])
           {
-            if (equation.count(X)>0)
+            reachable[i] = true;
+            if (is_explored(i))
             {
-              stack.push(equation[X]);
-              reachable.insert(X);
+              stack.push(equation[i]);
             }
             else
             {
-              add_todo(X);
+              unexplored.push_back(i);
             }
           }
         }
@@ -470,42 +522,70 @@ class pbesinst_alternative_lazy_algorithm
           stack.push(expro.right());
         }
       }
-      // erase non reachable equations.
-      std::unordered_map<propositional_variable_instantiation, pbes_expression> new_equations;
-      for(std::unordered_map<propositional_variable_instantiation, pbes_expression>::const_iterator i=equation.begin(); i!=equation.end(); ++i)
+
+      // Renumber the BES variables that are kept, which are the reachable ones, and the ones with a right hand
+      // side equal to true or false if m_erase_unused_bes_variables is set to some.
+      utilities::indexed_set<propositional_variable_instantiation> new_bes_variables;
+      std::vector<pbes_expression> new_equation;
+      std::vector<bes_variable_status> new_status;
+      for (std::size_t i = 0; i < bes_variables.size(); ++i)
       {
-        // Insert the new equation if it is reachable, or if it equal to true or false and m_erase_unused_bes_variables is set to some.
-        if (reachable.count(i->first)>0 || (m_erase_unused_bes_variables==bes::some && (is_true(i->second) || is_false(i->second))))
-        {
-          new_equations.insert(*i);
-          std::size_t index = equation_index[i->first.name()];
-          instantiations[index].push_back(i->first);
-          std::set<propositional_variable_instantiation> rhs_variables = find_propositional_variable_instantiations(i->second);
-          for (const propositional_variable_instantiation& v: rhs_variables)
+        if (reachable[i] || (m_erase_unused_bes_variables==bes::some && is_explored(i) && (is_true(equation[i]) || is_false(equation[i]))))
+        {
+          new_bes_variables.insert(bes_variables[i]);
+          new_equation.push_back(equation[i]);
+          new_status.push_back(status[i]);
+        }
+      }
+      for (std::size_t& i: unexplored)
+      {
+        i = new_bes_variables.index(bes_variables[i]);
+      }
+      bes_variables = std::move(new_bes_variables);
+      equation.swap(new_equation);
+      status.swap(new_status);
+
+      // Rebuild the remaining data structures for the kept variables.
+      todo.clear();
+      std::vector<std::vector<std::size_t> >(bes_variables.size()).swap(occurrence);
+      for(std::vector<std::size_t>& vec: instantiations)
+      {
+        vec.clear();
+      }
+      m_number_of_equations = 0;
+      for (std::size_t i = 0; i < bes_variables.size(); ++i)
+      {
+        if (is_explored(i))
+        {
+          ++m_number_of_equations;
+          instantiations[equation_index[bes_variables[i].name()]].push_back(i);
+          for (const propositional_variable_instantiation& v: find_propositional_variable_instantiations(equation[i]))
           {
-            occurrence[v].insert(i->first);
+            assert(bes_variables.index(v) != bes_variables.npos);
+            occurrence[bes_variables.index(v)].push_back(i);
           }
-
         }
       }
-      equation.swap(new_equations);
+      for (const std::size_t i: unexplored)
+      {
+        add_todo(i);
+      }
     }
 
-    // The function below simplifies a boolean_expression, given the knowledge that some propositional variables in trivial
+    // The function below simplifies a boolean_expression, given the knowledge that some BES variables
     // are known to be true or false. The idea is that variables that are redundant can be removed. If p = p1 && p2, and p1 is
     // false, then p2 can be removed, as its value does not influence the rewrite system.
     // The result of the function is a pair, with the simplified expression as first term, and the expression that is rewritten under the
-    // simplifications in trivial as the second term.
+    // simplifications as the second term.
     typedef std::pair < pbes_expression, pbes_expression > pbes_expression_pair;
-    pbes_expression_pair simplify_pbes_expression(const pbes_expression& p, const std::unordered_map<propositional_variable_instantiation, pbes_expression>& trivial)
+    pbes_expression_pair simplify_pbes_expression(const pbes_expression& p)
     {
       if (is_propositional_variable_instantiation(p))
       {
-        const std::unordered_map<propositional_variable_instantiation, pbes_expression>::const_iterator i=
-                                            trivial.find(atermpp::down_cast<propositional_variable_instantiation>(p));
-        if (i!=trivial.end() && (is_true(i->second) || is_false(i->second)))
+        const std::size_t i = bes_variables.index(atermpp::down_cast<propositional_variable_instantiation>(p));
+        if (i != bes_variables.npos && is_trivial(i))
         {
-          return pbes_expression_pair(p,i->second);
+          return pbes_expression_pair(p,status[i] == bes_variable_status::true_ ? true_() : false_());
         }
         return pbes_expression_pair(p,p);
       }
@@ -516,8 +596,8 @@ class pbesinst_alternative_lazy_algorithm
       else if (is_and(p))
       {
         const and_& pa=atermpp::down_cast<and_>(p);
-        const pbes_expression_pair lhs=simplify_pbes_expression(pa.left(),trivial);
-        const pbes_expression_pair rhs=simplify_pbes_expression(pa.right(),trivial);
+        const pbes_expression_pair lhs=simplify_pbes_expression(pa.left());
+        const pbes_expression_pair rhs=simplify_pbes_expression(pa.right());
         if (is_false(lhs.second))
         {
           return lhs;
@@ -538,8 +618,8 @@ class pbesinst_alternative_lazy_algorithm
       }
       assert(is_or(p));
       const or_& po=atermpp::down_cast<or_>(p);
-      const pbes_expression_pair lhs=simplify_pbes_expression(po.left(),trivial);
-      const pbes_expression_pair rhs=simplify_pbes_expression(po.right(),trivial);
+      const pbes_expression_pair lhs=simplify_pbes_expression(po.left());
+      const pbes_expression_pair rhs=simplify_pbes_expression(po.right());
       if (is_true(lhs.second))
       {
         return lhs;
@@ -603,12 +683,13 @@ class pbesinst_alternative_lazy_algorithm
       }
 
       init = atermpp::down_cast<propositional_variable_instantiation>(R(p.initial_state()));
-      add_todo(init);
+      add_todo(insert_bes_variable(init).first);
       while (!todo.empty())
       {
-        const propositional_variable_instantiation X_e = next_todo();
+        const std::size_t i = next_todo();
+        const propositional_variable_instantiation X_e = bes_variables[i];
         std::size_t index = equation_index[X_e.name()];
-        instantiations[index].push_back(X_e);
+        instantiations[index].push_back(i);
 
         const pbes_equation& eqn = pbes_equations[index];
         data::rewriter::substitution_type sigma;
@@ -628,7 +709,7 @@ class pbesinst_alternative_lazy_algorithm
         if (m_transformation_strategy >= optimize)
         {
           // Substitute all trivial variable instantiations by their values
-          pbes_expression_pair p=simplify_pbes_expression(psi_e,trivial);
+          pbes_expression_pair p=simplify_pbes_expression(psi_e);
           psi_e=p.first;
           rewritten_psi_e=p.second;
         }
@@ -637,7 +718,7 @@ class pbesinst_alternative_lazy_algorithm
           rewritten_psi_e=psi_e;
         }
         // Store the result
-        equation[X_e] = psi_e;
+        set_equation(i, psi_e);
 
         if (m_transformation_strategy >= on_the_fly_with_fixed_points)
         {
@@ -664,58 +745,57 @@ class pbesinst_alternative_lazy_algorithm
         std::set<propositional_variable_instantiation> psi_variables = find_propositional_variable_instantiations(psi_e);
         for (const propositional_variable_instantiation& v: psi_variables)
         {
-          if (todo_set.count(v) == 0 && equation.count(v) == 0)
+          const std::pair<std::size_t, bool> j = insert_bes_variable(v);
+          if (j.second)
           {
-            add_todo(v);
+            add_todo(j.first);
           }
-          occurrence[v].insert(X_e);
+          occurrence[j.first].push_back(i);
         }
 
         if (m_transformation_strategy >= optimize && (is_true(rewritten_psi_e) || is_false(rewritten_psi_e)))
         {
-          trivial[X_e] = rewritten_psi_e;
+          set_trivial(i, rewritten_psi_e);
           if (m_transformation_strategy >= on_the_fly)
           {
             // Substitute X_e to its value in all its occurrences, and
             // substitute all other variables to their values that are found
             // to be either true or false in all their occurrences.
-            std::stack<propositional_variable_instantiation> new_trivials;
-            new_trivials.push(X_e);
+            std::stack<std::size_t> new_trivials;
+            new_trivials.push(i);
             while (!new_trivials.empty())
             {
-              const propositional_variable_instantiation X = new_trivials.top();
+              const std::size_t X = new_trivials.top();
               new_trivials.pop();
 
-              const std::unordered_set<propositional_variable_instantiation> oc = occurrence[X];
-              std::unordered_map<propositional_variable_instantiation, pbes_expression> trivial_X;
-              trivial_X[X] = psi_e;
-              for (const propositional_variable_instantiation& Y: oc)
+              std::vector<std::size_t> oc;
+              oc.swap(occurrence[X]);
+              for (const std::size_t Y: oc)
               {
-                pbes_expression_pair p=simplify_pbes_expression(equation[Y],trivial);
+                pbes_expression_pair p=simplify_pbes_expression(equation[Y]);
                 equation[Y]=p.first;
                 const pbes_expression f=p.second;
                 if (is_true(f) || is_false(f))
                 {
-                  trivial[Y] = f;
+                  set_trivial(Y, f);
                   new_trivials.push(Y);
                 }
               }
-              occurrence.erase(X);
             }
           }
         }
 
         if (m_transformation_strategy >= on_the_fly)
         {
-          if (--regeneration_count == 0 || trivial.count(init)>0 )
+          if (--regeneration_count == 0 || is_trivial(bes_variables.index(init)))
           {
-            regeneration_count = equation.size() / 2;
+            regeneration_count = m_number_of_equations / 2;
             regenerate_states();
           }
         }
 
-        print_equation_count(equation.size(), equation.size()+todo.size(), todo.size()); // Print the number of equations every second in verbose mode.
-        detail::check_bes_equation_limit(equation.size());
+        print_equation_count(m_number_of_equations, m_number_of_equations+todo.size(), todo.size()); // Print the number of equations every second in verbose mode.
+        detail::check_bes_equation_limit(m_number_of_equations);
       }
       // Remove unnessary equations.
       regenerate_states();
@@ -725,19 +805,19 @@ class pbesinst_alternative_lazy_algorithm
     /// \return The computed bes in pbes format
     pbes get_result(bool short_rename_scheme=true)
     {
-      mCRL2log(log::verbose) << "Generated " << equation.size() << " BES equations in total, generating BES" << std::endl;
+      mCRL2log(log::verbose) << "Generated " << m_number_of_equations << " BES equations in total, generating BES" << std::endl;
       pbes result;
       std::size_t index = 0;
-      const std::unordered_map<propositional_variable_instantiation,propositional_variable_instantiation>
-            pv_renaming = detail::create_pv_renaming(instantiations,short_rename_scheme);
-      detail::rename_pbesinst_consecutively renamer(pv_renaming);
-      for (const std::vector<propositional_variable_instantiation>& vec: instantiations)
+      const std::vector<propositional_variable_instantiation>
+            pv_renaming = detail::create_pv_renaming(bes_variables,instantiations,short_rename_scheme);
+      detail::rename_pbesinst_consecutively renamer(bes_variables,pv_renaming);
+      for (const std::vector<std::size_t>& vec: instantiations)
       {
         const fixpoint_symbol symbol = symbols[index++];
-        for (const propositional_variable_instantiation& X_e: vec)
+        for (const std::size_t i: vec)
         {
-          const propositional_variable lhs = propositional_variable(renamer(X_e).name(), data::variable_list());
-          const pbes_expression rhs = replace_propositional_variables(equation[X_e], renamer);
+          const propositional_variable lhs = propositional_variable(pv_renaming[i].name(), data::variable_list());
+          const pbes_expression rhs = replace_propositional_variables(equation[i], renamer);
           result.equations().push_back(pbes_equation(symbol, lhs, rhs));
           mCRL2log(log::debug) << "BESEquation: " << atermpp::aterm(symbol) << " " << lhs << " = " << rhs << std::endl;
 
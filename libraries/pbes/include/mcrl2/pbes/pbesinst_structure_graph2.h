@@ -552,7 +552,7 @@ class pbesinst_structure_graph_algorithm2: public pbesinst_structure_graph_algor
         }
         else if (m_options.optimization == 7)
         {
-          m_graph_builder.finalize();
+          m_graph_builder.update_graph();
           detail::partial_solve(m_graph_builder.m_graph, todo, S, tau, m_iteration_count, m_graph_builder); // modifies S[0] and S[1]
           assert(strategies_are_set_in_solved_nodes());
         }
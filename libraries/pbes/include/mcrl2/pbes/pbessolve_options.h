@@ -36,6 +36,9 @@ struct pbessolve_options
   bool check_strategy = false;
 
   bool prune_todo_alternative = false;
+
+  // the number of threads that is used to compute attractor sets while solving
+  std::size_t number_of_threads = 1;
 };
 
 inline
@@ -49,6 +52,7 @@ std::ostream& operator<<(std::ostream& out, const pbessolve_options& options)
   out << "aggressive = " << std::boolalpha << options.aggressive << std::endl;
   out << "check-strategy = " << std::boolalpha << options.check_strategy << std::endl;
   out << "prune-todo-alternative = " << std::boolalpha << options.prune_todo_alternative << std::endl;
+  out << "threads = " << options.number_of_threads << std::endl;
   return out;
 }
 
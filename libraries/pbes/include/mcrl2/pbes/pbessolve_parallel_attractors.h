@@ -0,0 +1,190 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/pbes/pbessolve_parallel_attractors.h
+/// \brief An attractor set computation that processes the frontier of the attractor with multiple threads.
+
+#ifndef MCRL2_PBES_PBESSOLVE_PARALLEL_ATTRACTORS_H
+#define MCRL2_PBES_PBESSOLVE_PARALLEL_ATTRACTORS_H
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+#include "mcrl2/pbes/pbessolve_attractors.h"
+
+namespace mcrl2 {
+
+namespace pbes_system {
+
+/// \brief Computes attractor sets by a level synchronous breadth first search over the predecessors, where
+///        the vertices of each level are divided over a number of threads.
+/// \details For every vertex that has been reached the number of successors outside the attractor is maintained
+///          in an atomic counter. A vertex of player alpha is added as soon as it is reached, and a vertex of the
+///          other player is added when its counter drops to zero. The counters are kept between calls, such that
+///          only the vertices that are reached by a computation have to be reset. The strategies are assigned
+///          after every level by the calling thread, so the Strategy does not have to be thread safe.
+class parallel_attractor
+{
+  protected:
+    typedef structure_graph::index_type index_type;
+
+    static constexpr index_type undefined_count = std::numeric_limits<index_type>::max();
+
+    // Levels with fewer vertices than this are handled by the calling thread.
+    static constexpr std::size_t minimal_parallel_level_size = 2048;
+
+    std::size_t m_number_of_threads;
+    std::unique_ptr<std::atomic<index_type>[]> m_count;
+    std::size_t m_extent = 0;
+
+    // For every thread the pairs (v, u) of newly attracted vertices v and a successor u in the attractor,
+    // and the vertices of which the counter has been initialized.
+    std::vector<std::vector<std::pair<index_type, index_type>>> m_attracted;
+    std::vector<std::vector<index_type>> m_touched;
+
+    void resize(std::size_t extent)
+    {
+      if (m_extent != extent)
+      {
+        m_count.reset(new std::atomic<index_type>[extent]);
+        for (std::size_t i = 0; i < extent; i++)
+        {
+          m_count[i].store(undefined_count, std::memory_order_relaxed);
+        }
+        m_extent = extent;
+      }
+    }
+
+    // Returns true if the vertex v is attracted because one of its successors is added to the attractor.
+    template <typename StructureGraph>
+    bool attract(const StructureGraph& G, index_type v, std::size_t alpha, std::vector<index_type>& touched)
+    {
+      std::atomic<index_type>& count = m_count[v];
+      if (G.decoration(v) == alpha)
+      {
+        index_type c = count.exchange(0);
+        if (c == undefined_count)
+        {
+          touched.push_back(v);
+        }
+        return c != 0;
+      }
+
+      index_type c = count.load(std::memory_order_relaxed);
+      if (c == undefined_count)
+      {
+        index_type n = 0;
+        for (auto w: G.successors(v))
+        {
+          static_cast<void>(w);
+          n++;
+        }
+        if (count.compare_exchange_strong(c, n))
+        {
+          touched.push_back(v);
+        }
+      }
+      return count.fetch_sub(1) == 1;
+    }
+
+    template <typename StructureGraph>
+    void process(const StructureGraph& G,
+                 const vertex_set& A,
+                 std::size_t alpha,
+                 const std::vector<index_type>& level,
+                 std::size_t first,
+                 std::size_t last,
+                 std::size_t thread_index)
+    {
+      auto& attracted = m_attracted[thread_index];
+      auto& touched = m_touched[thread_index];
+      for (std::size_t i = first; i < last; i++)
+      {
+        index_type u = level[i];
+        for (index_type v: G.predecessors(u))
+        {
+          if (!A.contains(v) && attract(G, v, alpha, touched))
+          {
+            attracted.emplace_back(v, u);
+          }
+        }
+      }
+    }
+
+  public:
+    explicit parallel_attractor(std::size_t number_of_threads)
+      : m_number_of_threads(std::max(number_of_threads, std::size_t(1))),
+        m_attracted(m_number_of_threads),
+        m_touched(m_number_of_threads)
+    {}
+
+    /// \brief Computes an attractor set, by extending A.
+    /// \param alpha 0 for the disjunctive and 1 for the conjunctive player.
+    template <typename StructureGraph, typename Strategy>
+    vertex_set operator()(const StructureGraph& G, vertex_set A, std::size_t alpha, Strategy tau)
+    {
+      resize(G.extent());
+
+      std::vector<index_type> level(A.vertices().begin(), A.vertices().end());
+      while (!level.empty())
+      {
+        if (level.size() < minimal_parallel_level_size || m_number_of_threads == 1)
+        {
+          process(G, A, alpha, level, 0, level.size(), 0);
+        }
+        else
+        {
+          std::vector<std::thread> threads;
+          std::size_t chunk_size = (level.size() + m_number_of_threads - 1) / m_number_of_threads;
+          for (std::size_t i = 0; i < m_number_of_threads; i++)
+          {
+            std::size_t first = std::min(i * chunk_size, level.size());
+            std::size_t last = std::min(first + chunk_size, level.size());
+            threads.emplace_back([&, first, last, i]() { process(G, A, alpha, level, first, last, i); });
+          }
+          for (std::thread& t: threads)
+          {
+            t.join();
+          }
+        }
+
+        // Add the vertices of the next level to the attractor, in the order of the threads.
+        level.clear();
+        for (auto& attracted: m_attracted)
+        {
+          for (const auto& p: attracted)
+          {
+            tau.set_strategy(p.first, p.second);
+            A.insert(p.first);
+            level.push_back(p.first);
+          }
+          attracted.clear();
+        }
+      }
+
+      // Reset the counters for the next computation.
+      for (auto& touched: m_touched)
+      {
+        for (index_type v: touched)
+        {
+          m_count[v].store(undefined_count, std::memory_order_relaxed);
+        }
+        touched.clear();
+      }
+
+      return A;
+    }
+};
+
+} // namespace pbes_system
+
+} // namespace mcrl2
+
+#endif // MCRL2_PBES_PBESSOLVE_PARALLEL_ATTRACTORS_H
@@ -18,6 +18,7 @@
 #include <utility>
 #include <boost/dynamic_bitset.hpp>
 #include <boost/range/adaptor/filtered.hpp>
+#include <boost/range/iterator_range.hpp>
 #include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/data/undefined.h"
 #include "mcrl2/pbes/pbes.h"
@@ -122,11 +123,61 @@ class structure_graph
       }
     };
 
+    typedef boost::iterator_range<const index_type*> index_range;
+
   protected:
     std::vector<vertex> m_vertices;
     index_type m_initial_vertex = 0;
     boost::dynamic_bitset<> m_exclude;
 
+    // After construction the edges are stored in a compressed sparse row layout: the successors of vertex u
+    // are stored in m_successors at the positions [m_successor_offsets[u], m_successor_offsets[u + 1]), and
+    // similarly for the predecessors. While the graph is constructed, the predecessors and successors of
+    // the vertices are used instead.
+    bool m_compressed = false;
+    std::vector<std::size_t> m_successor_offsets;
+    std::vector<index_type> m_successors;
+    std::vector<std::size_t> m_predecessor_offsets;
+    std::vector<index_type> m_predecessors;
+
+    // Moves the edges of the vertices into offsets and targets. The edges of a vertex are released as soon
+    // as they have been copied, such that the edges are not stored twice.
+    static void compress(std::vector<vertex>& vertices,
+                         std::vector<index_type> vertex::* edges,
+                         std::vector<std::size_t>& offsets,
+                         std::vector<index_type>& targets)
+    {
+      offsets.clear();
+      offsets.reserve(vertices.size() + 1);
+      offsets.push_back(0);
+      for (const vertex& u: vertices)
+      {
+        offsets.push_back(offsets.back() + (u.*edges).size());
+      }
+
+      targets.clear();
+      targets.reserve(offsets.back());
+      for (vertex& u: vertices)
+      {
+        targets.insert(targets.end(), (u.*edges).begin(), (u.*edges).end());
+        std::vector<index_type>().swap(u.*edges);
+      }
+    }
+
+    // Stores the predecessors and successors of the vertices in the compressed sparse row layout. This
+    // is done once, when no more edges will be added.
+    void compress_edges()
+    {
+      compress(m_vertices, &vertex::successors, m_successor_offsets, m_successors);
+      compress(m_vertices, &vertex::predecessors, m_predecessor_offsets, m_predecessors);
+      m_compressed = true;
+    }
+
+    static index_range make_range(const std::vector<index_type>& v)
+    {
+      return index_range(v.data(), v.data() + v.size());
+    }
+
     struct integers_not_contained_in
     {
       const boost::dynamic_bitset<>& subset;
@@ -165,7 +216,9 @@ class structure_graph
       : m_vertices(std::move(vertices)),
         m_initial_vertex(initial_vertex),
         m_exclude(std::move(exclude))
-    {}
+    {
+      compress_edges();
+    }
 
     index_type initial_vertex() const
     {
@@ -192,14 +245,22 @@ class structure_graph
       return m_vertices;
     }
 
-    const std::vector<index_type>& all_predecessors(index_type u) const
+    index_range all_predecessors(index_type u) const
     {
-      return m_vertices[u].predecessors;
+      if (!m_compressed)
+      {
+        return make_range(m_vertices[u].predecessors);
+      }
+      return index_range(m_predecessors.data() + m_predecessor_offsets[u], m_predecessors.data() + m_predecessor_offsets[u + 1]);
     }
 
-    const std::vector<index_type>& all_successors(index_type u) const
+    index_range all_successors(index_type u) const
     {
-      return m_vertices[u].successors;
+      if (!m_compressed)
+      {
+        return make_range(m_vertices[u].successors);
+      }
+      return index_range(m_successors.data() + m_successor_offsets[u], m_successors.data() + m_successor_offsets[u + 1]);
     }
 
     boost::filtered_range<vertices_not_contained_in, const std::vector<vertex>> vertices() const
@@ -207,12 +268,12 @@ class structure_graph
       return all_vertices() | boost::adaptors::filtered(vertices_not_contained_in(m_vertices, m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> predecessors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> predecessors(index_type u) const
     {
       return all_predecessors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
 
-    boost::filtered_range<integers_not_contained_in, const std::vector<index_type>> successors(index_type u) const
+    boost::filtered_range<integers_not_contained_in, const index_range> successors(index_type u) const
     {
       return all_successors(u) | boost::adaptors::filtered(integers_not_contained_in(m_exclude));
     }
@@ -258,7 +319,16 @@ class structure_graph
     // Returns true if all vertices have a rank and a decoration
     bool is_defined() const
     {
-      return std::all_of(m_vertices.begin(), m_vertices.end(), [](const vertex& u) { return u.is_defined(); });
+      for (std::size_t i = 0; i < m_vertices.size(); i++)
+      {
+        const vertex& u = m_vertices[i];
+        if (   ((u.decoration == d_none) && (u.rank == data::undefined_index()))
+            || (all_successors(i).empty() && u.decoration != d_true && u.decoration != d_false))
+        {
+          return false;
+        }
+      }
+      return true;
     }
 };
 
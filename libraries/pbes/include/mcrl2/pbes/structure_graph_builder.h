@@ -154,11 +154,20 @@ struct structure_graph_builder
     return i->second;
   }
 
-  // call at the end, to put the results into m_graph
+  // puts the intermediate results into m_graph, after which the builder can still be used to extend the graph;
+  // the edges are not compressed, hence this is cheap
+  void update_graph()
+  {
+    m_graph.m_initial_vertex = initial_vertex();
+    m_graph.m_exclude = boost::dynamic_bitset<>(m_graph.extent());
+  }
+
+  // call at the end, to put the results into m_graph; the builder can not be used to add edges afterwards
   void finalize()
   {
     m_graph.m_initial_vertex = initial_vertex();
     m_graph.m_exclude = boost::dynamic_bitset<>(m_graph.extent());
+    m_graph.compress_edges();
   }
 
   index_type find_vertex(const pbes_expression& x) const
@@ -281,6 +290,7 @@ struct manual_structure_graph_builder
 
     std::size_t N = m_vertices.size();
     m_graph.m_exclude = boost::dynamic_bitset<>(N);
+    m_graph.compress_edges();
   }
 };
 
@@ -0,0 +1,77 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file pbessolve_test.cpp
+/// \brief Tests for solving structure graphs.
+
+#define BOOST_TEST_MODULE pbessolve_test
+#include <random>
+#include <boost/test/included/unit_test_framework.hpp>
+
+#include "mcrl2/pbes/solve_structure_graph.h"
+#include "mcrl2/pbes/structure_graph_builder.h"
+
+using namespace mcrl2;
+using namespace mcrl2::pbes_system;
+
+// Creates a random structure graph in which every vertex has at least one successor.
+static void make_random_structure_graph(structure_graph& G, std::size_t n, std::size_t max_rank, std::mt19937& generator)
+{
+  detail::manual_structure_graph_builder builder(G);
+  std::uniform_int_distribution<std::size_t> vertex(0, n - 1);
+  std::uniform_int_distribution<std::size_t> rank(0, max_rank);
+  std::uniform_int_distribution<std::size_t> degree(1, 4);
+  std::bernoulli_distribution is_conjunctive(0.5);
+
+  for (std::size_t i = 0; i < n; i++)
+  {
+    builder.insert_vertex(is_conjunctive(generator), rank(generator));
+  }
+  for (std::size_t i = 0; i < n; i++)
+  {
+    for (std::size_t j = degree(generator); j > 0; j--)
+    {
+      builder.insert_edge(i, vertex(generator));
+    }
+  }
+  builder.set_initial_state(0);
+  builder.finalize();
+}
+
+class test_solve_structure_graph_algorithm: public solve_structure_graph_algorithm
+{
+  public:
+    explicit test_solve_structure_graph_algorithm(std::size_t number_of_threads)
+      : solve_structure_graph_algorithm(false, false, number_of_threads)
+    {}
+
+    std::pair<vertex_set, vertex_set> solve(structure_graph& G)
+    {
+      return solve_recursive_extended(G);
+    }
+};
+
+BOOST_AUTO_TEST_CASE(test_parallel_attractors)
+{
+  std::mt19937 generator(1234);
+  for (std::size_t n: { 10, 1000, 40000 })
+  {
+    structure_graph G;
+    make_random_structure_graph(G, n, 5, generator);
+
+    test_solve_structure_graph_algorithm sequential(1);
+    test_solve_structure_graph_algorithm parallel(4);
+    std::pair<vertex_set, vertex_set> W1 = sequential.solve(G);
+    std::pair<vertex_set, vertex_set> W4 = parallel.solve(G);
+    BOOST_CHECK(W1.first == W4.first);
+    BOOST_CHECK(W1.second == W4.second);
+
+    // Also check the strategy that is computed using the parallel attractors.
+    BOOST_CHECK_EQUAL(solve_structure_graph(G, true, 4), W1.first.contains(G.initial_vertex()));
+  }
+}
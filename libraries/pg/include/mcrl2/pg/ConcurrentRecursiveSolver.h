@@ -0,0 +1,71 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef MCRL2_PG_CONCURRENT_RECURSIVE_SOLVER_H
+#define MCRL2_PG_CONCURRENT_RECURSIVE_SOLVER_H
+
+#include "mcrl2/pg/RecursiveSolver.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*! Recursive parity game solver in which the attractor sets are computed by
+    multiple threads.
+
+    The attractor set is computed level by level: the vertices that are added
+    to the attractor in one level are divided over the threads, which check
+    their predecessors. For every vertex the number of successors outside the
+    attractor set is kept in an atomic counter, so a vertex is added by exactly
+    one thread. Levels that are small are handled by the calling thread. The
+    recursion itself is that of RecursiveSolver, so the winning sets do not
+    depend on the number of threads. */
+class ConcurrentRecursiveSolver : public RecursiveSolver
+{
+public:
+    ConcurrentRecursiveSolver(const ParityGame &game, std::size_t num_threads);
+    ~ConcurrentRecursiveSolver();
+
+    ParityGame::Strategy solve();
+
+protected:
+    void make_attractor_set( const ParityGame &game, ParityGame::Player player,
+                             DenseSet<verti> &attr, Substrategy &strat );
+
+private:
+    /*! Calls f(thread_index, begin, end) for a partition of [0, size) over the
+        threads; when size is small, f(0, 0, size) is called directly. */
+    template<class F> void parallel_for(std::size_t size, F f);
+
+    //! The number of threads used to compute attractor sets.
+    std::size_t num_threads_;
+
+    //! For every vertex the number of successors not in the attractor set.
+    std::unique_ptr<std::atomic<verti>[]> liberties_;
+
+    //! The vertices that are attracted in the current level, per thread.
+    std::vector<std::vector<verti> > attracted_;
+};
+
+//! Factory object for ConcurrentRecursiveSolver instances.
+class ConcurrentRecursiveSolverFactory : public ParityGameSolverFactory
+{
+public:
+    /*! Creates a factory for solvers that use `num_threads` threads, or as
+        many threads as the hardware supports if `num_threads` is zero. */
+    ConcurrentRecursiveSolverFactory(std::size_t num_threads = 0);
+
+    //! Returns a new ConcurrentRecursiveSolver instance.
+    ParityGameSolver *create( const ParityGame &game,
+        const verti *vertex_map, verti vertex_map_size );
+
+private:
+    std::size_t num_threads_;
+};
+
+#endif /* ndef MCRL2_PG_CONCURRENT_RECURSIVE_SOLVER_H */
@@ -11,6 +11,7 @@
 #define MCRL2_PG_RECURSIVE_SOLVER_H
 
 #include "mcrl2/utilities/logger.h"
+#include "mcrl2/pg/DenseSet.h"
 #include "mcrl2/pg/ParityGameSolver.h"
 
 /*! Provides a view of a strategy corresponding to a subset of the vertex set.
@@ -106,6 +107,13 @@ public:
 
     ParityGame::Strategy solve();
 
+protected:
+    /*! Extends `attr` to its attractor set for `player` in `game`, and sets
+        the strategy of the attracted vertices in `strat`. Subclasses can
+        override this to compute attractor sets differently. */
+    virtual void make_attractor_set( const ParityGame &game,
+        ParityGame::Player player, DenseSet<verti> &attr, Substrategy &strat );
+
 private:
     /*! Solves a subgame recursively, or returns false if solving is aborted. */
     bool solve(ParityGame &game, Substrategy &strat);
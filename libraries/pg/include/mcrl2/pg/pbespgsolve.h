@@ -15,6 +15,7 @@
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/pbes/algorithms.h"
 #include "mcrl2/pg/ComponentSolver.h"
+#include "mcrl2/pg/ConcurrentRecursiveSolver.h"
 #include "mcrl2/pg/DecycleSolver.h"
 #include "mcrl2/pg/DeloopSolver.h"
 #include "mcrl2/pg/ParityGame.h"
@@ -33,6 +34,7 @@ enum pbespg_solver_type
   spm_solver,
   alternative_spm_solver,
   recursive_solver,
+  concurrent_recursive_solver,
   priority_promotion
 };
 
@@ -51,6 +53,10 @@ pbespg_solver_type parse_solver_type(const std::string& s)
   {
     return recursive_solver;
   }
+  else if (s == "concrec")
+  {
+    return concurrent_recursive_solver;
+  }
   else if (s == "prioprom")
   {
     return priority_promotion;
@@ -67,6 +73,7 @@ std::string print(const pbespg_solver_type solver_type)
     case spm_solver: return "spm";
     case alternative_spm_solver: return "altspm";
     case recursive_solver: return "recursive";
+    case concurrent_recursive_solver: return "concrec";
     case priority_promotion: return "prioprom";
   }
   throw mcrl2::runtime_error("unknown solver");
@@ -81,6 +88,7 @@ std::string description(const pbespg_solver_type solver_type)
     case spm_solver: return "Small progress measures";
     case alternative_spm_solver: return "Alternative implementation of small progress measures";
     case recursive_solver: return "Recursive algorithm";
+    case concurrent_recursive_solver: return "Recursive algorithm that computes attractor sets with multiple threads (see --threads)";
     case priority_promotion: return "Priority promotion (experimental)";
   }
   throw mcrl2::runtime_error("unknown solver");
@@ -138,6 +146,7 @@ struct pbespgsolve_options
   bool verify_solution;
   bool only_generate;
   data::rewriter::strategy rewrite_strategy;
+  std::size_t number_of_threads; // Zero means the number of hardware threads.
 
   pbespgsolve_options()
     : solver_type(spm_solver),
@@ -146,7 +155,8 @@ struct pbespgsolve_options
       use_deloop_solver(true),
       verify_solution(true),
       only_generate(false),
-      rewrite_strategy(data::jitty)
+      rewrite_strategy(data::jitty),
+      number_of_threads(0)
   {
   }
 };
@@ -179,6 +189,10 @@ class pbespgsolve_algorithm
         // Create a recursive solver factory:
         solver_factory.reset(new RecursiveSolverFactory);
       }
+      else if (options.solver_type == concurrent_recursive_solver)
+      {
+        solver_factory.reset(new ConcurrentRecursiveSolverFactory(options.number_of_threads));
+      }
       else if (options.solver_type == priority_promotion)
       {
         solver_factory.reset(new PriorityPromotionSolverFactory);
@@ -0,0 +1,174 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cassert>
+#include <thread>
+
+#include "mcrl2/pg/ConcurrentRecursiveSolver.h"
+
+/*! Sets (or levels) with fewer vertices than this are handled by the calling
+    thread, since starting the threads costs more than it gains. */
+static const std::size_t minimal_parallel_size = 2048;
+
+ConcurrentRecursiveSolver::ConcurrentRecursiveSolver(
+        const ParityGame &game, std::size_t num_threads )
+    : RecursiveSolver(game),
+      num_threads_(std::max(num_threads, std::size_t(1))),
+      attracted_(num_threads_)
+{
+}
+
+ConcurrentRecursiveSolver::~ConcurrentRecursiveSolver()
+{
+}
+
+ParityGame::Strategy ConcurrentRecursiveSolver::solve()
+{
+    // Subgames are never larger than the game itself, so the counters can be
+    // shared by all attractor set computations.
+    liberties_.reset(new std::atomic<verti>[game_.graph().V()]);
+    ParityGame::Strategy strategy = RecursiveSolver::solve();
+    liberties_.reset();
+    return strategy;
+}
+
+template<class F>
+void ConcurrentRecursiveSolver::parallel_for(std::size_t size, F f)
+{
+    if (num_threads_ == 1 || size < minimal_parallel_size)
+    {
+        f(0, 0, size);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    const std::size_t chunk = (size + num_threads_ - 1)/num_threads_;
+    for (std::size_t i = 0; i < num_threads_; ++i)
+    {
+        const std::size_t begin = std::min(i*chunk, size);
+        const std::size_t end = std::min(begin + chunk, size);
+        threads.emplace_back([&f, i, begin, end]() { f(i, begin, end); });
+    }
+    for (std::thread &t : threads) t.join();
+}
+
+void ConcurrentRecursiveSolver::make_attractor_set(
+    const ParityGame &game, ParityGame::Player player,
+    DenseSet<verti> &attr, Substrategy &strat )
+{
+    const StaticGraph &graph = game.graph();
+    const verti V = graph.V();
+    std::atomic<verti> *liberties = liberties_.get();
+
+    // Initialize liberties so that liberties[v] == outdegree of v
+    if (graph.edge_dir() & StaticGraph::EDGE_SUCCESSOR)
+    {
+        parallel_for(V, [&](std::size_t, verti begin, verti end) {
+            for (verti v = begin; v < end; ++v)
+            {
+                liberties[v].store(graph.succ_end(v) - graph.succ_begin(v),
+                                   std::memory_order_relaxed);
+            }
+        });
+    }
+    else
+    {
+        parallel_for(V, [&](std::size_t, verti begin, verti end) {
+            for (verti v = begin; v < end; ++v)
+            {
+                liberties[v].store(0, std::memory_order_relaxed);
+            }
+        });
+        parallel_for(V, [&](std::size_t, verti begin, verti end) {
+            for (verti w = begin; w < end; ++w)
+            {
+                for (StaticGraph::const_iterator it = graph.pred_begin(w);
+                     it != graph.pred_end(w); ++it)
+                {
+                    liberties[*it].fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    // Mark initial set as included:
+    std::vector<verti> todo(attr.begin(), attr.end());
+    for (verti v : todo) liberties[v].store(0, std::memory_order_relaxed);
+
+    // Process the attractor set level by level:
+    while (!todo.empty())
+    {
+        parallel_for(todo.size(), [&](std::size_t i, std::size_t begin, std::size_t end) {
+            std::vector<verti> &attracted = attracted_[i];
+            for (std::size_t j = begin; j < end; ++j)
+            {
+                const verti w = todo[j];
+
+                // Check all predecessors v of w:
+                for (StaticGraph::const_iterator it = graph.pred_begin(w);
+                     it != graph.pred_end(w); ++it)
+                {
+                    const verti v = *it;
+
+                    // Skip predecessors that are already in the attractor set:
+                    if (liberties[v].load(std::memory_order_relaxed) == 0) continue;
+
+                    if (game.player(v) == player)
+                    {
+                        // Only the thread that claims v stores its strategy:
+                        if (liberties[v].exchange(0) == 0) continue;
+                        strat[v] = w;
+                    }
+                    else  // opponent controls vertex
+                    if (liberties[v].fetch_sub(1) == 1)
+                    {
+                        strat[v] = NO_VERTEX;
+                    }
+                    else
+                    {
+                        continue;  // not in the attractor set yet!
+                    }
+
+                    attracted.push_back(v);
+                }
+            }
+        });
+
+        // Add the vertices of the next level to the attractor set:
+        todo.clear();
+        for (std::vector<verti> &attracted : attracted_)
+        {
+            for (verti v : attracted)
+            {
+                attr.insert(v);
+                todo.push_back(v);
+            }
+            attracted.clear();
+        }
+    }
+}
+
+ConcurrentRecursiveSolverFactory::ConcurrentRecursiveSolverFactory(
+        std::size_t num_threads )
+    : num_threads_(num_threads)
+{
+    if (num_threads_ == 0)
+    {
+        num_threads_ = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+}
+
+ParityGameSolver *ConcurrentRecursiveSolverFactory::create(
+    const ParityGame &game, const verti *vertex_map, verti vertex_map_size )
+{
+    (void)vertex_map;       // unused
+    (void)vertex_map_size;  // unused
+
+    return new ConcurrentRecursiveSolver(game, num_threads_);
+}
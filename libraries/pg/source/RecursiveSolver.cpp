@@ -12,7 +12,6 @@
 
 #include "mcrl2/pg/attractor.h"
 #include "mcrl2/pg/attractor_impl.h"
-#include "mcrl2/pg/DenseSet.h"
 #include "mcrl2/pg/RecursiveSolver.h"
 
 /*! Returns the complement of a vertex set.
@@ -74,6 +73,12 @@ ParityGame::Strategy RecursiveSolver::solve()
     return strategy;
 }
 
+void RecursiveSolver::make_attractor_set( const ParityGame &game,
+    ParityGame::Player player, DenseSet<verti> &attr, Substrategy &strat )
+{
+    make_attractor_set_2(game, player, attr, strat);
+}
+
 /* Implementation note: the recursive solver might use either a DenseSet or
    a std::set to store vertex sets (which are passed to make_attractor_set).
    The former is faster when the size of these sets is large, but requires O(V)
@@ -110,7 +115,7 @@ bool RecursiveSolver::solve(ParityGame &game, Substrategy &strat)
             }
             mCRL2log(mcrl2::log::debug) <<"|min_prio|=" << min_prio_attr.size() << std::endl;
             assert(!min_prio_attr.empty());
-            make_attractor_set_2(game, player, min_prio_attr, strat);
+            make_attractor_set(game, player, min_prio_attr, strat);
             mCRL2log(mcrl2::log::debug) << "|min_prio_attr|=" << min_prio_attr.size() << std::endl;
             if (min_prio_attr.size() == V) break;
             get_complement(V, min_prio_attr).swap(unsolved);
@@ -138,7 +143,7 @@ bool RecursiveSolver::solve(ParityGame &game, Substrategy &strat)
             }
             mCRL2log(mcrl2::log::debug) << "|lost|=" << lost_attr.size() << std::endl;
             if (lost_attr.empty()) break;
-            make_attractor_set_2(game, opponent, lost_attr, strat);
+            make_attractor_set(game, opponent, lost_attr, strat);
             mCRL2log(mcrl2::log::debug) << "|lost_attr|=" << lost_attr.size() << std::endl;
             get_complement(V, lost_attr).swap(unsolved);
         }
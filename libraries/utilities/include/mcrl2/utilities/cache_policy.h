@@ -10,7 +10,16 @@
 #ifndef MCRL2_UTILITIES_CACHE_POLICY_H
 #define MCRL2_UTILITIES_CACHE_POLICY_H
 
+#include "mcrl2/utilities/exception.h"
+
 #include <forward_list>
+#include <iostream>
+#include <list>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <assert.h>
 
@@ -123,6 +132,307 @@ private:
   typename std::forward_list<key_type>::iterator m_last_element_it;
 };
 
+/// \brief A policy that replaces the element that has not been found or inserted for the longest time.
+template<typename Map>
+class lru_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  lru_policy() = default;
+
+  lru_policy(const lru_policy& other)
+    : m_queue(other.m_queue)
+  {
+    update_positions();
+  }
+
+  lru_policy& operator=(const lru_policy& other)
+  {
+    m_queue = other.m_queue;
+    update_positions();
+    return *this;
+  }
+
+  // Moving a list keeps its iterators valid.
+  lru_policy(lru_policy&& other) noexcept = default;
+  lru_policy& operator=(lru_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_queue.clear();
+    m_positions.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_queue.empty());
+    // Remove the least recently used key, which is at the front of the queue.
+    auto it = map.find(m_queue.front());
+    m_positions.erase(m_queue.front());
+    m_queue.pop_front();
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    m_positions[key] = m_queue.insert(m_queue.end(), key);
+  }
+
+  void touch(const key_type& key) override
+  {
+    // Move the key to the back of the queue, as it has been used most recently.
+    auto it = m_positions.find(key);
+    assert(it != m_positions.end());
+    m_queue.splice(m_queue.end(), m_queue, it->second);
+  }
+
+private:
+  void update_positions()
+  {
+    m_positions.clear();
+    for (auto it = m_queue.begin(); it != m_queue.end(); ++it)
+    {
+      m_positions[*it] = it;
+    }
+  }
+
+  std::list<key_type> m_queue; ///< The keys from least to most recently used.
+  std::unordered_map<key_type, typename std::list<key_type>::iterator> m_positions;
+};
+
+/// \brief A policy that approximates lru_policy. The keys are kept in a circular buffer, and a hand moves
+///        along the buffer to find a key that has not been used since the hand passed it the last time.
+/// \details Finding an element only sets a bit, which is cheaper than reordering a list.
+template<typename Map>
+class clock_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  void clear() override
+  {
+    m_keys.clear();
+    m_positions.clear();
+    m_hand = 0;
+    m_free = false;
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_keys.empty());
+    // Give keys that have been used a second chance, and take the first key that was not used.
+    while (m_keys[m_hand].second)
+    {
+      m_keys[m_hand].second = false;
+      m_hand = (m_hand + 1) % m_keys.size();
+    }
+
+    // The next inserted key takes the position of the replaced key.
+    auto it = map.find(m_keys[m_hand].first);
+    m_positions.erase(m_keys[m_hand].first);
+    m_free = true;
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    if (m_free)
+    {
+      m_keys[m_hand] = std::make_pair(key, false);
+      m_positions[key] = m_hand;
+      m_hand = (m_hand + 1) % m_keys.size();
+      m_free = false;
+    }
+    else
+    {
+      m_positions[key] = m_keys.size();
+      m_keys.emplace_back(key, false);
+    }
+  }
+
+  void touch(const key_type& key) override
+  {
+    auto it = m_positions.find(key);
+    assert(it != m_positions.end());
+    m_keys[it->second].second = true;
+  }
+
+private:
+  std::vector<std::pair<key_type, bool>> m_keys; ///< The keys, and whether they were used since the hand passed them.
+  std::unordered_map<key_type, std::size_t> m_positions;
+  std::size_t m_hand = 0; ///< The position in m_keys where the search for a key to replace starts.
+  bool m_free = false;    ///< True iff the key at position m_hand has been replaced.
+};
+
+/// \brief A policy that replaces the element that has been found the least number of times. Among the
+///        elements that have been found equally often, the one that was inserted or found first is replaced.
+template<typename Map>
+class lfu_policy final : public replacement_policy<Map>
+{
+public:
+  using key_type = typename Map::key_type;
+
+  lfu_policy() = default;
+
+  lfu_policy(const lfu_policy& other)
+    : m_frequencies(other.m_frequencies)
+  {
+    update_positions();
+  }
+
+  lfu_policy& operator=(const lfu_policy& other)
+  {
+    m_frequencies = other.m_frequencies;
+    update_positions();
+    return *this;
+  }
+
+  // Moving a map of lists keeps the iterators into the lists valid.
+  lfu_policy(lfu_policy&& other) noexcept = default;
+  lfu_policy& operator=(lfu_policy&& other) noexcept = default;
+
+  void clear() override
+  {
+    m_frequencies.clear();
+    m_positions.clear();
+  }
+
+  typename Map::iterator replacement_candidate(Map& map) override
+  {
+    assert(!m_frequencies.empty());
+    // Remove the oldest key of the lowest frequency.
+    auto least = m_frequencies.begin();
+    auto it = map.find(least->second.front());
+    m_positions.erase(least->second.front());
+    least->second.pop_front();
+    if (least->second.empty())
+    {
+      m_frequencies.erase(least);
+    }
+    assert(it != map.end());
+    return it;
+  }
+
+  void inserted(const key_type& key) override
+  {
+    std::list<key_type>& keys = m_frequencies[0];
+    m_positions[key] = std::make_pair(std::size_t(0), keys.insert(keys.end(), key));
+  }
+
+  void touch(const key_type& key) override
+  {
+    // Move the key to the back of the keys with a frequency that is one higher.
+    auto it = m_positions.find(key);
+    assert(it != m_positions.end());
+    auto current = m_frequencies.find(it->second.first);
+    std::list<key_type>& keys = m_frequencies[it->second.first + 1];
+    keys.splice(keys.end(), current->second, it->second.second);
+    if (current->second.empty())
+    {
+      m_frequencies.erase(current);
+    }
+    ++it->second.first;
+  }
+
+private:
+  void update_positions()
+  {
+    m_positions.clear();
+    for (auto& [frequency, keys] : m_frequencies)
+    {
+      for (auto it = keys.begin(); it != keys.end(); ++it)
+      {
+        m_positions[*it] = std::make_pair(frequency, it);
+      }
+    }
+  }
+
+  std::map<std::size_t, std::list<key_type>> m_frequencies; ///< The keys per frequency, from least to most recently used.
+  std::unordered_map<key_type, std::pair<std::size_t, typename std::list<key_type>::iterator>> m_positions;
+};
+
+/// \brief The replacement policies that can be selected at run time, for instance on the command line.
+enum class cache_replacement
+{
+  fifo,  ///< Replace the element that was inserted first.
+  lru,   ///< Replace the least recently used element.
+  clock, ///< Replace an element that was not used since the last time it was considered for replacement.
+  lfu    ///< Replace the least frequently used element.
+};
+
+inline
+cache_replacement parse_cache_replacement(const std::string& s)
+{
+  if (s == "fifo")
+  {
+    return cache_replacement::fifo;
+  }
+  else if (s == "lru")
+  {
+    return cache_replacement::lru;
+  }
+  else if (s == "clock")
+  {
+    return cache_replacement::clock;
+  }
+  else if (s == "lfu")
+  {
+    return cache_replacement::lfu;
+  }
+  throw mcrl2::runtime_error("unknown cache replacement policy " + s);
+}
+
+inline
+std::istream& operator>>(std::istream& is, cache_replacement& policy)
+{
+  try
+  {
+    std::string s;
+    is >> s;
+    policy = parse_cache_replacement(s);
+  }
+  catch (mcrl2::runtime_error&)
+  {
+    is.setstate(std::ios_base::failbit);
+  }
+  return is;
+}
+
+inline
+std::string pp(const cache_replacement policy)
+{
+  switch (policy)
+  {
+    case cache_replacement::fifo: return "fifo";
+    case cache_replacement::lru: return "lru";
+    case cache_replacement::clock: return "clock";
+    case cache_replacement::lfu: return "lfu";
+    default: throw mcrl2::runtime_error("unknown cache replacement policy");
+  }
+}
+
+inline
+std::ostream& operator<<(std::ostream& os, const cache_replacement policy)
+{
+  return os << pp(policy);
+}
+
+inline
+std::string description(const cache_replacement policy)
+{
+  switch (policy)
+  {
+    case cache_replacement::fifo: return "replace the element that was inserted first";
+    case cache_replacement::lru: return "replace the least recently used element";
+    case cache_replacement::clock: return "replace an element that was not used since the last time it was considered, which approximates lru";
+    case cache_replacement::lfu: return "replace the least frequently used element";
+    default: throw mcrl2::runtime_error("unknown cache replacement policy");
+  }
+}
+
 } // namespace utilities
 } // namespace mcrl2
 
@@ -48,6 +48,9 @@ public:
     }
   }
 
+  iterator begin() { return m_map.begin(); }
+  iterator end() { return m_map.end(); }
+
   const_iterator begin() const { return m_map.begin(); }
   const_iterator end() const { return m_map.end(); }
 
@@ -55,9 +58,21 @@ public:
 
   std::size_t count(const key_type& key) const { return m_map.count(key); }
 
+  /// \returns The number of elements in the cache.
+  std::size_t size() const { return m_map.size(); }
+
+  /// \returns The number of elements that have been removed to make room for new elements.
+  std::size_t evictions() const { return m_evictions; }
+
+  /// \brief Finds the element with the given key, and informs the policy that it has been used.
   iterator find(const key_type& key)
   {
-    return m_map.find(key);
+    auto result = m_map.find(key);
+    if (result != m_map.end())
+    {
+      m_policy.touch(key);
+    }
+    return result;
   }
 
   /// \brief Stores the given key-value pair in the cache. Depending on the cache policy and capacity an existing element
@@ -68,7 +83,7 @@ public:
     // The reason to split the find and emplace is that when we insert an element the replacement_candidate should not be
     // the key that we just inserted. The other way around, when an element that we are looking for was first removed and
     // then searched for also leads to unnecessary inserts.
-    auto result = find(args...);
+    auto result = m_map.find(args...);
     if (result == m_map.end())
     {
       // If the cache would be full after an inserted.
@@ -76,6 +91,7 @@ public:
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
+        ++m_evictions;
       }
 
       // Insert an element and inform the policy that an element was inserted.
@@ -93,6 +109,7 @@ protected:
   Policy                    m_policy; ///< The replacement policy for keys in the cache.
 
   std::size_t m_maximum_size; ///< The maximum number of elements to cache.
+  std::size_t m_evictions = 0; ///< The number of elements that have been removed by the policy.
 };
 
 /// \brief A cache keeps track of key-value pairs similar to a map. The difference is that a cache
@@ -106,6 +123,7 @@ private:
   using super = fixed_size_cache<Policy>;
   using super::m_map;
   using super::m_maximum_size;
+  using super::m_evictions;
   using super::m_policy;
   using super::find;
 
@@ -130,6 +148,7 @@ public:
       {
         // Remove an existing element defined by the policy.
         m_map.erase(m_policy.replacement_candidate(m_map));
+        ++m_evictions;
       }
 
       // Insert an element and inform the policy that an element was inserted.
@@ -151,6 +170,18 @@ private:
 template<typename Key, typename T>
 using fifo_cache = fixed_size_cache<fifo_policy<mcrl2::utilities::unordered_map<Key, T>>>;
 
+template<typename Key, typename T>
+using lru_cache = fixed_size_cache<lru_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using clock_cache = fixed_size_cache<clock_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using lfu_cache = fixed_size_cache<lfu_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
+template<typename Key, typename T>
+using unbounded_cache = fixed_size_cache<no_policy<mcrl2::utilities::unordered_map<Key, T>>>;
+
 template<typename F, typename Args>
 using fifo_function_cache = function_cache<
   fifo_policy<mcrl2::utilities::unordered_map<Args, decltype(std::declval<F>()(std::declval<Args>()))>>,
@@ -126,6 +126,10 @@ class tool
       {
         log::mcrl2_logger::set_reporting_level(log::log_level_from_string(parser.option_argument("log-level")));
       }
+      if (parser.options.count("gc-stats"))
+      {
+        log::mcrl2_logger::set_reporting_level(log::debug, "gc");
+      }
 #endif
     }
 
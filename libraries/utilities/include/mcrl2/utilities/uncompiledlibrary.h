@@ -28,6 +28,8 @@
  *
  * The source is compiled using a script that must take two string arguments.
  * The first argument is the source file, the second is the destination file.
+ * A library can also be compiled from several source files, which are then all
+ * passed to the script.
  * After (successful) termination, only the source and destination files must
  * remain on disk -- it is the responsibility of the script to remove any
  * temporary files.
@@ -41,6 +43,7 @@
 #include <string>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 #include "mcrl2/utilities/dynamiclibrary.h"
 #include "mcrl2/utilities/file_utility.h"
 #include "mcrl2/utilities/logger.h"
@@ -55,9 +58,21 @@ class uncompiled_library : public dynamic_library
     uncompiled_library(const std::string& script) : m_compile_script(script) {}
 
     void compile(const std::string& filename) 
+    {
+      compile(std::vector<std::string>{ filename });
+    }
+
+    /// \brief Compiles the given source files into a single library. The first file is passed
+    ///        first to the compile script, which names the library after it.
+    void compile(const std::vector<std::string>& filenames)
     {
       std::stringstream commandline;
-      commandline << '"' << m_compile_script << "\" " << filename << " " << " 2>&1";
+      commandline << '"' << m_compile_script << "\"";
+      for (const std::string& filename: filenames)
+      {
+        commandline << " " << filename;
+      }
+      commandline << " 2>&1";
       
       // Execute script.
       FILE* stream = popen(commandline.str().c_str(), "r");
@@ -117,6 +132,20 @@ class uncompiled_library : public dynamic_library
       m_filename = m_tempfiles.back();
     }
 
+    /// \brief Uses the library in the given file, which has been compiled before, instead
+    ///        of compiling a source file. The file is not removed by cleanup().
+    void use_compiled_library(const std::string& filename)
+    {
+      m_tempfiles.clear();
+      m_filename = filename;
+    }
+
+    /// \returns The filename of the compiled library.
+    const std::string& library_filename() const
+    {
+      return m_filename;
+    }
+
     void leave_files()
     {
       m_tempfiles.clear();
@@ -50,7 +50,7 @@ private:
   // Hashes only the keys of each pair.
   struct PairHash
   {
-    PairHash(const hasher& hash)
+    PairHash(const hasher& hash = hasher())
       : hash(hash)
     {}
 
@@ -75,7 +75,7 @@ private:
   // Compares only the keys of each pair.
   struct PairEquals
   {
-    PairEquals(const key_equals& equals)
+    PairEquals(const key_equals& equals = key_equals())
       : equals(equals)
     {}
 
@@ -390,6 +390,8 @@ interface_description::interface_description(std::string const& path,
   add_hidden_option("debug", "display detailed intermediate messages", 'd');
   add_hidden_option("log-level", make_mandatory_argument<std::string>("LEVEL", ""),
                     "display intermediate messages up to and including level");
+  add_hidden_option("gc-stats", "display the pause time, the number of destroyed terms and the "
+                    "number of remaining terms of every garbage collection of terms");
 }
 
 std::string interface_description::copyright_message()
@@ -38,3 +38,79 @@ BOOST_AUTO_TEST_CASE(test_function_cache)
   }
 
 }
+
+BOOST_AUTO_TEST_CASE(test_lru_cache)
+{
+  lru_cache<int, int> cache(16);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    // Use the first element all the time, such that it is never the least recently used one.
+    if (cache.find(0) == cache.end())
+    {
+      BOOST_CHECK_EQUAL(i, 0);
+      cache.emplace(0, 0);
+    }
+    cache.emplace(i, i*i);
+  }
+
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(999) != cache.end());
+  BOOST_CHECK_EQUAL(cache.find(999)->second, 999*999);
+  BOOST_CHECK(cache.find(1) == cache.end());
+}
+
+BOOST_AUTO_TEST_CASE(test_clock_cache)
+{
+  clock_cache<int, int> cache(16);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    // The first element is used all the time, such that it always gets a second chance.
+    if (cache.find(0) == cache.end())
+    {
+      BOOST_CHECK_EQUAL(i, 0);
+      cache.emplace(0, 0);
+    }
+    cache.emplace(i, i*i);
+  }
+
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(999) != cache.end());
+  BOOST_CHECK_EQUAL(cache.find(999)->second, 999*999);
+  BOOST_CHECK(cache.find(1) == cache.end());
+  BOOST_CHECK_EQUAL(cache.size() + cache.evictions(), 1000u);
+}
+
+BOOST_AUTO_TEST_CASE(test_lfu_cache)
+{
+  lfu_cache<int, int> cache(16);
+
+  // Use the first two elements more often than any other element.
+  cache.emplace(0, 0);
+  cache.emplace(1, 1);
+  for (int i = 0; i < 3; ++i)
+  {
+    cache.find(0);
+    cache.find(1);
+  }
+
+  for (int i = 2; i < 1000; ++i)
+  {
+    cache.emplace(i, i*i);
+    cache.find(i);
+  }
+
+  BOOST_CHECK(cache.find(0) != cache.end());
+  BOOST_CHECK(cache.find(1) != cache.end());
+  BOOST_CHECK(cache.find(999) != cache.end());
+  BOOST_CHECK_EQUAL(cache.find(999)->second, 999*999);
+  BOOST_CHECK(cache.find(2) == cache.end());
+  BOOST_CHECK_EQUAL(cache.size() + cache.evictions(), 1000u);
+
+  // A copy of the cache uses the same policy.
+  lfu_cache<int, int> copy(cache);
+  copy.emplace(1000, 0);
+  BOOST_CHECK(copy.find(0) != copy.end());
+  BOOST_CHECK(copy.find(999) != copy.end());
+}
@@ -58,11 +58,26 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
 
       // copied from lps2lts
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
+      desc.add_option("cache-size", utilities::make_mandatory_argument("NUM"),
+                 "with --cached, bound the memory used by each cache by remembering the enumeration results for "
+                 "at least, but not many more than, NUM valuations of the parameters. "
+                 "(Default NUM=0, which does not bound the caches). ");
+      utilities::interface_description::enum_argument<utilities::cache_replacement> cache_policy_option("NAME");
+      cache_policy_option.add_value(utilities::cache_replacement::fifo);
+      cache_policy_option.add_value(utilities::cache_replacement::lru, true);
+      cache_policy_option.add_value(utilities::cache_replacement::clock);
+      cache_policy_option.add_value(utilities::cache_replacement::lfu);
+      desc.add_option("cache-policy", cache_policy_option,
+                 "when the size of the caches is bounded, use policy NAME to decide which enumeration result is forgotten:");
       desc.add_option("max", utilities::make_mandatory_argument("NUM"), "explore at most NUM states", 'l');
       desc.add_option("todo-max", utilities::make_mandatory_argument("NUM"),
                  "keep at most NUM states in todo lists; this option is only relevant for "
                  "highway search, where NUM is the maximum number of states per "
                  "level. ");
+      desc.add_option("threads", utilities::make_mandatory_argument("NUM"),
+                 "use NUM threads to compute the outgoing transitions of states. This option requires "
+                 "a toolset that is built with MCRL2_ENABLE_MULTITHREADING, and is ignored for "
+                 "stochastic specifications. ");
       desc.add_option("nondeterminism", "detect nondeterministic states, i.e. states with outgoing transitions with the same label to different states. ", 'n');
       desc.add_option("deadlock", "detect deadlocks (i.e. for every deadlock a message is printed). ", 'D');
       desc.add_option("divergence",
@@ -113,7 +128,9 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
                             "horrendous. This feature helps to suppress those. Other verbose messages, "
                             "such as the total number of states explored, just remain visible. ");
       desc.add_option("no-store", "save the resulting LTS to disk while generating. Currently this only works "
-                              "for .aut files.");
+                              "for .aut and .lts files.");
+      desc.add_option("no-summand-index", "try all summands in every state, instead of only the summands "
+                              "of which the conditions are not falsified by the values of the process parameters.");
     }
 
     std::list<std::string> split_actions(const std::string& s)
@@ -152,8 +169,14 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
     {
       super::parse_options(parser);
       options.no_store                              = parser.has_option("no-store");
+      options.no_summand_index                      = parser.has_option("no-summand-index");
       options.cached                                = parser.has_option("cached");
       options.global_cache                          = parser.has_option("global-cache");
+      options.cache_policy                          = parser.option_argument_as<utilities::cache_replacement>("cache-policy");
+      if (parser.has_option("cache-size"))
+      {
+        options.cache_size = parser.option_argument_as<std::size_t>("cache-size");
+      }
       options.confluence                            = parser.has_option("confluence");
       options.one_point_rule_rewrite                = !parser.has_option("no-one-point-rule-rewrite");
       options.replace_constants_by_variables        = !parser.has_option("no-replace-constants-by-variables");
@@ -176,6 +199,20 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         options.todo_max = parser.option_argument_as<std::size_t>("todo-max");
       }
 
+      if (parser.has_option("threads"))
+      {
+        options.number_of_threads = parser.option_argument_as<std::size_t>("threads");
+        if (options.number_of_threads == 0)
+        {
+          parser.error("The number of threads must be at least one.");
+        }
+        if (options.number_of_threads > 1 && !atermpp::detail::GlobalThreadSafe)
+        {
+          options.number_of_threads = 1;
+          mCRL2log(log::warning) << "Ignoring the threads option, because this toolset is built without MCRL2_ENABLE_MULTITHREADING." << std::endl;
+        }
+      }
+
       if (parser.has_option("out"))
       {
         output_format = lts::detail::parse_format(parser.option_argument("out"));
@@ -238,7 +275,7 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
         parser.error("Too many file arguments.");
       }
 
-      if (options.no_store && (output_filename().empty() || output_format != lts::lts_aut))
+      if (options.no_store && ((output_filename().empty() && output_format == lts::lts_aut) || (output_format != lts::lts_aut && output_format != lts::lts_lts)))
       {
         options.no_store = false;
         mCRL2log(log::warning) << "Ignoring the no-store option.";
@@ -262,7 +299,11 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
           }
         case lts::lts_dot: return std::unique_ptr<lts::lts_builder>(new lts::lts_dot_builder(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters()));
         case lts::lts_fsm: return std::unique_ptr<lts::lts_builder>(new lts::lts_fsm_builder(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters()));
-        case lts::lts_lts: return std::unique_ptr<lts::lts_builder>(new lts::lts_lts_builder(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters()));
+        case lts::lts_lts:
+          {
+            return options.no_store ? std::unique_ptr<lts::lts_builder>(new lts::lts_lts_disk_builder(output_filename(), lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters()))
+                                    : std::unique_ptr<lts::lts_builder>(new lts::lts_lts_builder(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters()));
+          }
         default: return std::unique_ptr<lts::lts_builder>(new lts::lts_none_builder());
       }
     }
@@ -296,6 +337,11 @@ class generatelts_tool: public rewriter_tool<input_output_tool>
 
       if (lps::is_stochastic(stochastic_lpsspec))
       {
+        if (options.number_of_threads > 1)
+        {
+          options.number_of_threads = 1;
+          mCRL2log(log::warning) << "Ignoring the threads option, because the specification is stochastic." << std::endl;
+        }
         auto builder = create_stochastic_lts_builder(stochastic_lpsspec);
         if (is_timed)
         {
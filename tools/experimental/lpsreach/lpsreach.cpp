@@ -0,0 +1,92 @@
+// Author(s): Maurice Laveaux
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lpsreach.cpp
+
+#include <chrono>
+#include <iomanip>
+#include "mcrl2/data/rewriter_tool.h"
+#include "mcrl2/lps/io.h"
+#include "mcrl2/lps/lpsreach.h"
+#include "mcrl2/utilities/input_tool.h"
+
+using namespace mcrl2;
+using data::tools::rewriter_tool;
+using utilities::tools::input_tool;
+
+class lpsreach_tool: public rewriter_tool<input_tool>
+{
+  typedef rewriter_tool<input_tool> super;
+
+  protected:
+    lps::lpsreach_options options;
+    bool print_dependencies = false;
+
+    void add_options(utilities::interface_description& desc) override
+    {
+      super::add_options(desc);
+      desc.add_option("chaining", "apply the summands one after another within an iteration, such that the states "
+                                  "found by one summand are also explored by the next ones", 'c');
+      desc.add_option("cached", "use enumeration caching techniques to speed up learning the transition relations");
+      desc.add_option("one-point-rule-rewrite", "apply the one point rule rewriter to the summands", 'p');
+      desc.add_option("replace-constants-by-variables", "move constant expressions in the summands to the substitution");
+      desc.add_option("print-dependencies", "print for every summand whether it reads (r), writes (w), or reads and "
+                                            "writes (+) each process parameter", 'D');
+    }
+
+    void parse_options(const utilities::command_line_parser& parser) override
+    {
+      super::parse_options(parser);
+      options.rewrite_strategy               = rewrite_strategy();
+      options.search_strategy                = lps::es_breadth;
+      options.chaining                       = parser.has_option("chaining");
+      options.cached                         = parser.has_option("cached");
+      options.one_point_rule_rewrite         = parser.has_option("one-point-rule-rewrite");
+      options.replace_constants_by_variables = parser.has_option("replace-constants-by-variables");
+      print_dependencies                     = parser.has_option("print-dependencies");
+    }
+
+  public:
+    lpsreach_tool()
+      : super("lpsreach",
+              "Maurice Laveaux",
+              "computes the reachable states of an LPS symbolically",
+              "Computes the number of reachable states of the LPS in INFILE, which are stored in list decision "
+              "diagrams. The transition relation of every summand is learned on the fly for the values of the "
+              "process parameters that it reads. If INFILE is not present, standard input is used."
+             )
+    {}
+
+    bool run() override
+    {
+      lps::specification lpsspec;
+      lps::load_lps(lpsspec, input_filename());
+
+      mCRL2log(log::verbose) << options;
+      mCRL2log(log::verbose) << "chaining = " << std::boolalpha << options.chaining << std::endl;
+
+      const auto start = std::chrono::steady_clock::now();
+      lps::lpsreach_algorithm algorithm(lpsspec, options);
+      if (print_dependencies)
+      {
+        std::cout << algorithm.print_dependencies();
+      }
+
+      const lps::ldd_manager::ldd states = algorithm.run();
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << "number of states = " << std::fixed << std::setprecision(0) << algorithm.count(states) << std::endl;
+      mCRL2log(log::verbose) << "number of LDD nodes = " << algorithm.number_of_nodes() << std::endl;
+      mCRL2log(log::verbose) << "time = " << std::setprecision(3) << elapsed.count() << "s" << std::endl;
+      return true;
+    }
+};
+
+int main(int argc, char** argv)
+{
+  return lpsreach_tool().execute(argc, argv);
+}
@@ -138,11 +138,26 @@ class lps2lts_tool : public lps2lts_base
     {
       lps2lts_base::add_options(desc);
 
+      interface_description::enum_argument<mcrl2::utilities::cache_replacement> cache_policy_option("NAME");
+      cache_policy_option.add_value(mcrl2::utilities::cache_replacement::fifo);
+      cache_policy_option.add_value(mcrl2::utilities::cache_replacement::lru, true);
+      cache_policy_option.add_value(mcrl2::utilities::cache_replacement::clock);
+      cache_policy_option.add_value(mcrl2::utilities::cache_replacement::lfu);
+
       desc.
       add_option("cached",
                  "use enumeration caching techniques to speed up state space generation. ").
+      add_option("cache-size", make_mandatory_argument("NUM"),
+                 "with --cached, bound the memory used by the cache of each summand by remembering the enumeration "
+                 "results for at least, but not many more than, NUM valuations of the parameters. "
+                 "(Default NUM=0, which does not bound the caches). ").
+      add_option("cache-policy", cache_policy_option,
+                 "when the size of the caches is bounded, use policy NAME to decide which enumeration result is forgotten:").
       add_option("prune",
                  "use summand pruning to speed up state space generation. ").
+      add_option("no-summand-index",
+                 "try all summands in every state, instead of only the summands of which the conditions are not "
+                 "falsified by the values of the process parameters. This has no effect in combination with --prune. ").
       add_option("dummy", make_mandatory_argument("BOOL"),
                  "replace free variables in the LPS with dummy values based on the value of BOOL: 'yes' (default) or 'no'. ", 'y').
       add_option("unused-data",
@@ -156,6 +171,11 @@ class lps2lts_tool : public lps2lts_base
                  "they are mapped to the same hash), it can be useful to explore very "
                  "large LTSs that are otherwise not explorable. The default value for NUM is "
                  "2*10^8 (this corresponds to 25MB of memory). ",'b').
+      add_option("tree-compression",
+                 "store the states using tree compression, i.e., every state is stored as a tree "
+                 "of pairs of indices of shared subvectors of the state. This uses considerably "
+                 "less memory for LPSs with many parameters, at the expense of some time. "
+                 "This option is ignored in combination with --bit-hash. ").
       add_option("max", make_mandatory_argument("NUM"),
                  "explore at most NUM states", 'l').
       add_option("todo-max", make_mandatory_argument("NUM"),
@@ -239,7 +259,13 @@ class lps2lts_tool : public lps2lts_base
       m_options.strat           = parser.option_argument_as< mcrl2::data::rewriter::strategy >("rewriter");
 
       m_options.use_enumeration_caching = parser.options.count("cached") > 0;
+      if (parser.options.count("cache-size"))
+      {
+        m_options.enumeration_cache_size = parser.option_argument_as< std::size_t >("cache-size");
+      }
+      m_options.enumeration_cache_policy = parser.option_argument_as< mcrl2::utilities::cache_replacement >("cache-policy");
       m_options.use_summand_pruning = parser.options.count("prune") > 0;
+      m_options.use_summand_index = parser.options.count("no-summand-index") == 0;
 
       if (parser.options.count("dummy"))
       {
@@ -267,6 +293,7 @@ class lps2lts_tool : public lps2lts_base
         m_options.bithashing  = true;
         m_options.bithashsize = parser.option_argument_as< unsigned long > ("bit-hash");
       }
+      m_options.tree_compression = parser.options.count("tree-compression") > 0;
       if (parser.options.count("max"))
       {
         m_options.max_states = parser.option_argument_as< unsigned long > ("max");
@@ -20,6 +20,7 @@
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/detail/lts_convert.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 using namespace mcrl2::lts;
 using namespace mcrl2::lts::detail;
@@ -34,6 +35,7 @@ class t_tool_options
     std::string     infilename;
     std::string     outfilename;
     std::string     lpsfile;
+    std::string     mappedfilename; // If not empty, the structure of the result is also saved as a mapped lts.
     lts_type        intype;
     lts_type        outtype;
     lts_equivalence equivalence;
@@ -41,6 +43,7 @@ class t_tool_options
     bool            remove_state_information;
     bool            determinise;
     bool            check_reach;
+    std::size_t     number_of_threads; // The number of threads used by the signature refinement reductions.
 
     inline t_tool_options() 
      : intype(lts_none), 
@@ -48,7 +51,8 @@ class t_tool_options
        equivalence(lts_eq_none),
        remove_state_information(false), 
        determinise(false), 
-       check_reach(true)
+       check_reach(true),
+       number_of_threads(1)
     {
     }
 
@@ -150,7 +154,7 @@ class ltsconvert_tool : public input_output_tool
         mCRL2log(verbose) << "reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
         mCRL2log(verbose) << "before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions " << std::endl;
         timer().start("reduction");
-        reduce(l,tool_options.equivalence);
+        reduce(l,tool_options.equivalence,tool_options.number_of_threads);
         timer().finish("reduction");
         mCRL2log(verbose) << "after reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions" << std::endl;
       }
@@ -165,6 +169,12 @@ class ltsconvert_tool : public input_output_tool
         mCRL2log(verbose) << "after determinisation: " << l.num_states() << " states and " << l.num_transitions() << " transitions" << std::endl;
       }
 
+      if (!tool_options.mappedfilename.empty())
+      {
+        mCRL2log(verbose) << "saving the transitions as a mapped lts to '" << tool_options.mappedfilename << "'..." << std::endl;
+        save_mapped_lts(l, tool_options.mappedfilename);
+      }
+
       mcrl2::lps::specification spec;
 
       if (!tool_options.lpsfile.empty())
@@ -288,6 +298,14 @@ class ltsconvert_tool : public input_output_tool
                       "consider actions with a name in the comma separated list ACTNAMES to "
                       "be internal (tau) actions in addition to those defined as such by "
                       "the input.");
+      desc.add_option("save-mapped", make_file_argument("FILE"),
+                      "also save the transitions of the resulting LTS in FILE, in a format that "
+                      "ltsinfo can map into memory directly instead of loading the LTS. This file "
+                      "does not contain the action and state labels.");
+      desc.add_option("threads", make_mandatory_argument("NUM"),
+                      "use NUM threads to compute the signatures and the partition in the "
+                      "signature refinement reductions (the equivalences ending in -sig). "
+                      "This only pays off for large LTSs (default 1).");
     }
 
     void set_tau_actions(std::vector <std::string>& tau_actions, std::string const& act_names)
@@ -352,6 +370,26 @@ class ltsconvert_tool : public input_output_tool
         set_tau_actions(tool_options.tau_actions, parser.option_argument("tau"));
       }
 
+      if (parser.options.count("save-mapped"))
+      {
+        tool_options.mappedfilename = parser.option_argument("save-mapped");
+      }
+
+      if (parser.options.count("threads"))
+      {
+        tool_options.number_of_threads = parser.option_argument_as<std::size_t>("threads");
+        if (tool_options.number_of_threads == 0)
+        {
+          parser.error("the number of threads must be at least 1");
+        }
+        if (tool_options.equivalence != lts_eq_bisim_sigref &&
+            tool_options.equivalence != lts_eq_branching_bisim_sigref &&
+            tool_options.equivalence != lts_eq_divergence_preserving_branching_bisim_sigref)
+        {
+          mCRL2log(warning) << "option --threads is only used by the signature refinement reductions; option ignored\n";
+        }
+      }
+
       tool_options.determinise                       = 0 < parser.options.count("determinise");
       tool_options.check_reach                       = parser.options.count("no-reach") == 0;
       tool_options.remove_state_information          = parser.options.count("no-state") != 0;
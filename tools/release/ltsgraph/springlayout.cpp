@@ -13,9 +13,11 @@
 
 #include <QThread>
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdlib>
 #include <ctime>
+#include <thread>
 
 namespace Graph
 {
@@ -48,13 +50,228 @@ inline void clip(float& f, float min, float max)
   }
 }
 
+inline
+QVector3D repulsionVector(const QVector3D& a, const QVector3D& b, float repulsion, float natlength)
+{
+  QVector3D diff = a - b;
+  return diff * (repulsion / cube((std::max)(diff.length() / 2.0f, natlength / 10)));
+}
+
+/// \brief Calls f(i) for all 0 <= i < count, using all available hardware threads if parallel is true.
+template <typename Function>
+static void parallelFor(std::size_t count, bool parallel, Function f)
+{
+  std::size_t threadCount = parallel ? (std::max)(std::thread::hardware_concurrency(), 1u) : 1;
+  if (threadCount == 1 || count < 1000)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      f(i);
+    }
+    return;
+  }
+
+  std::vector<std::thread> threads;
+  std::size_t chunk = (count + threadCount - 1) / threadCount;
+  for (std::size_t first = 0; first < count; first += chunk)
+  {
+    std::size_t last = (std::min)(first + chunk, count);
+    threads.emplace_back([first, last, &f]()
+    {
+      for (std::size_t i = first; i < last; ++i)
+      {
+        f(i);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+/// \brief An octree over a set of points, used to approximate the total repulsion on a point
+///        using the Barnes-Hut algorithm. Cells that are small compared to their distance to the
+///        point are treated as a single point in their center of mass.
+class Octree
+{
+  private:
+    struct Cell
+    {
+      QVector3D min;                  ///< The corner of the cell with the smallest coordinates.
+      float size;                     ///< The length of the sides of the cell.
+      QVector3D centerOfMass;         ///< The average position of the points in this cell.
+      std::size_t count;              ///< The number of points in this cell.
+      std::size_t first, last;        ///< The range of the points of a leaf in m_indices.
+      std::array<std::size_t, 8> children; ///< The children of this cell, where 0 means no child.
+      bool leaf;
+    };
+
+    static constexpr float theta = 0.8f;        ///< The accuracy of the approximation, smaller is more accurate.
+    static constexpr std::size_t maxDepth = 24; ///< Bounds the depth for points that are (almost) equal.
+
+    const std::vector<QVector3D>& m_points;
+    std::vector<std::size_t> m_indices;
+    std::vector<std::size_t> m_buffer;
+    std::vector<Cell> m_cells;
+
+    static std::size_t octant(const QVector3D& p, const QVector3D& center)
+    {
+      return (p.x() >= center.x() ? 1 : 0) | (p.y() >= center.y() ? 2 : 0) | (p.z() >= center.z() ? 4 : 0);
+    }
+
+    std::size_t build(std::size_t first, std::size_t last, const QVector3D& min, float size, std::size_t depth)
+    {
+      std::size_t index = m_cells.size();
+      m_cells.emplace_back();
+      {
+        Cell& cell = m_cells.back();
+        cell.min = min;
+        cell.size = size;
+        cell.count = last - first;
+        cell.first = first;
+        cell.last = last;
+        cell.children.fill(0);
+        cell.leaf = last - first <= 1 || depth == maxDepth;
+
+        QVector3D sum(0, 0, 0);
+        for (std::size_t i = first; i < last; ++i)
+        {
+          sum += m_points[m_indices[i]];
+        }
+        cell.centerOfMass = sum / static_cast<float>(last - first);
+      }
+
+      if (m_cells[index].leaf)
+      {
+        return index;
+      }
+
+      // Sort the points of this cell on their octant, using a counting sort.
+      float half = size / 2.0f;
+      QVector3D center = min + QVector3D(half, half, half);
+      std::array<std::size_t, 9> offsets{};
+      for (std::size_t i = first; i < last; ++i)
+      {
+        ++offsets[octant(m_points[m_indices[i]], center) + 1];
+      }
+      for (std::size_t o = 0; o < 8; ++o)
+      {
+        offsets[o + 1] += offsets[o];
+      }
+      std::array<std::size_t, 9> bounds = offsets;
+      for (std::size_t i = first; i < last; ++i)
+      {
+        m_buffer[first + offsets[octant(m_points[m_indices[i]], center)]++] = m_indices[i];
+      }
+      std::copy(m_buffer.begin() + first, m_buffer.begin() + last, m_indices.begin() + first);
+
+      for (std::size_t o = 0; o < 8; ++o)
+      {
+        if (bounds[o] < bounds[o + 1])
+        {
+          QVector3D childMin(o & 1 ? center.x() : min.x(), o & 2 ? center.y() : min.y(), o & 4 ? center.z() : min.z());
+          std::size_t child = build(first + bounds[o], first + bounds[o + 1], childMin, half, depth + 1);
+          m_cells[index].children[o] = child;
+        }
+      }
+      return index;
+    }
+
+    static bool contains(const Cell& cell, const QVector3D& p)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        if (p[i] < cell.min[i] || p[i] > cell.min[i] + cell.size)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+  public:
+    /// \brief Builds an octree over the given points.
+    explicit Octree(const std::vector<QVector3D>& points)
+      : m_points(points), m_indices(points.size()), m_buffer(points.size())
+    {
+      if (points.empty())
+      {
+        return;
+      }
+
+      QVector3D min = points[0];
+      QVector3D max = points[0];
+      for (const QVector3D& p : points)
+      {
+        for (int i = 0; i < 3; ++i)
+        {
+          min[i] = (std::min)(min[i], p[i]);
+          max[i] = (std::max)(max[i], p[i]);
+        }
+      }
+      float size = (std::max)({ max.x() - min.x(), max.y() - min.y(), max.z() - min.z(), 1.0f });
+
+      for (std::size_t i = 0; i < points.size(); ++i)
+      {
+        m_indices[i] = i;
+      }
+      m_cells.reserve(2 * points.size());
+      build(0, points.size(), min, size, 0);
+    }
+
+    /// \brief Returns the approximate total repulsion on the point with the given index by all other points.
+    QVector3D repulsion(std::size_t index, float repulsion, float natlength) const
+    {
+      QVector3D result(0, 0, 0);
+      if (m_cells.empty())
+      {
+        return result;
+      }
+
+      const QVector3D& p = m_points[index];
+      std::vector<std::size_t> todo = { 0 };
+      while (!todo.empty())
+      {
+        const Cell& cell = m_cells[todo.back()];
+        todo.pop_back();
+
+        if (cell.leaf)
+        {
+          for (std::size_t i = cell.first; i < cell.last; ++i)
+          {
+            if (m_indices[i] != index)
+            {
+              result += repulsionVector(p, m_points[m_indices[i]], repulsion, natlength);
+            }
+          }
+        }
+        else if (!contains(cell, p) && cell.size < theta * (cell.centerOfMass - p).length())
+        {
+          result += static_cast<float>(cell.count) * repulsionVector(p, cell.centerOfMass, repulsion, natlength);
+        }
+        else
+        {
+          for (std::size_t child : cell.children)
+          {
+            if (child != 0)
+            {
+              todo.push_back(child);
+            }
+          }
+        }
+      }
+      return result;
+    }
+};
+
 //
 // SpringLayout
 //
 
 SpringLayout::SpringLayout(Graph& graph, GLWidget& glwidget)
   : m_speed(0.001f), m_attraction(0.13f), m_repulsion(50.0f), m_natLength(50.0f), m_controlPointWeight(0.001f),
-    m_graph(graph), m_ui(nullptr), m_forceCalculation(&SpringLayout::forceLTSGraph), m_glwidget(glwidget)
+    m_repulsionCalculation(exact), m_parallel(true), m_graph(graph), m_ui(nullptr), m_forceCalculation(&SpringLayout::forceLTSGraph), m_glwidget(glwidget)
 {
   srand(time(nullptr));
 }
@@ -117,11 +334,7 @@ QVector3D SpringLayout::forceLinearSprings(const QVector3D& a, const QVector3D&
 inline
 QVector3D repulsionForce(const QVector3D& a, const QVector3D& b, float repulsion, float natlength)
 {
-  QVector3D diff = a - b;
-  float r = repulsion;
-  r /= cube((std::max)(diff.length() / 2.0f, natlength / 10));
-  diff = diff * r + QVector3D(frand(-0.01f, 0.01f), frand(-0.01f, 0.01f), frand(-0.01f, 0.01f));
-  return diff;
+  return repulsionVector(a, b, repulsion, natlength) + QVector3D(frand(-0.01f, 0.01f), frand(-0.01f, 0.01f), frand(-0.01f, 0.01f));
 }
 
 static QVector3D applyForce(const QVector3D& pos, const QVector3D& force, float speed)
@@ -129,6 +342,70 @@ static QVector3D applyForce(const QVector3D& pos, const QVector3D& force, float
   return pos + speed * force;
 }
 
+static QVector3D randomVector()
+{
+  return QVector3D(frand(-0.01f, 0.01f), frand(-0.01f, 0.01f), frand(-0.01f, 0.01f));
+}
+
+void SpringLayout::applyRepulsionBarnesHut(std::size_t nodeCount, std::size_t edgeCount, bool sel)
+{
+  // The repulsion between nodes.
+  m_positions.resize(nodeCount);
+  for (std::size_t i = 0; i < nodeCount; ++i)
+  {
+    m_positions[i] = m_graph.node(sel ? m_graph.explorationNode(i) : i).pos();
+  }
+  {
+    Octree tree(m_positions);
+    parallelFor(nodeCount, m_parallel, [&](std::size_t i)
+    {
+      std::size_t n = sel ? m_graph.explorationNode(i) : i;
+      m_nforces[n] += tree.repulsion(i, m_repulsion, m_natLength);
+    });
+  }
+
+  // The repulsion between handles, and between transition labels.
+  m_positions.resize(edgeCount);
+  for (std::size_t i = 0; i < edgeCount; ++i)
+  {
+    m_positions[i] = m_graph.handle(sel ? m_graph.explorationEdge(i) : i).pos();
+  }
+  {
+    Octree tree(m_positions);
+    parallelFor(edgeCount, m_parallel, [&](std::size_t i)
+    {
+      std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+      m_hforces[n] += tree.repulsion(i, m_repulsion * m_controlPointWeight, m_natLength);
+    });
+  }
+
+  for (std::size_t i = 0; i < edgeCount; ++i)
+  {
+    m_positions[i] = m_graph.transitionLabel(sel ? m_graph.explorationEdge(i) : i).pos();
+  }
+  {
+    Octree tree(m_positions);
+    parallelFor(edgeCount, m_parallel, [&](std::size_t i)
+    {
+      std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+      m_lforces[n] += tree.repulsion(i, m_repulsion * m_controlPointWeight, m_natLength);
+    });
+  }
+
+  // The exact calculation adds a small random vector for every pair, which prevents that
+  // points at the same position stay together. This is not thread safe, so it is done here.
+  for (std::size_t i = 0; i < nodeCount; ++i)
+  {
+    m_nforces[sel ? m_graph.explorationNode(i) : i] += randomVector();
+  }
+  for (std::size_t i = 0; i < edgeCount; ++i)
+  {
+    std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+    m_hforces[n] += randomVector();
+    m_lforces[n] += randomVector();
+  }
+}
+
 void SpringLayout::apply()
 {
   m_graph.lock(GRAPH_LOCK_TRACE); // enter critical section
@@ -144,12 +421,28 @@ void SpringLayout::apply()
     m_lforces.resize(m_graph.edgeCount());
     m_sforces.resize(m_graph.nodeCount());
 
+    for (std::size_t i = 0; i < nodeCount; ++i)
+    {
+      m_nforces[sel ? m_graph.explorationNode(i) : i] = QVector3D(0, 0, 0);
+    }
+    for (std::size_t i = 0; i < edgeCount; ++i)
+    {
+      std::size_t n = sel ? m_graph.explorationEdge(i) : i;
+      m_hforces[n] = QVector3D(0, 0, 0);
+      m_lforces[n] = QVector3D(0, 0, 0);
+    }
+
+    bool approximate = m_repulsionCalculation == barneshut;
+    if (approximate)
+    {
+      applyRepulsionBarnesHut(nodeCount, edgeCount, sel);
+    }
+
     for (std::size_t i = 0; i < nodeCount; ++i)
     {
       std::size_t n = sel ? m_graph.explorationNode(i) : i;
 
-      m_nforces[n] = QVector3D(0, 0, 0);
-      for (std::size_t j = 0; j < i; ++j)
+      for (std::size_t j = 0; !approximate && j < i; ++j)
       {
         std::size_t m = sel ? m_graph.explorationNode(j) : j;
 
@@ -168,9 +461,6 @@ void SpringLayout::apply()
       QVector3D f;
       // Variables for repulsion calculations
 
-      m_hforces[n] = QVector3D(0, 0, 0);
-      m_lforces[n] = QVector3D(0, 0, 0);
-
       if (e.from() == e.to())
       {
         m_hforces[n] += repulsionForce(m_graph.handle(n).pos(), m_graph.node(e.from()).pos(), m_repulsion, m_natLength);
@@ -186,7 +476,7 @@ void SpringLayout::apply()
       f = (this->*m_forceCalculation)(m_graph.handle(n).pos(), m_graph.transitionLabel(n).pos(), 0.0);
       m_lforces[n] += f;
 
-      for (std::size_t j = 0; j < i; ++j)
+      for (std::size_t j = 0; !approximate && j < i; ++j)
       {
         std::size_t m = sel ? m_graph.explorationEdge(j) : j;
 
@@ -312,6 +602,8 @@ SpringLayoutUi::SpringLayoutUi(SpringLayout& layout, QWidget* parent)
   m_ui.sldHandleWeight->setValue(m_layout.controlPointWeight());
   m_ui.sldNatLength->setValue(m_layout.naturalTransitionLength());
   m_ui.cmbForceCalculation->setCurrentIndex(m_layout.forceCalculation());
+  m_ui.cmbRepulsionCalculation->setCurrentIndex(m_layout.repulsionCalculation());
+  m_ui.chkParallel->setChecked(m_layout.parallel());
   connect(&m_updateTimer, SIGNAL(timeout()), this, SLOT(onTimeout()));
 }
 
@@ -334,7 +626,9 @@ QByteArray SpringLayoutUi::settings()
       quint32(m_ui.sldSpeed->value()) <<
       quint32(m_ui.sldHandleWeight->value()) <<
       quint32(m_ui.sldNatLength->value()) <<
-      quint32(m_ui.cmbForceCalculation->currentIndex());
+      quint32(m_ui.cmbForceCalculation->currentIndex()) <<
+      quint32(m_ui.cmbRepulsionCalculation->currentIndex()) <<
+      quint32(m_ui.chkParallel->isChecked());
 
   return result;
 }
@@ -360,6 +654,16 @@ void SpringLayoutUi::setSettings(QByteArray state)
     m_ui.cmbForceCalculation->setCurrentIndex(ForceCalculation);
   }
 
+  // These settings are not present in the settings of older versions.
+  quint32 RepulsionCalculation, Parallel;
+  in >> RepulsionCalculation >> Parallel;
+
+  if (in.status() == QDataStream::Ok)
+  {
+    m_ui.cmbRepulsionCalculation->setCurrentIndex(RepulsionCalculation);
+    m_ui.chkParallel->setChecked(Parallel != 0);
+  }
+
 }
 
 void SpringLayoutUi::onAttractionChanged(int value)
@@ -402,6 +706,24 @@ void SpringLayoutUi::onForceCalculationChanged(int value)
   }
 }
 
+void SpringLayoutUi::onRepulsionCalculationChanged(int value)
+{
+  switch (value)
+  {
+    case 0:
+      m_layout.setRepulsionCalculation(SpringLayout::exact);
+      break;
+    case 1:
+      m_layout.setRepulsionCalculation(SpringLayout::barneshut);
+      break;
+  }
+}
+
+void SpringLayoutUi::onParallelChanged(bool value)
+{
+  m_layout.setParallel(value);
+}
+
 void SpringLayoutUi::onStarted()
 {
   m_ui.btnStartStop->setText("Stop");
@@ -42,12 +42,24 @@ class SpringLayout
       ltsgraph,                   ///< LTSGraph implementation.
       linearsprings               ///< Linear spring implementation.
     };
+
+    /**
+     * @brief An enumeration that identifies the ways in which the repulsion can be calculated.
+     */
+    enum RepulsionCalculation
+    {
+      exact,                      ///< Compute the repulsion between all pairs, which takes quadratic time.
+      barneshut                   ///< Approximate the repulsion using a Barnes-Hut octree.
+    };
   private:
     float m_speed;                ///< The rate of change each step.
     float m_attraction;           ///< The attraction of the edges.
     float m_repulsion;            ///< The repulsion of other nodes.
     float m_natLength;            ///< The natural length of springs.
     float m_controlPointWeight;   ///< The handle repulsion wight factor.
+    RepulsionCalculation m_repulsionCalculation; ///< The way in which the repulsion is calculated.
+    bool m_parallel;              ///< Use multiple threads for the Barnes-Hut approximation.
+    std::vector<QVector3D> m_positions; ///< The positions used to build the octrees.
     std::vector<QVector3D> m_nforces, m_hforces, m_lforces, m_sforces;  ///< Vector of the calculated forces..
 
     Graph& m_graph;               ///< The graph on which the algorithm is applied.
@@ -70,6 +82,15 @@ class SpringLayout
      * @param ideal The ideal distance between @e a and @e b.
      */
     QVector3D forceLTSGraph(const QVector3D& a, const QVector3D& b, float ideal);
+
+    /**
+     * @brief Approximates the repulsion between nodes, between handles and between transition labels
+     *        using the Barnes-Hut algorithm, which takes O(n log n) time instead of O(n^2).
+     * @param nodeCount The number of nodes that take part in the layout.
+     * @param edgeCount The number of edges that take part in the layout.
+     * @param sel Indicates whether only the nodes and edges of the exploration take part in the layout.
+     */
+    void applyRepulsionBarnesHut(std::size_t nodeCount, std::size_t edgeCount, bool sel);
   public:
     GLWidget& m_glwidget;
 
@@ -100,6 +121,35 @@ class SpringLayout
      */
     ForceCalculation forceCalculation();
 
+    /**
+     * @brief Set the way in which the repulsion is calculated.
+     * @param c The desired calculation (exact or Barnes-Hut)
+     */
+    void setRepulsionCalculation(RepulsionCalculation c) {
+      m_repulsionCalculation = c;
+    }
+
+    /**
+     * @brief Returns the way in which the repulsion is calculated.
+     */
+    RepulsionCalculation repulsionCalculation() const {
+      return m_repulsionCalculation;
+    }
+
+    /**
+     * @brief Enables or disables the use of multiple threads for the Barnes-Hut approximation.
+     */
+    void setParallel(bool parallel) {
+      m_parallel = parallel;
+    }
+
+    /**
+     * @brief Returns whether multiple threads are used for the Barnes-Hut approximation.
+     */
+    bool parallel() const {
+      return m_parallel;
+    }
+
     /**
      * @brief Randomly moves nodes along the Z axis, at most [z] units
      * @param z The maximum distance that nodes are moved
@@ -226,6 +276,18 @@ class SpringLayoutUi : public QDockWidget
      */
     void onForceCalculationChanged(int value);
 
+    /**
+     * @brief Updates the repulsion calculation.
+     * @param value The new index selected.
+     */
+    void onRepulsionCalculationChanged(int value);
+
+    /**
+     * @brief Updates whether multiple threads are used.
+     * @param value The new state of the check box.
+     */
+    void onParallelChanged(bool value);
+
     /**
      * @brief Starts or stops the force calculation depending on the current state.
      */
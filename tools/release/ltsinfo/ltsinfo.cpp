@@ -24,6 +24,7 @@
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/lts_fsm.h"
 #include "mcrl2/lts/lts_dot.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 
 using namespace mcrl2::utilities::tools;
@@ -182,6 +183,12 @@ class ltsinfo_tool : public ltsinfo_base
         ++branching_factor[transition.from()];
       }
 
+      print_branching_factor_statistics(branching_factor);
+    }
+
+    /// \brief Prints the min, max, median and average of the given number of outgoing transitions per state.
+    static void print_branching_factor_statistics(std::vector<std::uint64_t>& branching_factor)
+    {
       // Sort the counts to obtain min, max and median.
       std::sort(branching_factor.begin(), branching_factor.end());
       std::uint64_t min = branching_factor.front();
@@ -199,7 +206,7 @@ class ltsinfo_tool : public ltsinfo_base
       double average_branching_factor = 0;
       for (auto& factor : branching_factor)
       {
-        average_branching_factor += static_cast<double>(factor) / lts.num_states();
+        average_branching_factor += static_cast<double>(factor) / branching_factor.size();
       }
 
       // Print the results.
@@ -314,6 +321,81 @@ class ltsinfo_tool : public ltsinfo_base
       return true;
     }
 
+    /// \brief Provides the information of a mapped lts, which is inspected without loading it into memory.
+    bool provide_mapped_information() const
+    {
+      mcrl2::lts::mapped_lts l(infilename);
+
+      mCRL2log(info)
+          << "Number of states: " << l.num_states() << ".\n"
+          << "Number of action labels: " << l.num_action_labels() << " (including a tau label).\n"
+          << "Number of transitions: " << l.num_transitions() << ".\n"
+          << "There are no state labels." << std::endl;
+
+      mCRL2log(verbose) << "Checking reachability..." << std::endl;
+      std::vector<bool> visited(l.num_states(), false);
+      std::vector<std::size_t> todo;
+      if (l.num_states() > 0)
+      {
+        visited[l.initial_state()] = true;
+        todo.push_back(l.initial_state());
+      }
+      std::size_t number_of_reachable_states = todo.size();
+      while (!todo.empty())
+      {
+        std::size_t s = todo.back();
+        todo.pop_back();
+        for (std::size_t i = l.outgoing_begin(s); i < l.outgoing_begin(s + 1); ++i)
+        {
+          std::size_t t = l.target(i);
+          if (!visited[t])
+          {
+            visited[t] = true;
+            todo.push_back(t);
+            ++number_of_reachable_states;
+          }
+        }
+      }
+      if (number_of_reachable_states != l.num_states())
+      {
+        mCRL2log(info) << "Warning: some states are not reachable from the initial state! (This might result in unspecified behaviour of LTS tools.)" << std::endl;
+      }
+
+      // The outgoing transitions of every state are sorted on label and target, so a state is
+      // nondeterministic iff two consecutive outgoing transitions have the same label and different targets.
+      mCRL2log(verbose) << "Checking whether lts is deterministic..." << std::endl;
+      bool deterministic = true;
+      for (std::size_t s = 0; s < l.num_states() && deterministic; ++s)
+      {
+        for (std::size_t i = l.outgoing_begin(s) + 1; i < l.outgoing_begin(s + 1); ++i)
+        {
+          if (l.label(i - 1) == l.label(i) && l.target(i - 1) != l.target(i))
+          {
+            deterministic = false;
+            break;
+          }
+        }
+      }
+      mCRL2log(info) << "LTS is " << (deterministic ? "" : "not ") << "deterministic." << std::endl;
+
+      if (print_action_labels || print_state_labels)
+      {
+        mCRL2log(info) << "A mapped lts only contains the transitions. Therefore, its labels cannot be listed.\n";
+      }
+
+      if (print_branching_factor && l.num_states() > 0)
+      {
+        std::vector<std::uint64_t> branching_factor(l.num_states());
+        for (std::size_t s = 0; s < l.num_states(); ++s)
+        {
+          branching_factor[s] = l.outgoing_begin(s + 1) - l.outgoing_begin(s);
+        }
+        print_branching_factor_statistics(branching_factor);
+      }
+
+      return true;
+    }
+
   public:
 
     bool run()
@@ -321,6 +403,11 @@ class ltsinfo_tool : public ltsinfo_base
       using namespace mcrl2::lts;
       using namespace mcrl2::lts::detail;
 
+      if (!infilename.empty() && mapped_lts::is_mapped_lts(infilename))
+      {
+        return provide_mapped_information();
+      }
+
       if (intype==lts_none)
       {
         intype = guess_format(infilename);
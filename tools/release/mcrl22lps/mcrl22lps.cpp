@@ -129,6 +129,9 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
                       "process.");
       desc.add_option("check-only",
                       "check syntax and static semantics; do not linearise", 'e');
+      desc.add_option("threads", mcrl2::utilities::make_mandatory_argument("NUM"),
+                      "use NUM threads to combine the summands of parallel processes. This only pays "
+                      "off for parallel compositions that yield many summands (default 1).");
     }
 
     void parse_options(const mcrl2::utilities::command_line_parser& parser)
@@ -152,6 +155,20 @@ class mcrl22lps_tool : public rewriter_tool< input_output_tool >
 
       m_linearisation_options.lin_method = parser.option_argument_as< mcrl2::lps::t_lin_method >("lin-method");
 
+      if (parser.has_option("threads"))
+      {
+        m_linearisation_options.number_of_threads = parser.option_argument_as<std::size_t>("threads");
+        if (m_linearisation_options.number_of_threads == 0)
+        {
+          parser.error("the number of threads must be at least one");
+        }
+        if (m_linearisation_options.number_of_threads > 1 && !atermpp::detail::GlobalThreadSafe)
+        {
+          m_linearisation_options.number_of_threads = 1;
+          mCRL2log(mcrl2::log::warning) << "Ignoring the threads option, because this toolset is built without MCRL2_ENABLE_MULTITHREADING." << std::endl;
+        }
+      }
+
       //check for dangerous and illegal option combinations
       if (m_linearisation_options.newstate && m_linearisation_options.lin_method == mcrl2::lps::lmStack)
       {
@@ -61,6 +61,7 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
                       .add_value(spm_solver, true)
                       .add_value(alternative_spm_solver)
                       .add_value(recursive_solver)
+                      .add_value(concurrent_recursive_solver)
                       .add_value(priority_promotion),
                       "Use the solver type NAME:", 's');
       desc.add_option("scc", "Use scc decomposition", 'c');
@@ -68,6 +69,9 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       desc.add_option("cycle", "Eliminate cycles", 'C');
       desc.add_option("verify", "Verify the solution", 'e');
       desc.add_option("onlygenerate", "Only generate the BES without solving", 'g');
+      desc.add_option("threads",
+                      make_mandatory_argument("NUM"),
+                      "Use NUM threads in the concrec solver, where 0 means the number of hardware threads (default: 0).");
       desc.add_hidden_option("equation_limit",
                              make_optional_argument("NAME", "-1"),
                              "Set a limit to the number of generated BES equations",
@@ -83,6 +87,10 @@ class pg_solver_tool : public rewriter_tool<pbes_input_tool<input_tool> >
       m_options.use_decycle_solver = (parser.options.count("cycle") > 0);
       m_options.verify_solution = (parser.options.count("verify") > 0);
       m_options.only_generate = (parser.options.count("onlygenerate") > 0);
+      if (parser.has_option("threads"))
+      {
+        m_options.number_of_threads = parser.option_argument_as<std::size_t>("threads");
+      }
       if (parser.options.count("equation_limit") > 0)
       {
         int limit = parser.option_argument_as<int>("equation_limit");
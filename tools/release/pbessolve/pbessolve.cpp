@@ -98,6 +98,10 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
                      )
                     ,"use strategy STRATEGY (N.B. This is a developer option that overrides --strategy)",
                  'l');
+      desc.add_option("threads",
+                      utilities::make_mandatory_argument("NUM"),
+                      "Use NUM threads to compute the attractor sets while solving the parity game. "
+                      "This only pays off for large parity games (default 1).");
       desc.add_hidden_option("no-replace-constants-by-variables", "Do not move constant expressions to a substitution.");
       desc.add_hidden_option("aggressive", "Apply optimizations 4 and 5 at every iteration.");
       desc.add_hidden_option("prune-todo-alternative", "Use a variation of todo list pruning.");
@@ -132,6 +136,14 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       {
         evidence_file = parser.option_argument("evidence-file");
       }
+      if (parser.has_option("threads"))
+      {
+        options.number_of_threads = parser.option_argument_as<std::size_t>("threads");
+        if (options.number_of_threads == 0)
+        {
+          throw mcrl2::runtime_error("The number of threads must be at least 1.");
+        }
+      }
 
       if (parser.has_option("long-strategy"))
       {
@@ -208,7 +220,7 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
         bool result;
         lps::specification evidence;
         timer().start("solving");
-        std::tie(result, evidence) = solve_structure_graph_with_counter_example(G, lpsspec, pbesspec, algorithm.equation_index());
+        std::tie(result, evidence) = solve_structure_graph_with_counter_example(G, lpsspec, pbesspec, algorithm.equation_index(), options.number_of_threads);
         timer().finish("solving");
         std::cout << (result ? "true" : "false") << std::endl;
         if (evidence_file.empty())
@@ -224,7 +236,7 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
         ltsspec.load(ltsfile);
         lts::lts_lts_t evidence;
         timer().start("solving");
-        bool result = solve_structure_graph_with_counter_example(G, ltsspec);
+        bool result = solve_structure_graph_with_counter_example(G, ltsspec, options.number_of_threads);
         timer().finish("solving");
         std::cout << (result ? "true" : "false") << std::endl;
         if (evidence_file.empty())
@@ -237,7 +249,7 @@ class pbessolve_tool: public rewriter_tool<pbes_input_tool<input_tool>>
       else
       {
         timer().start("solving");
-        bool result = solve_structure_graph(G, options.check_strategy);
+        bool result = solve_structure_graph(G, options.check_strategy, options.number_of_threads);
         timer().finish("solving");
         std::cout << (result ? "true" : "false") << std::endl;
       }